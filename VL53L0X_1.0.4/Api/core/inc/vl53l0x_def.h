@@ -253,6 +253,8 @@ typedef struct {
 	/*!< Defines type of histogram measurement to be done for the next
 	 *	measure
 	 */
+	uint8_t WrapAroundCheckEnable;
+	/*!< Tells if Wrap Around Check shall be enable or not */
 	uint32_t MeasurementTimingBudgetMicroSeconds;
 	/*!< Defines the allowed total time for a single measurement */
 	uint32_t InterMeasurementPeriodMilliSeconds;
@@ -279,13 +281,13 @@ typedef struct {
 	FixPoint1616_t LimitChecksValue[VL53L0X_CHECKENABLE_NUMBER_OF_CHECKS];
 	/*!< This Array store all the Limit Check value for this device */
 
+#ifndef VL53L0X_LEAN_DEVICE
 	VL53L0X_DMaxLUT_t dmax_lut;
 	/*!< Lookup table defining ambient rates and associated
-	 * dmax values.
+	 * dmax values. VL53L0X_LEAN_DEVICE : one constant table shared by
+	 * the devices.
 	 */
-
-	uint8_t WrapAroundCheckEnable;
-	/*!< Tells if Wrap Around Check shall be enable or not */
+#endif
 } VL53L0X_DeviceParameters_t;
 
 
@@ -393,6 +395,13 @@ typedef struct {
 
 #define VL53L0X_REF_SPAD_BUFFER_SIZE 6
 
+#ifdef VL53L0X_LEAN_DEVICE
+/* the 18 characters read from the device */
+#define VL53L0X_PRODUCT_ID_LENGTH 19
+#else
+#define VL53L0X_PRODUCT_ID_LENGTH VL53L0X_MAX_STRING_LENGTH
+#endif
+
 /**
  * @struct VL53L0X_SpadData_t
  * @brief Spad Configuration Data.
@@ -412,11 +421,11 @@ typedef struct {
 
 	VL53L0X_GpioFunctionality Pin0GpioFunctionality;
 	/* store the functionality of the GPIO: pin0 */
+	uint8_t FinalRangeVcselPulsePeriod;
+	 /*!< Vcsel pulse period (pll clocks) for the final range measurement*/
 
 	uint32_t FinalRangeTimeoutMicroSecs;
 	 /*!< Execution time of the final range*/
-	uint8_t FinalRangeVcselPulsePeriod;
-	 /*!< Vcsel pulse period (pll clocks) for the final range measurement*/
 	uint32_t PreRangeTimeoutMicroSecs;
 	 /*!< Execution time of the final range*/
 	uint8_t PreRangeVcselPulsePeriod;
@@ -438,7 +447,7 @@ typedef struct {
 	uint8_t ReadDataFromDeviceDone;
 	uint8_t ModuleId; /* Module ID */
 	uint8_t Revision; /* test Revision */
-	char ProductId[VL53L0X_MAX_STRING_LENGTH];
+	char ProductId[VL53L0X_PRODUCT_ID_LENGTH];
 		/* Product Identifier String  */
 	uint8_t ReferenceSpadCount; /* used for ref spad management */
 	uint8_t ReferenceSpadType;	/* used for ref spad management */
@@ -467,8 +476,10 @@ typedef struct {
 	/*!< Current Device Parameter */
 	VL53L0X_RangingMeasurementData_t LastRangeMeasure;
 	/*!< Ranging Data */
+#ifndef VL53L0X_LEAN_DEVICE
 	VL53L0X_HistogramMeasurementData_t LastHistogramMeasure;
-	/*!< Histogram Data */
+	/*!< Histogram Data, not used by the API */
+#endif
 	VL53L0X_DeviceSpecificParameters_t DeviceSpecificParameters;
 	/*!< Parameters specific to the device */
 	VL53L0X_SpadData_t SpadData;
@@ -493,8 +504,12 @@ typedef struct {
 	 */
 	uint8_t StopVariable;
 	/*!< StopVariable used during the stop sequence */
+	uint8_t UseInternalTuningSettings;
+	/*!< Indicate if we use	 Tuning Settings table */
 	uint16_t targetRefRate;
 	/*!< Target Ambient Rate for Ref spad management */
+	uint16_t LinearityCorrectiveGain;
+	/*!< Linearity Corrective Gain value in x1000 */
 	FixPoint1616_t SigmaEstimate;
 	/*!< Sigma Estimate - based on ambient & VCSEL rates and
 	 * signal_total_events
@@ -505,10 +520,6 @@ typedef struct {
 	/*!< Latest Signal ref in Mcps */
 	uint8_t *pTuningSettingsPointer;
 	/*!< Pointer for Tuning Settings table */
-	uint8_t UseInternalTuningSettings;
-	/*!< Indicate if we use	 Tuning Settings table */
-	uint16_t LinearityCorrectiveGain;
-	/*!< Linearity Corrective Gain value in x1000 */
 } VL53L0X_DevData_t;
 
 
@@ -431,6 +431,7 @@ VL53L0X_Error VL53L0X_DataInit(VL53L0X_DEV Dev)
 		CurrentParameters.HistogramMode =
 					VL53L0X_HISTOGRAMMODE_DISABLED;
 
+#ifndef VL53L0X_LEAN_DEVICE
 		/* Dmax lookup table */
 	/* 0.0 */
 	CurrentParameters.dmax_lut.ambRate_mcps[0] = (FixPoint1616_t)0x00000000;
@@ -460,6 +461,7 @@ VL53L0X_Error VL53L0X_DataInit(VL53L0X_DEV Dev)
 	CurrentParameters.dmax_lut.ambRate_mcps[6] = (FixPoint1616_t)0x000F0000;
 	/* 400 */
 	CurrentParameters.dmax_lut.dmax_mm[6]      = (FixPoint1616_t)0x01900000;
+#endif
 
 		PALDevDataSet(Dev, CurrentParameters, CurrentParameters);
 	}
@@ -804,7 +806,7 @@ VL53L0X_Error VL53L0X_ResetDevice(VL53L0X_DEV Dev)
 		do {
 			Status = VL53L0X_RdByte(Dev,
 			VL53L0X_REG_IDENTIFICATION_MODEL_ID, &Byte);
-		} while (Byte != 0x00);
+		} while ((Byte != 0x00) && (Status == VL53L0X_ERROR_NONE));
 	}
 
 	VL53L0X_PollingDelay(Dev);
@@ -818,7 +820,7 @@ VL53L0X_Error VL53L0X_ResetDevice(VL53L0X_DEV Dev)
 		do {
 			Status = VL53L0X_RdByte(Dev,
 			VL53L0X_REG_IDENTIFICATION_MODEL_ID, &Byte);
-		} while (Byte == 0x00);
+		} while ((Byte == 0x00) && (Status == VL53L0X_ERROR_NONE));
 	}
 
 	VL53L0X_PollingDelay(Dev);
@@ -946,6 +948,7 @@ VL53L0X_Error VL53L0X_GetDeviceParameters(VL53L0X_DEV Dev,
 		&(pDeviceParameters->MeasurementTimingBudgetMicroSeconds));
 	}
 
+#ifndef VL53L0X_LEAN_DEVICE
 	if (Status == VL53L0X_ERROR_NONE) {
 		for (i = 0; i < VL53L0X_DMAX_LUT_SIZE; i++) {
 			pDeviceParameters->dmax_lut.ambRate_mcps[i] =
@@ -954,6 +957,7 @@ VL53L0X_Error VL53L0X_GetDeviceParameters(VL53L0X_DEV Dev,
 			   Dev->Data.CurrentParameters.dmax_lut.dmax_mm[i];
 		}
 	}
+#endif
 
 	LOG_FUNCTION_END(Status);
 	return Status;
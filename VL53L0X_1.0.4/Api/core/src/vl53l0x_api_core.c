@@ -1495,7 +1495,19 @@ VL53L0X_Error VL53L0X_get_total_signal_rate(VL53L0X_DEV Dev,
 	return Status;
 }
 
-VL53L0X_Error get_dmax_lut_points(VL53L0X_DMaxLUT_t data, uint32_t lut_size,
+#ifdef VL53L0X_LEAN_DEVICE
+/* Dmax lookup table of VL53L0X_DataInit, shared by the devices */
+static const VL53L0X_DMaxLUT_t dmax_lut_default = {
+	/* 0.0, 0.7, 2, 3.8, 7.3, 10, 15 */
+	{ 0x00000000, 0x0000B333, 0x00020000, 0x0003CCCC,
+	  0x00074CCC, 0x000A0000, 0x000F0000 },
+	/* 1200, 1100, 900, 750, 550, 500, 400 */
+	{ 0x04B00000, 0x044C0000, 0x03840000, 0x02EE0000,
+	  0x02260000, 0x01F40000, 0x01900000 }
+};
+#endif
+
+VL53L0X_Error get_dmax_lut_points(const VL53L0X_DMaxLUT_t *data, uint32_t lut_size,
 	FixPoint1616_t input, int32_t *index0,	int32_t *index1){
 	VL53L0X_Error Status = VL53L0X_ERROR_NONE;
 	FixPoint1616_t index0_tmp = 0;
@@ -1503,7 +1515,7 @@ VL53L0X_Error get_dmax_lut_points(VL53L0X_DMaxLUT_t data, uint32_t lut_size,
 	int index = 0;
 
 	for (index = 0; index < lut_size; index++) {
-		if (input <= data.ambRate_mcps[index]) {
+		if (input <= data->ambRate_mcps[index]) {
 			index1_tmp = index;
 			break;
 		}
@@ -1529,7 +1541,13 @@ VL53L0X_Error get_dmax_lut_points(VL53L0X_DMaxLUT_t data, uint32_t lut_size,
 VL53L0X_Error VL53L0X_calc_dmax(
 	VL53L0X_DEV Dev, FixPoint1616_t ambRateMeas, uint32_t *pdmax_mm){
 	VL53L0X_Error Status = VL53L0X_ERROR_NONE;
-	VL53L0X_DeviceParameters_t CurrentParameters;
+#ifdef VL53L0X_LEAN_DEVICE
+	const VL53L0X_DMaxLUT_t *pLut = &dmax_lut_default;
+#else
+	/* the table GetDeviceParameters would copy, without its register reads */
+	const VL53L0X_DMaxLUT_t *pLut =
+		&PALDevDataGet(Dev, CurrentParameters).dmax_lut;
+#endif
 	int32_t index0 = 0;
 	int32_t index1 = 0;
 	FixPoint1616_t amb0, amb1, dmax0, dmax1;
@@ -1538,27 +1556,22 @@ VL53L0X_Error VL53L0X_calc_dmax(
 
 	LOG_FUNCTION_START("");
 
-	Status = VL53L0X_GetDeviceParameters(Dev, &CurrentParameters);
-
-	if (ambRateMeas <= CurrentParameters.dmax_lut.ambRate_mcps[0]) {
-		dmax_mm = CurrentParameters.dmax_lut.dmax_mm[0];
+	if (ambRateMeas <= pLut->ambRate_mcps[0]) {
+		dmax_mm = pLut->dmax_mm[0];
 	} else if (ambRateMeas >=
-		   CurrentParameters.dmax_lut.
-		   ambRate_mcps[VL53L0X_DMAX_LUT_SIZE - 1]) {
-		dmax_mm =
-		    CurrentParameters.dmax_lut.dmax_mm[VL53L0X_DMAX_LUT_SIZE -
-						       1];
+		   pLut->ambRate_mcps[VL53L0X_DMAX_LUT_SIZE - 1]) {
+		dmax_mm = pLut->dmax_mm[VL53L0X_DMAX_LUT_SIZE - 1];
 	} else{
-		get_dmax_lut_points(CurrentParameters.dmax_lut,
+		get_dmax_lut_points(pLut,
 			VL53L0X_DMAX_LUT_SIZE, ambRateMeas, &index0, &index1);
 
 		if (index0 == index1) {
-			dmax_mm = CurrentParameters.dmax_lut.dmax_mm[index0];
+			dmax_mm = pLut->dmax_mm[index0];
 		} else {
-			amb0 = CurrentParameters.dmax_lut.ambRate_mcps[index0];
-			amb1 = CurrentParameters.dmax_lut.ambRate_mcps[index1];
-			dmax0 = CurrentParameters.dmax_lut.dmax_mm[index0];
-			dmax1 = CurrentParameters.dmax_lut.dmax_mm[index1];
+			amb0 = pLut->ambRate_mcps[index0];
+			amb1 = pLut->ambRate_mcps[index1];
+			dmax0 = pLut->dmax_mm[index0];
+			dmax1 = pLut->dmax_mm[index1];
 			if ((amb1 - amb0) != 0) {
 				/* Fix16:16/Fix16:8 => Fix16:8 */
 				linearSlope = (dmax0-dmax1)/((amb1-amb0) >> 8);
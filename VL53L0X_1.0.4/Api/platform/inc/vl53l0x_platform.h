@@ -50,6 +50,12 @@ extern "C" {
  *  @{
  */
 
+/** @brief transport a device is reached through, see vl53l0x_platform_esp32.h */
+typedef struct VL53L0X_Bus_s VL53L0X_Bus_t;
+
+/** @brief latest sample register of a device, see vl53l0x_latest.h */
+typedef struct VL53L0X_Latest_s VL53L0X_Latest_t;
+
 /**
  * @struct  VL53L0X_Dev_t
  * @brief    Generic PAL device type that does link between API and platform abstraction layer
@@ -58,13 +64,40 @@ extern "C" {
 typedef struct {
     VL53L0X_DevData_t Data;               /*!< embed ST Ewok Dev  data as "Data"*/
 
-    /*!< user specific field */
+    /*!< user specific field, widest first : no padding between them */
+    int64_t   Deadline;                  /*!< timer time [us] blocking calls give up at, 0 : none */
+    VL53L0X_Bus_t *Bus;                  /*!< transport of the device, NULL : default bus (i2c_mux_write) */
+    VL53L0X_Latest_t *Latest;            /*!< register the measurements are published to, NULL : none */
+    uint32_t  BusBytes;                  /*!< bytes on the bus of the device transfers, counted by the transport, wraps around */
+
+    uint16_t  comms_speed_khz;           /*!< Comms speed [kHz] : typically 400kHz for I2C           */
     uint8_t   I2cDevAddr;                /*!< i2c device address user specific field */
     uint8_t   comms_type;                /*!< Type of comms : VL53L0X_COMMS_I2C or VL53L0X_COMMS_SPI */
-    uint16_t  comms_speed_khz;           /*!< Comms speed [kHz] : typically 400kHz for I2C           */
+
+    uint8_t   PageCurrent;               /*!< last 0xFF page select value seen by the device */
+    uint8_t   PagePending;               /*!< page select value not yet sent to the device */
+    uint8_t   PageFlags;                 /*!< VL53L0X_PAGE_xxx, 0 : page unknown, nothing pending */
+
+    uint8_t   RefSpadSearch;             /*!< VL53L0X_REFSPAD_SEARCH_xxx used by VL53L0X_Device_setup, 0 : ST linear search */
+    uint8_t   InterruptSettings;         /*!< VL53L0X_INTERRUPT_SETTINGS_xxx : threshold settings held by the device */
+
+    uint8_t   MuxMask;                   /*!< multiplexer control byte enabling the device channel (TCA9548A : 1 << channel), 0 : not behind the bus multiplexer */
+    int8_t    BusPriority;               /*!< VL53L0X_BUS_PRIORITY_xxx of the device transfers, 0 : normal */
 
 } VL53L0X_Dev_t;
 
+/** @brief PageCurrent holds the device page */
+#define VL53L0X_PAGE_KNOWN      0x01
+/** @brief PagePending must be written before the next access */
+#define VL53L0X_PAGE_PENDING    0x02
+
+/** @brief state of the interrupt threshold settings unknown, reload them */
+#define VL53L0X_INTERRUPT_SETTINGS_UNKNOWN  0x00
+/** @brief interrupt threshold settings loaded and enabled */
+#define VL53L0X_INTERRUPT_SETTINGS_LOADED   0x01
+/** @brief interrupt threshold settings loaded, disabled by the last stop */
+#define VL53L0X_INTERRUPT_SETTINGS_PARKED   0x02
+
 
 /**
  * @brief   Declare the device Handle as a pointer of the structure @a VL53L0X_Dev_t.
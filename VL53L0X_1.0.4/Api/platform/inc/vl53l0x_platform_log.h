@@ -66,6 +66,7 @@ enum {
     TRACE_MODULE_NONE              = 0x0,
     TRACE_MODULE_API               = 0x1,
     TRACE_MODULE_PLATFORM          = 0x2,
+    TRACE_MODULE_DRIVER            = 0x4, // component sources, src/
     TRACE_MODULE_ALL               = 0x7fffffff //all bits except sign
 };
 
@@ -74,6 +75,30 @@ enum {
 
 #include <sys/time.h>
 
+/*
+ * Compile time filter, set from Kconfig. A trace of a module outside
+ * VL53L0X_LOG_MODULES or above VL53L0X_LOG_LEVEL compiles to nothing, its
+ * format and arguments included, unless its TRACE_FUNCTION_* bits are in
+ * VL53L0X_LOG_FUNCTIONS. VL53L0X_LOG_CALLS keeps the function entry / exit
+ * traces. VL53L0X_trace_config filters what is left at runtime.
+ */
+#ifndef VL53L0X_LOG_LEVEL
+#define VL53L0X_LOG_LEVEL       TRACE_LEVEL_ALL
+#endif
+#ifndef VL53L0X_LOG_MODULES
+#define VL53L0X_LOG_MODULES     TRACE_MODULE_ALL
+#endif
+#ifndef VL53L0X_LOG_FUNCTIONS
+#define VL53L0X_LOG_FUNCTIONS   TRACE_FUNCTION_ALL
+#endif
+#ifndef VL53L0X_LOG_CALLS
+#define VL53L0X_LOG_CALLS       1
+#endif
+
+#define VL53L0X_LOG_COMPILED(module, level, function) \
+        (((((module) & VL53L0X_LOG_MODULES) != 0) && ((int)(level) <= VL53L0X_LOG_LEVEL)) \
+            || (((function) & VL53L0X_LOG_FUNCTIONS) != 0))
+
 extern uint32_t _trace_level;
 
 
@@ -82,24 +107,38 @@ int32_t VL53L0X_trace_config(char *filename, uint32_t modules, uint32_t level, u
 
 void trace_print_module_function(uint32_t module, uint32_t level, uint32_t function, const char *format, ...);
 
+// every call goes through the compile time filter
+#define trace_print_module_function(module, level, function, ...) \
+        (VL53L0X_LOG_COMPILED(module, level, function) ? \
+            (trace_print_module_function)(module, level, function, ##__VA_ARGS__) : (void)0)
+
 
 //extern FILE * log_file;
 
 #define LOG_GET_TIME() (int)clock()
 
+#if VL53L0X_LOG_CALLS
+#define _LOG_FUNCTION_COMPILED(module) (((module) & VL53L0X_LOG_MODULES) != 0)
+
 #define _LOG_FUNCTION_START(module, fmt, ... ) \
-        trace_print_module_function(module, _trace_level, TRACE_FUNCTION_ALL, "%ld <START> %s "fmt"\n", LOG_GET_TIME(), __FUNCTION__, ##__VA_ARGS__);
+        (_LOG_FUNCTION_COMPILED(module) ? (trace_print_module_function)(module, _trace_level, TRACE_FUNCTION_ALL, "%ld <START> %s "fmt"\n", LOG_GET_TIME(), __FUNCTION__, ##__VA_ARGS__) : (void)0);
 
 #define _LOG_FUNCTION_END(module, status, ... )\
-        trace_print_module_function(module, _trace_level, TRACE_FUNCTION_ALL, "%ld <END> %s %d\n", LOG_GET_TIME(), __FUNCTION__, (int)status, ##__VA_ARGS__)
+        (_LOG_FUNCTION_COMPILED(module) ? (trace_print_module_function)(module, _trace_level, TRACE_FUNCTION_ALL, "%ld <END> %s %d\n", LOG_GET_TIME(), __FUNCTION__, (int)status, ##__VA_ARGS__) : (void)0)
 
 #define _LOG_FUNCTION_END_FMT(module, status, fmt, ... )\
-        trace_print_module_function(module, _trace_level, TRACE_FUNCTION_ALL, "%ld <END> %s %d "fmt"\n", LOG_GET_TIME(),  __FUNCTION__, (int)status,##__VA_ARGS__)
+        (_LOG_FUNCTION_COMPILED(module) ? (trace_print_module_function)(module, _trace_level, TRACE_FUNCTION_ALL, "%ld <END> %s %d "fmt"\n", LOG_GET_TIME(),  __FUNCTION__, (int)status,##__VA_ARGS__) : (void)0)
+#else
+    #define _LOG_FUNCTION_START(module, fmt, ... ) (void)0
+    #define _LOG_FUNCTION_END(module, status, ... ) (void)0
+    #define _LOG_FUNCTION_END_FMT(module, status, fmt, ... ) (void)0
+#endif
 
 // __func__ is gcc only
 //#define VL53L0X_ErrLog( fmt, ...)  fprintf(stderr, "VL53L0X_ErrLog %s" fmt "\n", __func__, ##__VA_ARGS__)
 
 #else /* VL53L0X_LOG_ENABLE no logging */
+    #define VL53L0X_LOG_COMPILED(module, level, function) 0
     #define VL53L0X_ErrLog(...) (void)0
     #define _LOG_FUNCTION_START(module, fmt, ... ) (void)0
     #define _LOG_FUNCTION_END(module, status, ... ) (void)0
@@ -1,2 +1,2 @@
-COMPONENT_ADD_INCLUDEDIRS := . VL53L0X_1.0.4/Api/core/inc VL53L0X_1.0.4/Api/platform/inc core/inc platform/inc include 
+COMPONENT_ADD_INCLUDEDIRS := . VL53L0X_1.0.4/Api/core/inc VL53L0X_1.0.4/Api/platform/inc core/inc platform/inc platform/esp32/inc include 
 COMPONENT_SRCDIRS := . VL53L0X_1.0.4/Api/core/src core/src platform/esp32/src src
@@ -13,16 +13,30 @@
 #include "freertos/task.h"
 
 #include "vl53l0x.h"
+#include "vl53l0x_pool.h"
 
 static const char* TAG = "test";
 
+// VL53L0X_Device_init is the deepest chain of the task, 1472 B on the host
+// (tools/vl53l0x_stack_depth.py), more with the Xtensa register windows.
+// esp_log and the i2c driver come on top, the device itself is in the pool.
+#define VL53L0X_TASK_STACK 4096
+
 void vl53l0x_task(void* p)
 {
-    VL53L0X_Dev_t dev;
+    VL53L0X_Dev_t *dev = VL53L0X_Pool_acquire();
+
+    if (dev == NULL)
+    {
+        ESP_LOGE(TAG, "no device left in the pool");
+        vTaskDelete(NULL);
+        return;
+    }
 
-    VL53L0X_Error err = VL53L0X_Device_init(&dev);
+    VL53L0X_Error err = VL53L0X_Device_init(dev);
     if (err != VL53L0X_DEVICEERROR_NONE)
     {
+        VL53L0X_Pool_release(dev);
         vTaskDelete(NULL);
         return;
     }
@@ -30,7 +44,7 @@ void vl53l0x_task(void* p)
     while (1)
     {
         uint16_t data = 0;
-        if (VL53L0X_Device_getMeasurement(&dev, data) == VL53L0X_ERROR_NONE)
+        if (VL53L0X_Device_getMeasurement(dev, &data) == VL53L0X_ERROR_NONE)
         {
         }
 
@@ -41,5 +55,5 @@ void vl53l0x_task(void* p)
 void app_main()
 {
     ESP_ERROR_CHECK(nvs_flash_init());
-    xTaskCreate(&vl53l0x_task, "test", 2049, NULL, 2, NULL);
+    xTaskCreate(&vl53l0x_task, "test", VL53L0X_TASK_STACK, NULL, 2, NULL);
 }
\ No newline at end of file
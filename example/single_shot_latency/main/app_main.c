@@ -0,0 +1,99 @@
+/*
+ * File : app_main.c
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "nvs_flash.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "vl53l0x.h"
+#include "vl53l0x_ranging.h"
+#include "vl53l0x_platform_esp32.h"
+
+static const char* TAG = "latency";
+
+#define SAMPLES 100
+
+static void report(const char *name, uint32_t min_us, uint32_t max_us, uint64_t sum_us,
+                   uint32_t count, const VL53L0X_BusStats_t *bus)
+{
+    if (count == 0)
+        return;
+
+    ESP_LOGI(TAG, "%s: min %u us, avg %u us, max %u us, %u submits/sample, %u bytes/sample",
+             name, min_us, (uint32_t)(sum_us / count), max_us,
+             bus->transactions / count, bus->bytes / count);
+}
+
+// trigger-to-result latency of the stock API
+static void bench_stock(VL53L0X_Dev_t *dev)
+{
+    VL53L0X_RangingMeasurementData_t data;
+    VL53L0X_BusStats_t bus;
+    uint32_t min_us = UINT32_MAX, max_us = 0, count = 0;
+    uint64_t sum_us = 0;
+
+    VL53L0X_reset_bus_stats();
+    for (int i = 0; i < SAMPLES; i++)
+    {
+        int64_t start = esp_timer_get_time();
+        if (VL53L0X_PerformSingleRangingMeasurement(dev, &data) != VL53L0X_ERROR_NONE)
+            continue;
+        uint32_t latency = (uint32_t)(esp_timer_get_time() - start);
+
+        count++;
+        sum_us += latency;
+        min_us = latency < min_us ? latency : min_us;
+        max_us = latency > max_us ? latency : max_us;
+    }
+    VL53L0X_get_bus_stats(&bus);
+
+    report("PerformSingleRangingMeasurement", min_us, max_us, sum_us, count, &bus);
+}
+
+// trigger-to-result latency of the prepared single shot path
+static void bench_fast(VL53L0X_Dev_t *dev)
+{
+    VL53L0X_SingleShot_t ss;
+    VL53L0X_RangingMeasurementData_t data;
+    VL53L0X_BusStats_t bus;
+
+    if (VL53L0X_SingleShot_prepare(&ss, dev) != VL53L0X_ERROR_NONE)
+        return;
+
+    VL53L0X_reset_bus_stats();
+    for (int i = 0; i < SAMPLES; i++)
+    {
+        VL53L0X_SingleShot_measure(&ss, &data);
+    }
+    VL53L0X_get_bus_stats(&bus);
+
+    report("SingleShot_measure", ss.latency.min_us, ss.latency.max_us,
+           ss.latency.sum_us, ss.latency.count, &bus);
+}
+
+void vl53l0x_task(void* p)
+{
+    static VL53L0X_Dev_t dev;
+
+    if (VL53L0X_Device_setup(&dev) == VL53L0X_ERROR_NONE)
+    {
+        bench_stock(&dev);
+        bench_fast(&dev);
+    }
+
+    vTaskDelete(NULL);
+}
+
+void app_main()
+{
+    ESP_ERROR_CHECK(nvs_flash_init());
+    xTaskCreate(&vl53l0x_task, "latency", 4096, NULL, 2, NULL);
+}
@@ -15,10 +15,60 @@
 extern "C" {
 #endif
 
+/**
+ * Progress of VL53L0X_Device_setupUntil, each value names the last completed step.
+ */
+typedef enum {
+    VL53L0X_SETUP_START = 0,
+    VL53L0X_SETUP_DATA_INIT,        /*!< comms, DataInit and device info */
+    VL53L0X_SETUP_STATIC_INIT,      /*!< StaticInit */
+    VL53L0X_SETUP_REF_CALIBRATION,  /*!< reference calibration */
+    VL53L0X_SETUP_DONE,             /*!< reference SPAD management, device idle */
+} VL53L0X_SetupStep_t;
+
+/**
+ * Bring the device up to idle: comms, DataInit, StaticInit, reference
+ * calibration and reference SPAD management. No measurement is started.
+ *
+ * The device must start zeroed (static, { 0 }, memset or
+ * VL53L0X_Pool_acquire), with only the fields that differ from the defaults
+ * set. Bus, MuxMask, BusPriority, RefSpadSearch, I2cDevAddr and Latest are
+ * read as given, zero meaning the default. The same holds for every setup
+ * and init call below.
+ */
+VL53L0X_Error VL53L0X_Device_setup(VL53L0X_Dev_t *device);
 VL53L0X_Error VL53L0X_Device_init(VL53L0X_Dev_t *device);
 VL53L0X_Error VL53L0X_Device_deinit(VL53L0X_Dev_t *device);
 VL53L0X_Error VL53L0X_Device_getMeasurement(VL53L0X_Dev_t *device, uint16_t* data);
 
+/**
+ * Collect the samples of several ranging devices without waiting on any:
+ * one read of the result block per device, the interrupt clears of the
+ * devices with a new sample, each as one bus submission per bus.
+ * Bit i of *pReady is set when data[i] holds a new sample of devices[i]
+ * passing the proximity filter. The interrupt clear is not read back, a
+ * clear lost on the bus shows the same sample again on the next call.
+ * @param   count   up to 32 devices
+ * @return  the first error of a device, the other samples are collected anyway
+ */
+VL53L0X_Error VL53L0X_Device_getMeasurements(VL53L0X_Dev_t *devices, uint8_t count, uint16_t *data, uint32_t *pReady);
+
+/**
+ * Same calls bounded by a deadline (absolute esp_timer_get_time, us).
+ * They return VL53L0X_ERROR_TIME_OUT once it has passed. setupUntil keeps
+ * the completed steps in *step: call it again with the same step to resume,
+ * only the interrupted step is run again.
+ */
+VL53L0X_Error VL53L0X_Device_setupUntil(VL53L0X_Dev_t *device, VL53L0X_SetupStep_t *step, int64_t deadline_us);
+VL53L0X_Error VL53L0X_Device_deinitUntil(VL53L0X_Dev_t *device, int64_t deadline_us);
+VL53L0X_Error VL53L0X_Device_getMeasurementUntil(VL53L0X_Dev_t *device, uint16_t* data, int64_t deadline_us);
+
+/**
+ * Run the setup steps after *step up to and including last, without deadline.
+ */
+VL53L0X_Error VL53L0X_Device_setupThrough(VL53L0X_Dev_t *device, VL53L0X_SetupStep_t *step,
+                                          VL53L0X_SetupStep_t last);
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
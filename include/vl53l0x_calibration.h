@@ -0,0 +1,138 @@
+/*
+ * File : vl53l0x_calibration.h
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#ifndef VL53L0X_CALIBRATION_H_
+#define VL53L0X_CALIBRATION_H_
+
+#include "vl53l0x_api.h"
+#include "vl53l0x_ranging.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Stop rule of a calibration run.
+ * The run stops once the confidence interval of the calibrated quantity,
+ * ConfidenceZ * stddev / sqrt(n), is within Tolerance, or after MaxSamples
+ * measurements.
+ */
+typedef struct {
+    FixPoint1616_t Tolerance;   /* interval half width : mm for offset, MCPS for crosstalk */
+    FixPoint1616_t ConfidenceZ; /* z score of the interval, 1.96 : 95% */
+    uint16_t MinSamples;        /* valid samples before the first check */
+    uint16_t MaxSamples;        /* measurements, valid or not, hard cap */
+} VL53L0X_CalibrationConfig_t;
+
+/*
+ * 1mm at 95%, ST runs 50 measurements. With the 1 to 3mm range noise of a
+ * close target, (1.96 * stddev / 1mm)^2 gives 4 to 35 samples. The 0.25mm
+ * register resolution would need 60 to 550.
+ */
+#define VL53L0X_CALIBRATION_OFFSET_DEFAULT \
+    { 0x00010000, 0x0001F5C3, 10, 50 }
+/*
+ * 0.001 MCPS at 95%, 8 steps of the 3.13 compensation register. A sample's
+ * estimate varies by the return rate per SPAD times the range noise over the
+ * distance, about 0.1 MCPS * 5mm / 400mm = 0.00125 MCPS, so some 10 samples
+ * get there.
+ */
+#define VL53L0X_CALIBRATION_XTALK_DEFAULT \
+    { 0x00000042, 0x0001F5C3, 10, 50 }
+
+typedef enum {
+    VL53L0X_CALIBRATION_OFFSET = 0,
+    VL53L0X_CALIBRATION_XTALK,
+} VL53L0X_CalibrationKind_t;
+
+/**
+ * Running mean and variance (Welford).
+ */
+typedef struct {
+    uint32_t count;
+    float mean;
+    float m2;
+} VL53L0X_RunningStats_t;
+
+void VL53L0X_RunningStats_reset(VL53L0X_RunningStats_t *stats);
+void VL53L0X_RunningStats_add(VL53L0X_RunningStats_t *stats, float x);
+/* sample variance, 0 below two samples */
+float VL53L0X_RunningStats_variance(const VL53L0X_RunningStats_t *stats);
+
+typedef struct {
+    uint16_t Measurements;      /* ranging measurements run */
+    uint16_t ValidSamples;      /* measurements with RangeStatus 0 */
+    uint8_t Converged;          /* 1 : stopped on tolerance, 0 : stopped on MaxSamples */
+    FixPoint1616_t Mean;        /* mean of the calibrated quantity */
+    FixPoint1616_t HalfWidth;   /* confidence interval half width at the stop */
+} VL53L0X_CalibrationReport_t;
+
+/**
+ * Calibration run of one device, driven one measurement at a time.
+ */
+typedef struct {
+    VL53L0X_Dev_t *device;
+    VL53L0X_CalibrationKind_t kind;
+    VL53L0X_CalibrationConfig_t config;
+    FixPoint1616_t distance;
+    uint8_t tcc_enabled;
+    uint8_t done;
+    VL53L0X_SingleShot_t shot;
+    VL53L0X_RunningStats_t quantity;    /* range (offset) or per sample crosstalk */
+    VL53L0X_RunningStats_t range;
+    VL53L0X_RunningStats_t signal;
+    VL53L0X_RunningStats_t spads;
+    VL53L0X_CalibrationReport_t report;
+} VL53L0X_Calibration_t;
+
+/**
+ * Prepare the device as VL53L0X_PerformOffsetCalibration /
+ * VL53L0X_PerformXTalkCalibration do and reset the statistics.
+ * @param   distance    target distance in mm
+ */
+VL53L0X_Error VL53L0X_Calibration_begin(VL53L0X_Calibration_t *cal, VL53L0X_Dev_t *device,
+                                        VL53L0X_CalibrationKind_t kind, FixPoint1616_t distance,
+                                        const VL53L0X_CalibrationConfig_t *config);
+
+/**
+ * Account one ranging measurement, sets cal->done when the stop rule is met.
+ * NULL accounts a measurement without range (VL53L0X_ERROR_RANGE_ERROR).
+ */
+void VL53L0X_Calibration_addSample(VL53L0X_Calibration_t *cal,
+                                   const VL53L0X_RangingMeasurementData_t *pRangingMeasurementData);
+
+/**
+ * Run one measurement and account it.
+ */
+VL53L0X_Error VL53L0X_Calibration_step(VL53L0X_Calibration_t *cal);
+
+/**
+ * Compute and apply the calibration, restore the sequence steps.
+ * @param   pOffsetMicroMeter               offset result, may be NULL for crosstalk
+ * @param   pXTalkCompensationRateMegaCps   crosstalk result, may be NULL for offset
+ */
+VL53L0X_Error VL53L0X_Calibration_finish(VL53L0X_Calibration_t *cal, int32_t *pOffsetMicroMeter,
+                                         FixPoint1616_t *pXTalkCompensationRateMegaCps);
+
+/**
+ * Early terminating replacements of VL53L0X_PerformOffsetCalibration and
+ * VL53L0X_PerformXTalkCalibration. config and report may be NULL.
+ */
+VL53L0X_Error VL53L0X_Calibration_offset(VL53L0X_Dev_t *device, FixPoint1616_t CalDistanceMilliMeter,
+                                         const VL53L0X_CalibrationConfig_t *config,
+                                         int32_t *pOffsetMicroMeter,
+                                         VL53L0X_CalibrationReport_t *report);
+VL53L0X_Error VL53L0X_Calibration_xtalk(VL53L0X_Dev_t *device, FixPoint1616_t XTalkCalDistance,
+                                        const VL53L0X_CalibrationConfig_t *config,
+                                        FixPoint1616_t *pXTalkCompensationRateMegaCps,
+                                        VL53L0X_CalibrationReport_t *report);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+#endif // VL53L0X_CALIBRATION_H_
@@ -0,0 +1,77 @@
+/*
+ * File : vl53l0x_latest.h
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#ifndef VL53L0X_LATEST_H_
+#define VL53L0X_LATEST_H_
+
+#include "vl53l0x_api.h"
+#include "vl53l0x_platform.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Latest sample register.
+ * The task acquiring a device publishes each of its measurements here; any
+ * number of tasks, on any core, read the newest one without touching the
+ * bus. The register keeps two copies and tells readers which one is
+ * stable: a reader never waits for the publisher, even one preempted in the
+ * middle of a publication, and copies again only when a whole publication
+ * went by during its copy.
+ * With device->Latest set, VL53L0X_Device_getMeasurement,
+ * VL53L0X_Device_getMeasurements and VL53L0X_SingleShot_poll publish the
+ * measurements they read, whatever their RangeStatus.
+ */
+
+typedef struct {
+    VL53L0X_RangingMeasurementData_t Data;
+    int64_t timestamp_us;               /*!< esp_timer_get_time at publication */
+} VL53L0X_LatestCopy_t;
+
+struct VL53L0X_Latest_s {
+    uint32_t seq;                       /*!< 2 x publications, odd while copy[0] is written */
+    VL53L0X_LatestCopy_t copy[2];
+};
+
+/**
+ * Empty the register, before its device publishes to it.
+ */
+void VL53L0X_Latest_init(VL53L0X_Latest_t *latest);
+
+/**
+ * Publish a measurement, from the one task acquiring the device.
+ */
+void VL53L0X_Latest_publish(VL53L0X_Latest_t *latest,
+                            const VL53L0X_RangingMeasurementData_t *pRangingMeasurementData);
+
+/**
+ * Publish a measurement of the device to its register, if it has one.
+ */
+static inline void VL53L0X_Latest_record(VL53L0X_Dev_t *device,
+                                         const VL53L0X_RangingMeasurementData_t *pRangingMeasurementData)
+{
+    if (device->Latest != NULL)
+        VL53L0X_Latest_publish(device->Latest, pRangingMeasurementData);
+}
+
+/**
+ * Read the newest measurement, from any task.
+ * @param   ptimestamp_us   publication time, may be NULL
+ * @return  number of the measurement, counting the publications, 0 if none
+ *          yet and *pRangingMeasurementData untouched. A reader polling
+ *          for new samples compares it with the one of its previous read.
+ */
+uint32_t VL53L0X_Latest_read(const VL53L0X_Latest_t *latest,
+                             VL53L0X_RangingMeasurementData_t *pRangingMeasurementData,
+                             int64_t *ptimestamp_us);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+#endif // VL53L0X_LATEST_H_
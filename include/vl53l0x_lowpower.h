@@ -0,0 +1,109 @@
+/*
+ * File : vl53l0x_lowpower.h
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#ifndef VL53L0X_LOWPOWER_H_
+#define VL53L0X_LOWPOWER_H_
+
+#include "vl53l0x.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Duty-cycled ranging configuration.
+ * The device runs VL53L0X_DEVICEMODE_CONTINUOUS_TIMED_RANGING and sleeps
+ * internally between two measurements.
+ */
+typedef struct {
+    uint32_t TimingBudgetMicroSeconds;           /* ranging time of one sample */
+    uint32_t InterMeasurementPeriodMilliSeconds; /* sample period, >= timing budget */
+} VL53L0X_LowPowerConfig_t;
+
+/**
+ * Energy model coefficients.
+ * Defaults are datasheet typicals (19 mA active ranging at 2V8 split
+ * between digital core and VCSEL drive). Replace them with values measured
+ * on the target board to get absolute numbers; relative comparison of
+ * duty cycles is meaningful with the defaults.
+ */
+typedef struct {
+    uint32_t SupplyMilliVolt;     /* AVDD */
+    uint32_t DigitalMicroAmp;     /* core current while ranging */
+    uint32_t VcselMicroAmp;       /* average VCSEL drive at the default periods */
+    uint32_t TimedIdleMicroAmp;   /* between two timed measurements */
+    uint32_t StandbyMicroAmp;     /* software standby */
+    uint32_t BusMicroAmp;         /* I/O current while the i2c bus is active */
+} VL53L0X_EnergyModel_t;
+
+#define VL53L0X_ENERGY_MODEL_DEFAULT \
+    { 2800, 9000, 10000, 16, 5, 1000 }
+
+/* VCSEL periods the VcselMicroAmp coefficient refers to */
+#define VL53L0X_ENERGY_REF_PRE_RANGE_PCLKS    14
+#define VL53L0X_ENERGY_REF_FINAL_RANGE_PCLKS  10
+
+/**
+ * Estimated energy of one sample, in nanojoules (uJ = nJ / 1000).
+ */
+typedef struct {
+    uint32_t RangingNanoJoule;    /* digital + VCSEL over the timing budget */
+    uint32_t IdleNanoJoule;       /* rest of the inter-measurement period */
+    uint32_t BusNanoJoule;        /* i2c traffic of the read path */
+    uint32_t TotalNanoJoule;
+    uint32_t AverageMicroWatt;    /* at the configured period */
+    uint32_t StandbyMicroWatt;    /* while parked with VL53L0X_LowPower_standby */
+    uint32_t BusBytesPerSample;   /* measured, or nominal before the first sample */
+} VL53L0X_EnergyEstimate_t;
+
+typedef struct {
+    VL53L0X_Dev_t *device;
+    VL53L0X_LowPowerConfig_t config;
+    VL53L0X_EnergyModel_t model;
+    uint8_t VhvSettings;
+    uint8_t PhaseCal;
+    uint8_t standby;
+    uint32_t samples;
+    uint32_t bus_bytes;
+} VL53L0X_LowPower_t;
+
+/**
+ * Set up the device and start timed ranging with the given configuration.
+ * The energy model is initialized to VL53L0X_ENERGY_MODEL_DEFAULT.
+ */
+VL53L0X_Error VL53L0X_LowPower_init(VL53L0X_LowPower_t *lp, VL53L0X_Dev_t *device,
+                                    const VL53L0X_LowPowerConfig_t *config);
+
+/**
+ * Change timing budget / period while running.
+ */
+VL53L0X_Error VL53L0X_LowPower_configure(VL53L0X_LowPower_t *lp,
+                                         const VL53L0X_LowPowerConfig_t *config);
+
+/**
+ * Stop ranging and put the device in standby between bursts.
+ */
+VL53L0X_Error VL53L0X_LowPower_standby(VL53L0X_LowPower_t *lp);
+
+/**
+ * Leave standby, restore calibration and configuration, restart ranging.
+ */
+VL53L0X_Error VL53L0X_LowPower_resume(VL53L0X_LowPower_t *lp);
+
+/**
+ * Same as VL53L0X_Device_getMeasurement, with bus usage accounting.
+ */
+VL53L0X_Error VL53L0X_LowPower_getMeasurement(VL53L0X_LowPower_t *lp, uint16_t *data);
+
+void VL53L0X_LowPower_estimateEnergy(const VL53L0X_LowPower_t *lp,
+                                     VL53L0X_EnergyEstimate_t *estimate);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+#endif // VL53L0X_LOWPOWER_H_
@@ -0,0 +1,35 @@
+/*
+ * File : vl53l0x_measurement.h
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#ifndef VL53L0X_MEASUREMENT_H_
+#define VL53L0X_MEASUREMENT_H_
+
+#include "vl53l0x_api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Drop-in replacement of VL53L0X_StartMeasurement.
+ * The fixed register sequences go out as one bus submission, and the
+ * interrupt threshold settings are loaded only if the device does not hold
+ * them yet (VL53L0X_Dev_t.InterruptSettings): after a stop only the
+ * registers the stop cleared are written again.
+ */
+VL53L0X_Error VL53L0X_Measurement_start(VL53L0X_DEV Dev);
+
+/**
+ * Drop-in replacement of VL53L0X_StopMeasurement, one bus submission.
+ */
+VL53L0X_Error VL53L0X_Measurement_stop(VL53L0X_DEV Dev);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+#endif // VL53L0X_MEASUREMENT_H_
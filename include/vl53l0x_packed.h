@@ -0,0 +1,74 @@
+/*
+ * File : vl53l0x_packed.h
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#ifndef VL53L0X_PACKED_H_
+#define VL53L0X_PACKED_H_
+
+#include "vl53l0x_def.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Packed samples, for logging and streaming.
+ * A VL53L0X_RangingMeasurementData_t takes 28 bytes, a packed sample 12,
+ * little endian whatever the host:
+ *
+ *  0  RangeMilliMeter, in 1/4 mm when F is set
+ *  2  RangeDMaxMilliMeter
+ *  4  SignalRateRtnMegaCps, 9.7 as the device reports it
+ *  6  AmbientRateRtnMegaCps, 9.7
+ *  8  EffectiveSpadRtnCount, 8.8
+ * 10  bits 0-11 : TimeStamp - TimeStamp of the previous sample
+ *     bits 12-14 : RangeStatus, 7 for 255 (none)
+ *     bit 15 : F, RangeFractionalPart not 0
+ *
+ * Unpacking gives back the exact sample the driver decoded: ZoneId and
+ * MeasurementTimeUsec are always 0, the rates keep the 9.7 precision of the
+ * device. The driver leaves TimeStamp 0, the application stamps its samples
+ * in the unit it likes (e.g. ms) before packing them.
+ */
+
+/** largest TimeStamp difference between two samples in a row */
+#define VL53L0X_PACKED_DELTA_MAX    0x0FFF
+
+typedef struct {
+    uint8_t bytes[12];
+} VL53L0X_PackedSample_t;
+
+/**
+ * Check a sample packs without loss, its TimeStamp aside.
+ */
+uint8_t VL53L0X_Packed_fits(const VL53L0X_RangingMeasurementData_t *pRangingMeasurementData);
+
+/**
+ * Pack samples.
+ * @param   pTimeStamp  TimeStamp the first sample is relative to, left at
+ *                      the TimeStamp of the last sample packed
+ * @return  samples packed. Packing stops before a sample more than
+ *          VL53L0X_PACKED_DELTA_MAX after the previous one, the start of a
+ *          new block with its own base, or one that does not fit.
+ */
+uint32_t VL53L0X_Packed_encode(const VL53L0X_RangingMeasurementData_t *pRangingMeasurementData,
+                               uint32_t count, uint32_t *pTimeStamp,
+                               VL53L0X_PackedSample_t *packed);
+
+/**
+ * Unpack samples.
+ * @param   pTimeStamp  TimeStamp the encoder started from, left at the
+ *                      TimeStamp of the last sample
+ */
+void VL53L0X_Packed_decode(const VL53L0X_PackedSample_t *packed, uint32_t count,
+                           uint32_t *pTimeStamp,
+                           VL53L0X_RangingMeasurementData_t *pRangingMeasurementData);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+#endif // VL53L0X_PACKED_H_
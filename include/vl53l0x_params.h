@@ -0,0 +1,53 @@
+/*
+ * File : vl53l0x_params.h
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#ifndef VL53L0X_PARAMS_H_
+#define VL53L0X_PARAMS_H_
+
+#include "vl53l0x_api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Raw copy of the registers behind VL53L0X_GetDeviceParameters,
+ * big endian as on the device.
+ */
+typedef struct {
+    uint8_t system[7];          /*!< 0x01..0x07 : sequence config, inter measurement period (0x04) */
+    uint8_t xtalk[2];           /*!< 0x20 : crosstalk compensation peak rate */
+    uint8_t offset[2];          /*!< 0x28 : part to part range offset */
+    uint8_t final_limit[3];     /*!< 0x44..0x46 : final range min count rate, msrc timeout */
+    uint8_t pre_range[3];       /*!< 0x50..0x52 : pre range vcsel period, timeout */
+    uint8_t pre_limit[2];       /*!< 0x64 : pre range min count rate */
+    uint8_t final_range[3];     /*!< 0x70..0x72 : final range vcsel period, timeout */
+    uint8_t osc_calibrate[2];   /*!< 0xF8 : oscillator calibration */
+} VL53L0X_ParamsImage_t;
+
+/**
+ * Read the configuration registers in one bus submission.
+ */
+VL53L0X_Error VL53L0X_Params_read(VL53L0X_DEV Dev, VL53L0X_ParamsImage_t *image);
+
+/**
+ * Same result, and same updates of the device data, as
+ * VL53L0X_GetDeviceParameters, computed from a register image.
+ */
+VL53L0X_Error VL53L0X_Params_decode(VL53L0X_DEV Dev, const VL53L0X_ParamsImage_t *image,
+                                    VL53L0X_DeviceParameters_t *pDeviceParameters);
+
+/**
+ * Drop-in replacement of VL53L0X_GetDeviceParameters: read + decode.
+ */
+VL53L0X_Error VL53L0X_Params_get(VL53L0X_DEV Dev, VL53L0X_DeviceParameters_t *pDeviceParameters);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+#endif // VL53L0X_PARAMS_H_
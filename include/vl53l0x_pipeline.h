@@ -0,0 +1,72 @@
+/*
+ * File : vl53l0x_pipeline.h
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#ifndef VL53L0X_PIPELINE_H_
+#define VL53L0X_PIPELINE_H_
+
+#include "vl53l0x_api.h"
+#include "vl53l0x.h"
+#include "vl53l0x_refspad.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * One sensor brought up by VL53L0X_Pipeline_setup.
+ */
+typedef struct {
+    VL53L0X_Dev_t *device;
+    VL53L0X_Error Status;                   /*!< first error, the unit is skipped afterwards */
+    VL53L0X_SetupStep_t Step;               /*!< last completed step, VL53L0X_SETUP_DONE once idle */
+
+    uint32_t RefSpadCount;                  /*!< reference SPAD management */
+    uint8_t IsApertureSpads;
+    uint8_t VhvSettings;                    /*!< reference calibration */
+    uint8_t PhaseCal;
+
+    uint32_t ElapsedMicroSeconds;           /*!< time from begin to done */
+
+    /* setup in progress */
+    uint8_t stage;
+    uint8_t measuring;                      /*!< device busy with a measurement */
+    int32_t start_us;
+    int32_t measure_us;                     /*!< timer value at the measurement start */
+    uint8_t SequenceConfig;                 /*!< restored after the reference measurements */
+    uint8_t needAptSpads;
+    uint32_t currentSpadIndex;
+    uint16_t peakSignalRateRef;
+    VL53L0X_RefSpadBracket_t bracket;
+} VL53L0X_PipelineUnit_t;
+
+/**
+ * Prepare a unit for VL53L0X_Pipeline_step.
+ */
+void VL53L0X_Pipeline_begin(VL53L0X_PipelineUnit_t *unit, VL53L0X_Dev_t *device);
+
+/**
+ * Advance a unit without waiting on the sensor: the bus work of
+ * VL53L0X_Device_setup up to the next reference measurement, or one poll of
+ * the measurement in flight. Returns 1 if the unit progressed, else lowers
+ * *pWait_us to the time before it should be stepped again.
+ * The unit is done once Step is VL53L0X_SETUP_DONE or Status is set.
+ */
+uint8_t VL53L0X_Pipeline_step(VL53L0X_PipelineUnit_t *unit, uint32_t *pWait_us);
+
+/**
+ * Same result as VL53L0X_Device_setup on each unit, the setups run side by
+ * side: while the reference calibrations and SPAD measurements of a sensor
+ * integrate, the bus serves the others.
+ * Returns the status of the first failed unit, VL53L0X_ERROR_NONE if none.
+ */
+VL53L0X_Error VL53L0X_Pipeline_setup(VL53L0X_PipelineUnit_t *units, uint16_t count);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+#endif // VL53L0X_PIPELINE_H_
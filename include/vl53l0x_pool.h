@@ -0,0 +1,53 @@
+/*
+ * File : vl53l0x_pool.h
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#ifndef VL53L0X_POOL_H_
+#define VL53L0X_POOL_H_
+
+#include "sdkconfig.h"
+#include "vl53l0x.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Static device pool.
+ * VL53L0X_Dev_t is too large for the stack of a small driver task: take the
+ * devices from this pool instead, sized by CONFIG_VL53L0X_DEVICE_POOL_SIZE
+ * and placed in .bss. Acquire and release are lock free, from any task.
+ */
+
+/** devices in the pool, at most 32 */
+#ifdef CONFIG_VL53L0X_DEVICE_POOL_SIZE
+#define VL53L0X_POOL_SIZE   CONFIG_VL53L0X_DEVICE_POOL_SIZE
+#else
+#define VL53L0X_POOL_SIZE   4
+#endif
+
+/**
+ * Take a device from the pool, zeroed and ready for VL53L0X_Device_init.
+ * @return  the device, NULL once all are taken
+ */
+VL53L0X_Dev_t *VL53L0X_Pool_acquire(void);
+
+/**
+ * Give back a device of the pool, deinitialised first by the caller.
+ * Devices outside the pool are ignored.
+ */
+void VL53L0X_Pool_release(VL53L0X_Dev_t *device);
+
+/**
+ * Devices taken from the pool.
+ */
+uint8_t VL53L0X_Pool_used(void);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+#endif // VL53L0X_POOL_H_
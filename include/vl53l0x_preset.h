@@ -0,0 +1,187 @@
+/*
+ * File : vl53l0x_preset.h
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#ifndef VL53L0X_PRESET_H_
+#define VL53L0X_PRESET_H_
+
+#include "vl53l0x_api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Ranging configuration encoded by the compiler.
+ *
+ * VL53L0X_PRESET() evaluates, as constant expressions, the register values
+ * and device data VL53L0X_Profile_compute() reaches on a device fresh from
+ * VL53L0X_Device_setup(): VCSEL periods, then timing budget, then final
+ * range signal rate and sigma limits. A configuration the API would reject,
+ * or leaving no time for the final range, does not compile.
+ */
+
+/* pre range VCSEL period, timeouts and sequence steps of the default tuning settings */
+#define VL53L0X_PRESET_TUNING_SEQUENCE_CONFIG   0xF8    /* 0x01 */
+#define VL53L0X_PRESET_TUNING_PRE_VCSEL         14
+#define VL53L0X_PRESET_TUNING_MSRC_TIMEOUT      0x25    /* 0x46 */
+#define VL53L0X_PRESET_TUNING_PRE_TIMEOUT       0x0096  /* 0x51 */
+
+/*
+ * Sequence steps the timing budget is split over, as left by
+ * VL53L0X_Device_setup: the tuning settings (0xF8, DataInit's 0xFF is
+ * overwritten) with TCC and MSRC disabled by VL53L0X_StaticInit. 0xE8 : DSS,
+ * pre range, final range.
+ */
+#ifndef VL53L0X_PRESET_SEQUENCE_CONFIG
+#define VL53L0X_PRESET_SEQUENCE_CONFIG \
+    (VL53L0X_PRESET_TUNING_SEQUENCE_CONFIG & ~(0x10 | 0x04))
+#endif
+
+/* VL53L0X_calc_macro_period_ps in ns, VL53L0X_calc_timeout_mclks, VL53L0X_calc_timeout_us */
+#define VL53L0X_PRESET_MACRO_NS(vcsel)      ((2304UL * (vcsel) * 1655UL + 500UL) / 1000UL)
+#define VL53L0X_PRESET_MCLKS(us, vcsel) \
+    (((us) * 1000UL + VL53L0X_PRESET_MACRO_NS(vcsel) / 2) / VL53L0X_PRESET_MACRO_NS(vcsel))
+#define VL53L0X_PRESET_US(mclks, vcsel) \
+    (((mclks) * VL53L0X_PRESET_MACRO_NS(vcsel) + 500UL) / 1000UL)
+
+/* VL53L0X_encode_timeout / VL53L0X_decode_timeout */
+#define VL53L0X_PRESET_ENCODE_MS(x) \
+    ((x) < 0x100UL ? 0 : (x) < 0x200UL ? 1 : (x) < 0x400UL ? 2 : (x) < 0x800UL ? 3 : \
+     (x) < 0x1000UL ? 4 : (x) < 0x2000UL ? 5 : (x) < 0x4000UL ? 6 : (x) < 0x8000UL ? 7 : \
+     (x) < 0x10000UL ? 8 : (x) < 0x20000UL ? 9 : (x) < 0x40000UL ? 10 : (x) < 0x80000UL ? 11 : \
+     (x) < 0x100000UL ? 12 : (x) < 0x200000UL ? 13 : (x) < 0x400000UL ? 14 : 15)
+#define VL53L0X_PRESET_ENCODE(mclks) \
+    ((mclks) == 0 ? 0 : (VL53L0X_PRESET_ENCODE_MS((mclks) - 1) << 8) | \
+                        ((((mclks) - 1) >> VL53L0X_PRESET_ENCODE_MS((mclks) - 1)) & 0xFF))
+#define VL53L0X_PRESET_DECODE(enc)  ((((enc) & 0xFFUL) << ((enc) >> 8)) + 1)
+
+/* timeouts of the default tuning settings, kept by a VCSEL period change */
+#define VL53L0X_PRESET_MSRC_US \
+    VL53L0X_PRESET_US(VL53L0X_PRESET_TUNING_MSRC_TIMEOUT + 1UL, VL53L0X_PRESET_TUNING_PRE_VCSEL)
+#define VL53L0X_PRESET_PRE_US \
+    VL53L0X_PRESET_US(VL53L0X_PRESET_DECODE(VL53L0X_PRESET_TUNING_PRE_TIMEOUT), VL53L0X_PRESET_TUNING_PRE_VCSEL)
+
+/* timeouts re-encoded for the pre range VCSEL period */
+#define VL53L0X_PRESET_MSRC_ENC(pre) \
+    (VL53L0X_PRESET_MCLKS(VL53L0X_PRESET_MSRC_US, pre) > 256 ? 255 : \
+     VL53L0X_PRESET_MCLKS(VL53L0X_PRESET_MSRC_US, pre) - 1)
+#define VL53L0X_PRESET_PRE_ENC(pre) \
+    VL53L0X_PRESET_ENCODE(VL53L0X_PRESET_MCLKS(VL53L0X_PRESET_PRE_US, pre))
+
+/* VL53L0X_set_measurement_timing_budget_micro_seconds, before the final range overhead */
+#define VL53L0X_PRESET_MSRC_SUB(seq, pre) \
+    (((seq) & 0x10 ? VL53L0X_PRESET_US(VL53L0X_PRESET_MSRC_ENC(pre) + 1UL, pre) + 590UL : 0) + \
+     ((seq) & 0x08 ? 2 * (VL53L0X_PRESET_US(VL53L0X_PRESET_MSRC_ENC(pre) + 1UL, pre) + 690UL) : \
+      (seq) & 0x04 ? VL53L0X_PRESET_US(VL53L0X_PRESET_MSRC_ENC(pre) + 1UL, pre) + 660UL : 0))
+#define VL53L0X_PRESET_PRE_SUB(seq, pre) \
+    ((seq) & 0x40 ? VL53L0X_PRESET_US(VL53L0X_PRESET_DECODE(VL53L0X_PRESET_PRE_ENC(pre)), pre) + 660UL : 0)
+#define VL53L0X_PRESET_REMAINING_US(seq, pre, budget) \
+    ((budget) - (1910UL + 960UL) - VL53L0X_PRESET_MSRC_SUB(seq, pre) - VL53L0X_PRESET_PRE_SUB(seq, pre))
+
+#define VL53L0X_PRESET_FINAL_US(seq, pre, budget) \
+    (VL53L0X_PRESET_REMAINING_US(seq, pre, budget) - 550UL)
+#define VL53L0X_PRESET_FINAL_ENC(seq, pre, final, budget) \
+    VL53L0X_PRESET_ENCODE(VL53L0X_PRESET_MCLKS(VL53L0X_PRESET_FINAL_US(seq, pre, budget), final) + \
+                          ((seq) & 0x40 ? VL53L0X_PRESET_DECODE(VL53L0X_PRESET_PRE_ENC(pre)) : 0))
+
+/* phase check limits of VL53L0X_set_vcsel_pulse_period */
+#define VL53L0X_PRESET_PRE_PHASE_HIGH(pre)  ((pre) == 12 ? 0x18 : (pre) == 14 ? 0x30 : (pre) == 16 ? 0x40 : 0x50)
+#define VL53L0X_PRESET_FINAL_PHASE_HIGH(final) \
+    ((final) == 8 ? 0x10 : (final) == 10 ? 0x28 : (final) == 12 ? 0x38 : 0x48)
+#define VL53L0X_PRESET_VCSEL_WIDTH(final)   ((final) == 8 ? 0x02 : 0x03)
+#define VL53L0X_PRESET_PHASECAL_TIMEOUT(final) \
+    ((final) == 8 ? 0x0C : (final) == 10 ? 0x09 : (final) == 12 ? 0x08 : 0x07)
+#define VL53L0X_PRESET_PHASECAL_LIM(final)  ((final) == 8 ? 0x30 : 0x20)
+
+/* zero, or a negative array size when the condition fails */
+#define VL53L0X_PRESET_CHECK(cond)  (0 * sizeof(char[(cond) ? 1 : -1]))
+
+#define VL53L0X_PRESET_VALID(seq, pre, final, budget, signal) \
+    (((seq) & 0x80) && \
+     (pre) % 2 == 0 && (pre) >= 12 && (pre) <= 18 && \
+     (final) % 2 == 0 && (final) >= 8 && (final) <= 14 && \
+     (signal) < (512UL << 16) && \
+     (budget) > 1910UL + 960UL + VL53L0X_PRESET_MSRC_SUB(seq, pre) + VL53L0X_PRESET_PRE_SUB(seq, pre) + 550UL)
+
+#define VL53L0X_PRESET_H8(v)    ((uint8_t)(((v) >> 8) & 0xFF))
+#define VL53L0X_PRESET_L8(v)    ((uint8_t)((v) & 0xFF))
+
+/* register writes of a preset */
+#define VL53L0X_PRESET_PAIRS    19
+
+/**
+ * Registers and device data of a ranging configuration, see VL53L0X_PRESET().
+ */
+typedef struct {
+    uint8_t pairs[2 * VL53L0X_PRESET_PAIRS];    /*!< index, value */
+    uint8_t SequenceConfig;
+    uint32_t MeasurementTimingBudgetMicroSeconds;
+    FixPoint1616_t SignalRateLimit;
+    FixPoint1616_t SigmaLimit;
+    uint16_t LastEncodedTimeout;
+    uint32_t FinalRangeTimeoutMicroSecs;
+    uint8_t FinalRangeVcselPulsePeriod;
+    uint32_t PreRangeTimeoutMicroSecs;
+    uint8_t PreRangeVcselPulsePeriod;
+} VL53L0X_Preset_t;
+
+#define VL53L0X_PRESET_SEQ(seq, pre, final, budget, signal, sigma) { \
+    { \
+        VL53L0X_REG_SYSTEM_SEQUENCE_CONFIG, (seq), \
+        VL53L0X_REG_ALGO_PHASECAL_CONFIG_TIMEOUT, VL53L0X_PRESET_PHASECAL_TIMEOUT(final), \
+        VL53L0X_REG_GLOBAL_CONFIG_VCSEL_WIDTH, VL53L0X_PRESET_VCSEL_WIDTH(final), \
+        VL53L0X_REG_FINAL_RANGE_CONFIG_MIN_COUNT_RATE_RTN_LIMIT, \
+            VL53L0X_PRESET_H8(VL53L0X_FIXPOINT1616TOFIXPOINT97((signal))), \
+        VL53L0X_REG_FINAL_RANGE_CONFIG_MIN_COUNT_RATE_RTN_LIMIT + 1, \
+            VL53L0X_PRESET_L8(VL53L0X_FIXPOINT1616TOFIXPOINT97((signal))), \
+        VL53L0X_REG_MSRC_CONFIG_TIMEOUT_MACROP, VL53L0X_PRESET_MSRC_ENC(pre), \
+        VL53L0X_REG_FINAL_RANGE_CONFIG_VALID_PHASE_LOW, 0x08, \
+        VL53L0X_REG_FINAL_RANGE_CONFIG_VALID_PHASE_HIGH, VL53L0X_PRESET_FINAL_PHASE_HIGH(final), \
+        VL53L0X_REG_PRE_RANGE_CONFIG_VCSEL_PERIOD, ((pre) >> 1) - 1, \
+        VL53L0X_REG_PRE_RANGE_CONFIG_TIMEOUT_MACROP_HI, VL53L0X_PRESET_H8(VL53L0X_PRESET_PRE_ENC(pre)), \
+        VL53L0X_REG_PRE_RANGE_CONFIG_TIMEOUT_MACROP_LO, VL53L0X_PRESET_L8(VL53L0X_PRESET_PRE_ENC(pre)), \
+        VL53L0X_REG_PRE_RANGE_CONFIG_VALID_PHASE_LOW, 0x08, \
+        VL53L0X_REG_PRE_RANGE_CONFIG_VALID_PHASE_HIGH, VL53L0X_PRESET_PRE_PHASE_HIGH(pre), \
+        VL53L0X_REG_FINAL_RANGE_CONFIG_VCSEL_PERIOD, ((final) >> 1) - 1, \
+        VL53L0X_REG_FINAL_RANGE_CONFIG_TIMEOUT_MACROP_HI, \
+            VL53L0X_PRESET_H8(VL53L0X_PRESET_FINAL_ENC(seq, pre, final, budget)), \
+        VL53L0X_REG_FINAL_RANGE_CONFIG_TIMEOUT_MACROP_LO, \
+            VL53L0X_PRESET_L8(VL53L0X_PRESET_FINAL_ENC(seq, pre, final, budget)), \
+        0xFF, 0x01, \
+        VL53L0X_REG_ALGO_PHASECAL_LIM, VL53L0X_PRESET_PHASECAL_LIM(final), \
+        0xFF, 0x00, \
+    }, \
+    (seq) + VL53L0X_PRESET_CHECK(VL53L0X_PRESET_VALID(seq, pre, final, budget, signal)), \
+    (budget), \
+    (signal), \
+    (sigma), \
+    VL53L0X_PRESET_MSRC_ENC(pre), \
+    VL53L0X_PRESET_FINAL_US(seq, pre, budget), \
+    (final), \
+    VL53L0X_PRESET_PRE_US, \
+    (pre), \
+}
+
+/**
+ * Preset initializer: VCSEL periods (pclks), timing budget (us),
+ * final range signal rate (MCPS) and sigma (mm) limits.
+ */
+#define VL53L0X_PRESET(pre, final, budget, signal, sigma) \
+    VL53L0X_PRESET_SEQ(VL53L0X_PRESET_SEQUENCE_CONFIG, pre, final, budget, signal, sigma)
+
+/**
+ * Configure an idle device with a preset: one bus submission, then the
+ * phase calibration the VCSEL periods need. The sequence config the preset
+ * was compiled for is written too.
+ */
+VL53L0X_Error VL53L0X_Preset_load(VL53L0X_DEV Dev, const VL53L0X_Preset_t *preset);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+#endif // VL53L0X_PRESET_H_
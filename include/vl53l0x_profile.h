@@ -0,0 +1,89 @@
+/*
+ * File : vl53l0x_profile.h
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#ifndef VL53L0X_PROFILE_H_
+#define VL53L0X_PROFILE_H_
+
+#include "vl53l0x_api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Ranging profile, as set through the API.
+ */
+typedef struct {
+    uint8_t PreRangeVcselPeriod;        /* pclks */
+    uint8_t FinalRangeVcselPeriod;      /* pclks */
+    uint32_t TimingBudgetMicroSeconds;
+    FixPoint1616_t SignalRateLimit;     /* MCPS, SIGNAL_RATE_FINAL_RANGE check */
+    FixPoint1616_t SigmaLimit;          /* mm, SIGMA_FINAL_RANGE check */
+} VL53L0X_ProfileConfig_t;
+
+/* ranging profiles of the ST API user manual */
+#define VL53L0X_PROFILE_DEFAULT \
+    { 14, 10, 33000, 0x00004000, 18 << 16 }
+#define VL53L0X_PROFILE_LONG_RANGE \
+    { 18, 14, 33000, 0x00001999, 60 << 16 }
+#define VL53L0X_PROFILE_HIGH_ACCURACY \
+    { 14, 10, 200000, 0x00004000, 18 << 16 }
+#define VL53L0X_PROFILE_HIGH_SPEED \
+    { 14, 10, 20000, 0x00004000, 32 << 16 }
+
+/* page 0 registers of the image : 0x01, 0x30..0x32, 0x44..0x48, 0x50..0x57, 0x60..0x67, 0x70..0x72 */
+#define VL53L0X_PROFILE_IMAGE_SIZE  28
+
+/**
+ * Registers and device data a profile leaves behind, phase calibration included.
+ */
+typedef struct {
+    uint8_t regs[VL53L0X_PROFILE_IMAGE_SIZE];
+    uint8_t PhaseCalLimit;              /*!< page 1 0x30 */
+    uint8_t PhaseCal;                   /*!< 0xEE, result of the phase calibration */
+
+    uint8_t SequenceConfig;
+    uint32_t MeasurementTimingBudgetMicroSeconds;
+    uint8_t LimitChecksEnable[VL53L0X_CHECKENABLE_NUMBER_OF_CHECKS];
+    FixPoint1616_t LimitChecksValue[VL53L0X_CHECKENABLE_NUMBER_OF_CHECKS];
+    uint8_t WrapAroundCheckEnable;
+    uint16_t LastEncodedTimeout;
+    uint32_t FinalRangeTimeoutMicroSecs;
+    uint8_t FinalRangeVcselPulsePeriod;
+    uint32_t PreRangeTimeoutMicroSecs;
+    uint8_t PreRangeVcselPulsePeriod;
+} VL53L0X_Profile_t;
+
+/**
+ * Record the profile the device is configured with.
+ */
+VL53L0X_Error VL53L0X_Profile_capture(VL53L0X_DEV Dev, VL53L0X_Profile_t *profile);
+
+/**
+ * Configure the device through the API (VCSEL periods with their phase
+ * calibration, timing budget, limit checks) and record the result.
+ * The device is left in that profile. Compute the profiles again after a
+ * reference calibration.
+ */
+VL53L0X_Error VL53L0X_Profile_compute(VL53L0X_DEV Dev, const VL53L0X_ProfileConfig_t *config,
+                                      VL53L0X_Profile_t *profile);
+
+/**
+ * Switch an idle device to a recorded profile. The writes go out in bus
+ * submissions of up to VL53L0X_SEQUENCE_CHUNK, so writing all registers
+ * (38 writes) takes two.
+ * Only the registers differing from current, the profile the device is in,
+ * are written: NULL writes them all.
+ */
+VL53L0X_Error VL53L0X_Profile_apply(VL53L0X_DEV Dev, const VL53L0X_Profile_t *profile,
+                                    const VL53L0X_Profile_t *current);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+#endif // VL53L0X_PROFILE_H_
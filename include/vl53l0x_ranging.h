@@ -0,0 +1,116 @@
+/*
+ * File : vl53l0x_ranging.h
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#ifndef VL53L0X_RANGING_H_
+#define VL53L0X_RANGING_H_
+
+#include "vl53l0x_api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* interrupt status (0x13) followed by the result block (0x14..0x1F) */
+#define VL53L0X_RESULT_BLOCK_INDEX  VL53L0X_REG_RESULT_INTERRUPT_STATUS
+#define VL53L0X_RESULT_BLOCK_SIZE   13
+
+/**
+ * Decode a result block read at VL53L0X_RESULT_BLOCK_INDEX, same output as
+ * VL53L0X_GetRangingMeasurementData without reading the device again
+ * (except the reference signal when the SIGNAL_REF_CLIP check is enabled).
+ */
+VL53L0X_Error VL53L0X_Ranging_decode(VL53L0X_DEV Dev, const uint8_t *block,
+                                     VL53L0X_RangingMeasurementData_t *pRangingMeasurementData);
+
+/**
+ * Returns 1 if the interrupt status byte of a result block flags a new sample.
+ */
+uint8_t VL53L0X_Ranging_isReady(VL53L0X_DEV Dev, const uint8_t *block);
+
+/**
+ * Optional wait for completion, e.g. on the GPIO1 interrupt line.
+ * Return 0 once the sample is ready, non zero on timeout.
+ */
+typedef int32_t (*VL53L0X_WaitReadyFn)(void *ctx, uint32_t timeout_us);
+
+typedef struct {
+    uint32_t count;
+    uint32_t last_us;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint64_t sum_us;
+} VL53L0X_LatencyStats_t;
+
+/* clear interrupt (2) + stop variable sequence (7) + start (1) */
+#define VL53L0X_SINGLESHOT_START_WRITES 10
+
+/**
+ * On-demand ranging context.
+ * The start is one bus submission, the result is one read of the whole
+ * block, the interrupt is cleared by the next start.
+ */
+typedef struct {
+    VL53L0X_Dev_t *device;
+    uint8_t start_sequence[2 * VL53L0X_SINGLESHOT_START_WRITES];
+    uint32_t predicted_us;
+    uint32_t timeout_us;
+    VL53L0X_WaitReadyFn wait_ready;
+    void *wait_ctx;
+    VL53L0X_LatencyStats_t latency;
+    uint8_t started;            /*!< measurement triggered, result not collected yet */
+    int32_t start_us;           /*!< timer value at the trigger */
+} VL53L0X_SingleShot_t;
+
+/**
+ * Put the device in single ranging mode and prepare the start sequence.
+ * Call again after changing the timing budget.
+ */
+VL53L0X_Error VL53L0X_SingleShot_prepare(VL53L0X_SingleShot_t *ss, VL53L0X_Dev_t *device);
+
+void VL53L0X_SingleShot_setWaitReady(VL53L0X_SingleShot_t *ss, VL53L0X_WaitReadyFn fn, void *ctx);
+
+/**
+ * Trigger one measurement and wait for its result.
+ */
+VL53L0X_Error VL53L0X_SingleShot_measure(VL53L0X_SingleShot_t *ss,
+                                         VL53L0X_RangingMeasurementData_t *pRangingMeasurementData);
+
+/**
+ * Non blocking use: trigger a measurement, no-op while one is in flight.
+ */
+VL53L0X_Error VL53L0X_SingleShot_start(VL53L0X_SingleShot_t *ss);
+
+/**
+ * Read the result block once. *pReady is set once the sample is collected,
+ * the return value is then the one of VL53L0X_SingleShot_measure.
+ * VL53L0X_ERROR_TIME_OUT drops the measurement past the sensor timeout.
+ */
+VL53L0X_Error VL53L0X_SingleShot_poll(VL53L0X_SingleShot_t *ss,
+                                      VL53L0X_RangingMeasurementData_t *pRangingMeasurementData,
+                                      uint8_t *pReady);
+
+/**
+ * Predicted time [us] before the measurement in flight completes, 0 if none.
+ */
+uint32_t VL53L0X_SingleShot_remaining(const VL53L0X_SingleShot_t *ss);
+
+/**
+ * Same as VL53L0X_SingleShot_measure, bounded by a deadline
+ * (absolute esp_timer_get_time, us). A measurement cut by the deadline
+ * stays in flight: the next call collects it instead of triggering again.
+ */
+VL53L0X_Error VL53L0X_SingleShot_measureUntil(VL53L0X_SingleShot_t *ss,
+                                              VL53L0X_RangingMeasurementData_t *pRangingMeasurementData,
+                                              int64_t deadline_us);
+
+void VL53L0X_SingleShot_resetLatency(VL53L0X_SingleShot_t *ss);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+#endif // VL53L0X_RANGING_H_
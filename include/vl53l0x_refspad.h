@@ -0,0 +1,110 @@
+/*
+ * File : vl53l0x_refspad.h
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#ifndef VL53L0X_REFSPAD_H_
+#define VL53L0X_REFSPAD_H_
+
+#include "vl53l0x_api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Reference SPAD search, selected by VL53L0X_Dev_t.RefSpadSearch.
+ */
+typedef enum {
+    VL53L0X_REFSPAD_SEARCH_LINEAR = 0,  /*!< ST: one SPAD and one measurement at a time */
+    VL53L0X_REFSPAD_SEARCH_BISECT,      /*!< galloping then binary search over the candidate SPADs */
+} VL53L0X_RefSpadSearch_t;
+
+/* good SPADs a search may add on top of the minimum */
+#define VL53L0X_REFSPAD_CANDIDATES  48
+
+/**
+ * State of a search over the candidate SPADs, for callers running the
+ * reference measurements themselves (VL53L0X_Pipeline_setup).
+ */
+typedef struct {
+    uint8_t base[6];                    /*!< minimum SPADs */
+    uint8_t map[6];                     /*!< SPADs to measure next */
+    uint32_t candidates[VL53L0X_REFSPAD_CANDIDATES];
+    uint32_t candidateCount;
+    uint8_t endOfMap;                   /*!< no good SPAD after the candidates */
+    uint8_t gallop;                     /*!< 0: one SPAD at a time, as ST */
+    uint32_t low;                       /*!< SPADs added, rate at or below the target */
+    uint32_t high;                      /*!< SPADs added, rate above the target */
+    uint32_t mid;
+    uint32_t step;
+    uint32_t written;                   /*!< SPADs added in the map last measured */
+    uint16_t lowRate;
+    uint16_t highRate;
+} VL53L0X_RefSpadBracket_t;
+
+/**
+ * Reset the SPAD enables and configure the device for the search, as the
+ * start of VL53L0X_PerformRefSpadManagement. The reference calibration follows.
+ */
+VL53L0X_Error VL53L0X_RefSpad_prepare(VL53L0X_DEV Dev);
+
+/**
+ * Enable the minimum reference SPADs of a type from *pCurrentSpadIndex on,
+ * the index is updated past them.
+ */
+VL53L0X_Error VL53L0X_RefSpad_enableMinimum(VL53L0X_DEV Dev, uint8_t needAptSpads,
+                                            uint32_t *pCurrentSpadIndex);
+
+/**
+ * Record the result of the reference SPAD management in the device data.
+ */
+void VL53L0X_RefSpad_record(VL53L0X_DEV Dev, uint32_t refSpadCount, uint8_t isApertureSpads);
+
+/**
+ * Start a search from the minimum SPADs enabled on the device, measured at
+ * peakSignalRateRef.
+ */
+void VL53L0X_RefSpad_bracketBegin(VL53L0X_RefSpadBracket_t *bracket, VL53L0X_DEV Dev,
+                                  uint32_t currentSpadIndex, uint8_t needAptSpads,
+                                  uint16_t peakSignalRateRef, uint8_t gallop);
+
+/**
+ * 1 while a map remains to be measured: bracket->map, to write with its
+ * reference measurement. 0 once the search is done.
+ */
+uint8_t VL53L0X_RefSpad_bracketNext(VL53L0X_RefSpadBracket_t *bracket);
+
+/**
+ * Account the reference signal rate measured with bracket->map.
+ */
+void VL53L0X_RefSpad_bracketAccount(VL53L0X_RefSpadBracket_t *bracket, uint16_t peakSignalRateRef,
+                                    uint16_t targetRefRate);
+
+/**
+ * Pick the SPADs, enable them on the device and return how many were added.
+ */
+VL53L0X_Error VL53L0X_RefSpad_bracketFinish(VL53L0X_RefSpadBracket_t *bracket, VL53L0X_DEV Dev,
+                                            uint16_t targetRefRate, uint32_t *pAdded);
+
+/**
+ * Same procedure and result as VL53L0X_PerformRefSpadManagement, the SPADs
+ * added on top of the minimum are found by a galloping search (1, 2, 4...)
+ * refined by bisection: about 2 log2(n) reference measurements instead of n.
+ * The reference signal rate must grow with the SPAD count, as the linear
+ * search assumes too.
+ */
+VL53L0X_Error VL53L0X_RefSpad_bisect(VL53L0X_DEV Dev, uint32_t *refSpadCount, uint8_t *isApertureSpads);
+
+/**
+ * Reference SPAD management with the search selected for the device.
+ */
+VL53L0X_Error VL53L0X_RefSpad_perform(VL53L0X_DEV Dev, uint32_t *refSpadCount, uint8_t *isApertureSpads);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+#endif // VL53L0X_REFSPAD_H_
@@ -0,0 +1,89 @@
+/*
+ * File : vl53l0x_scheduler.h
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#ifndef VL53L0X_SCHEDULER_H_
+#define VL53L0X_SCHEDULER_H_
+
+#include "vl53l0x_api.h"
+#include "vl53l0x_platform_esp32.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* operations a scheduler holds */
+#define VL53L0X_SCHEDULER_QUEUE     32
+
+typedef enum {
+    VL53L0X_SCHED_READ_BLOCKS = 0,      /*!< VL53L0X_ReadBlocks */
+    VL53L0X_SCHED_WRITE_SEQUENCE,       /*!< VL53L0X_WriteSequence */
+} VL53L0X_SchedKind_t;
+
+/**
+ * One bus operation of a device, owned by the caller until done.
+ */
+typedef struct {
+    VL53L0X_Dev_t *device;
+    VL53L0X_SchedKind_t kind;
+    const VL53L0X_ReadBlock_t *blocks;  /*!< READ_BLOCKS */
+    const uint8_t *pairs;               /*!< WRITE_SEQUENCE */
+    uint32_t count;
+    int64_t deadline_us;                /*!< absolute esp_timer_get_time, 0 : none */
+
+    VL53L0X_Error Status;
+    uint8_t done;
+    uint16_t bypassed;                  /*!< later operations run before this one */
+} VL53L0X_SchedOp_t;
+
+/**
+ * ops : operations run
+ * switches : operations run on another multiplexer channel than the previous one
+ * forced : operations run out of channel order, for fairness or a deadline
+ * late : operations run past their deadline
+ */
+typedef struct {
+    uint32_t ops;
+    uint32_t switches;
+    uint32_t forced;
+    uint32_t late;
+} VL53L0X_SchedStats_t;
+
+/**
+ * Operations waiting for the bus, submitted and dispatched from one task.
+ */
+typedef struct {
+    VL53L0X_SchedOp_t *queue[VL53L0X_SCHEDULER_QUEUE];  /*!< submission order */
+    uint16_t count;
+    uint16_t max_bypass;        /*!< later operations an operation lets go first */
+    uint32_t urgent_us;         /*!< operations this close to their deadline go first */
+    VL53L0X_SchedStats_t stats;
+} VL53L0X_Scheduler_t;
+
+void VL53L0X_Scheduler_init(VL53L0X_Scheduler_t *sched, uint16_t max_bypass, uint32_t urgent_us);
+
+/**
+ * Queue an operation, VL53L0X_ERROR_BUFFER_TOO_SMALL when the queue is full.
+ */
+VL53L0X_Error VL53L0X_Scheduler_submit(VL53L0X_Scheduler_t *sched, VL53L0X_SchedOp_t *op);
+
+/**
+ * Run the queued operations. Operations on the multiplexer channel the bus
+ * is on go first, in submission order, then the oldest operation of another
+ * channel switches it. An operation within urgent_us of its deadline, or
+ * passed over max_bypass times, runs next whatever its channel.
+ * Returns the number of operations run.
+ */
+uint16_t VL53L0X_Scheduler_dispatch(VL53L0X_Scheduler_t *sched);
+
+void VL53L0X_Scheduler_getStats(VL53L0X_Scheduler_t *sched, VL53L0X_SchedStats_t *pstats);
+void VL53L0X_Scheduler_resetStats(VL53L0X_Scheduler_t *sched);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+#endif // VL53L0X_SCHEDULER_H_
@@ -0,0 +1,85 @@
+/*
+ * File : vl53l0x_station.h
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#ifndef VL53L0X_STATION_H_
+#define VL53L0X_STATION_H_
+
+#include "vl53l0x_api.h"
+#include "vl53l0x_calibration.h"
+#include "vl53l0x_pipeline.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* boot time of a sensor released from reset (tBOOT) */
+#define VL53L0X_STATION_BOOT_US     1200
+
+/**
+ * Hold a sensor in reset (XSHUT low, enable 0) or release it (enable 1).
+ * Return 0 on success.
+ */
+typedef int32_t (*VL53L0X_StationEnableFn)(void *ctx, uint8_t enable);
+
+/**
+ * One sensor of a calibration fixture and its calibration report.
+ */
+typedef struct {
+    VL53L0X_Dev_t *device;
+    uint8_t Address;                        /*!< 7 bit address given by VL53L0X_Station_setup, 0 : kept */
+    VL53L0X_StationEnableFn Enable;         /*!< XSHUT of the sensor, NULL : not wired */
+    void *EnableCtx;
+    VL53L0X_Error Status;                   /*!< first error, the unit is skipped afterwards */
+
+    uint32_t RefSpadCount;                  /*!< reference SPAD management */
+    uint8_t IsApertureSpads;
+    uint8_t VhvSettings;                    /*!< reference calibration */
+    uint8_t PhaseCal;
+
+    int32_t OffsetMicroMeter;               /*!< offset calibration */
+    VL53L0X_CalibrationReport_t Offset;
+    FixPoint1616_t XTalkCompensationRateMegaCps; /*!< crosstalk calibration */
+    VL53L0X_CalibrationReport_t XTalk;
+
+    uint32_t ElapsedMicroSeconds;           /*!< time spent in the station calls */
+
+    VL53L0X_PipelineUnit_t setup;           /*!< setup in progress */
+    VL53L0X_Calibration_t cal;              /*!< run in progress */
+} VL53L0X_StationUnit_t;
+
+/**
+ * Bring every unit up (VL53L0X_Device_setup: reference calibration and
+ * reference SPAD management) and record the reference data. The units are
+ * set up side by side, as VL53L0X_Pipeline_setup does.
+ *
+ * Sensors power up at the same address. Units with an Address get it first:
+ * every unit with Enable is held in reset, then they are released one at a
+ * time and moved from CONFIG_VL53L0X_I2C_ADDR to their Address. A unit with
+ * an Address and no Enable must be the only sensor at the default address
+ * when its turn comes. Units with Enable and no Address are released last.
+ * Returns the status of the first failed unit, VL53L0X_ERROR_NONE if none.
+ */
+VL53L0X_Error VL53L0X_Station_setup(VL53L0X_StationUnit_t *units, uint16_t count);
+
+/**
+ * Offset / crosstalk calibration of all units at once, target at distance
+ * (mm). The measurements of the units are interleaved: while one integrates
+ * the bus serves the others. config may be NULL for the defaults.
+ * Units with a non zero Status are skipped.
+ */
+VL53L0X_Error VL53L0X_Station_offset(VL53L0X_StationUnit_t *units, uint16_t count,
+                                     FixPoint1616_t distance,
+                                     const VL53L0X_CalibrationConfig_t *config);
+VL53L0X_Error VL53L0X_Station_xtalk(VL53L0X_StationUnit_t *units, uint16_t count,
+                                    FixPoint1616_t distance,
+                                    const VL53L0X_CalibrationConfig_t *config);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+#endif // VL53L0X_STATION_H_
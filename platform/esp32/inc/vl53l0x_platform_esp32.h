@@ -0,0 +1,258 @@
+/*
+ * File : vl53l0x_platform_esp32.h
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#ifndef VL53L0X_PLATFORM_ESP32_H_
+#define VL53L0X_PLATFORM_ESP32_H_
+
+#include <stdint.h>
+
+#include "vl53l0x_platform.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** register selecting the active register page */
+#define VL53L0X_PAGE_SELECT_INDEX   0xFF
+
+/** register writes per bus submission of VL53L0X_WriteSequence */
+#define VL53L0X_SEQUENCE_CHUNK      32
+
+/**
+ * esp_log of the component sources (TRACE_MODULE_DRIVER), compiled only when
+ * its level passes LOG_LOCAL_LEVEL and the trace filter of
+ * vl53l0x_platform_log.h. esp_log_level_t and TRACE_LEVEL_* share their values.
+ */
+#define VL53L0X_DRIVER_LOG_COMPILED(level) \
+    (LOG_LOCAL_LEVEL >= (level) && \
+        VL53L0X_LOG_COMPILED(TRACE_MODULE_DRIVER, level, TRACE_FUNCTION_NONE))
+
+#define VL53L0X_DRIVER_LOG(level, tag, fmt, ...) \
+    do { \
+        if (VL53L0X_DRIVER_LOG_COMPILED(level)) \
+            ESP_LOG_LEVEL_LOCAL(level, tag, fmt, ##__VA_ARGS__); \
+    } while (0)
+
+/**
+ * Priority of the transfers of a device on an arbitrated bus.
+ */
+#define VL53L0X_BUS_PRIORITY_LOW        (-1)    /*!< bulk transfers : setup, calibration */
+#define VL53L0X_BUS_PRIORITY_NORMAL     0
+#define VL53L0X_BUS_PRIORITY_HIGH       1       /*!< latency critical ranging */
+#define VL53L0X_BUS_PRIORITIES          3
+
+/**
+ * I2C bus usage counters of the esp32 transport.
+ * bytes counts every byte on the wire (address, index and data).
+ * page_writes_elided : page selects dropped because the device already was on that page
+ * page_writes_merged : page selects sent in the same submission as the following access
+ * mux_switches : multiplexer control bytes sent
+ * mux_selects_elided : transfers behind the multiplexer needing no channel switch
+ * arbitration_waits : transfers that waited for another one to release the bus
+ * max_wait_us : longest bus wait, per priority from low to high
+ */
+typedef struct {
+    uint32_t transactions;
+    uint32_t bytes;
+    uint32_t page_writes_elided;
+    uint32_t page_writes_merged;
+    uint32_t mux_switches;
+    uint32_t mux_selects_elided;
+    uint32_t arbitration_waits;
+    uint32_t max_wait_us[VL53L0X_BUS_PRIORITIES];
+} VL53L0X_BusStats_t;
+
+/**
+ * Counters of the default bus.
+ */
+void VL53L0X_get_bus_stats(VL53L0X_BusStats_t *pstats);
+void VL53L0X_reset_bus_stats(void);
+void VL53L0X_count_page_write_elided(VL53L0X_DEV Dev);
+
+/**
+ * Same as VL53L0X_write_multi / VL53L0X_read_multi with
+ * @param   page        page select written in front of the access, in the same bus submission, -1 : none
+ * @param   timeout_us  bus wait, rounded up to a tick, 0 : default (2 s). It covers
+ *                      the wait for the bus and the submission together.
+ */
+int32_t VL53L0X_write_multi_ex(uint8_t address, int16_t page, uint8_t index, uint8_t *pdata, int32_t count, uint32_t timeout_us);
+int32_t VL53L0X_read_multi_ex(uint8_t address, int16_t page, uint8_t index, uint8_t *pdata, int32_t count, uint32_t timeout_us);
+
+/**
+ * Set the absolute time (esp_timer_get_time, us) blocking calls on the
+ * device must return by, 0 : none. Past it every register access and
+ * polling delay fails with VL53L0X_ERROR_TIME_OUT.
+ * @return  the previous deadline, to restore it afterwards
+ */
+int64_t VL53L0X_SetDeadline(VL53L0X_DEV Dev, int64_t deadline_us);
+
+/**
+ * Set the priority of the device transfers, VL53L0X_BUS_PRIORITY_xxx.
+ * @return  the previous priority, to restore it afterwards
+ */
+int8_t VL53L0X_SetBusPriority(VL53L0X_DEV Dev, int8_t priority);
+
+/**
+ * Time left before the deadline, UINT32_MAX without deadline.
+ * @return  VL53L0X_ERROR_TIME_OUT once the deadline has passed
+ */
+VL53L0X_Error VL53L0X_GetRemainingTime(VL53L0X_DEV Dev, uint32_t *premaining_us);
+
+/**
+ * Sleep wait_us, cut short at the deadline.
+ * @return  VL53L0X_ERROR_TIME_OUT if the deadline came first
+ */
+VL53L0X_Error VL53L0X_Sleep(VL53L0X_DEV Dev, uint32_t wait_us);
+
+/**
+ * Forget the cached page of a device, e.g. after a reset or a power cycle.
+ */
+void VL53L0X_InvalidatePage(VL53L0X_DEV Dev);
+
+/**
+ * Write a list of (register, value) pairs as one bus submission,
+ * each register write separated by a repeated start.
+ * VL53L0X_WriteSequence splits longer lists in submissions of
+ * VL53L0X_SEQUENCE_CHUNK writes, letting other transfers in between.
+ * @param   pairs     register index followed by its value, count times
+ * @param   count     number of register writes
+ */
+int32_t VL53L0X_write_sequence(uint8_t address, const uint8_t *pairs, int32_t count);
+int32_t VL53L0X_write_sequence_ex(uint8_t address, int16_t page, const uint8_t *pairs, int32_t count, uint32_t timeout_us);
+VL53L0X_Error VL53L0X_WriteSequence(VL53L0X_DEV Dev, const uint8_t *pairs, uint32_t count);
+
+/**
+ * One register range of a multi block read.
+ */
+typedef struct {
+    uint8_t index;
+    uint8_t count;
+    uint8_t *pdata;
+} VL53L0X_ReadBlock_t;
+
+/**
+ * Read several register ranges as one bus submission,
+ * each range separated by a repeated start.
+ */
+int32_t VL53L0X_read_blocks(uint8_t address, const VL53L0X_ReadBlock_t *blocks, int32_t count);
+int32_t VL53L0X_read_blocks_ex(uint8_t address, int16_t page, const VL53L0X_ReadBlock_t *blocks, int32_t count, uint32_t timeout_us);
+VL53L0X_Error VL53L0X_ReadBlocks(VL53L0X_DEV Dev, const VL53L0X_ReadBlock_t *blocks, uint32_t count);
+
+/**
+ * One register access of VL53L0X_TransferBatch.
+ */
+typedef struct {
+    VL53L0X_DEV device;
+    uint8_t write;              /*!< 1 : write pdata, 0 : read into pdata */
+    uint8_t index;
+    uint8_t count;
+    uint8_t *pdata;
+
+    VL53L0X_Error Status;
+    int16_t page;               /*!< page select sent in front, set by VL53L0X_TransferBatch */
+} VL53L0X_Transfer_t;
+
+/**
+ * Register accesses of several devices, in order. Consecutive transfers on
+ * the same bus go out as one submission of up to VL53L0X_SEQUENCE_CHUNK
+ * transfers, each behind a repeated start. If a submission fails, its reads
+ * that did not go through are retried one by one; its writes are not sent
+ * again, they fail with VL53L0X_ERROR_CONTROL_INTERFACE.
+ * @return  the first failed Status, VL53L0X_ERROR_NONE if none
+ */
+VL53L0X_Error VL53L0X_TransferBatch(VL53L0X_Transfer_t *transfers, uint32_t count);
+
+/**
+ * Transfers of a transport, for the device Dev (Dev->I2cDevAddr, Dev->MuxMask).
+ * Same parameters and return values as the VL53L0X_xxx_ex functions.
+ * batch : the transfers in one submission, on the devices of the bus,
+ *         NULL : VL53L0X_TransferBatch submits them one by one. A transport
+ *         splitting the submission sets the Status of the transfers gone
+ *         through to VL53L0X_ERROR_NONE before failing.
+ */
+typedef struct {
+    int32_t (*write_multi)(VL53L0X_DEV Dev, int16_t page, uint8_t index, uint8_t *pdata, int32_t count, uint32_t timeout_us);
+    int32_t (*read_multi)(VL53L0X_DEV Dev, int16_t page, uint8_t index, uint8_t *pdata, int32_t count, uint32_t timeout_us);
+    int32_t (*write_sequence)(VL53L0X_DEV Dev, int16_t page, const uint8_t *pairs, int32_t count, uint32_t timeout_us);
+    int32_t (*read_blocks)(VL53L0X_DEV Dev, int16_t page, const VL53L0X_ReadBlock_t *blocks, int32_t count, uint32_t timeout_us);
+    int32_t (*batch)(VL53L0X_Bus_t *bus, VL53L0X_Transfer_t *const *transfers, int32_t count, uint32_t timeout_us);
+} VL53L0X_BusOps_t;
+
+/**
+ * Hands the bus to one transfer at a time, the highest priority waiter first.
+ */
+typedef struct {
+    SemaphoreHandle_t lock;                             /*!< guards the fields below, NULL : bus not initialised */
+    SemaphoreHandle_t grant[VL53L0X_BUS_PRIORITIES];    /*!< bus handed over to a waiter of the priority */
+    uint8_t busy;
+    uint16_t waiting[VL53L0X_BUS_PRIORITIES];
+} VL53L0X_BusArbiter_t;
+
+/**
+ * One I2C bus and the devices on it. Devices on different buses are driven
+ * independently, from different tasks if need be.
+ */
+struct VL53L0X_Bus_s {
+    const VL53L0X_BusOps_t *ops;
+    int port;                   /*!< i2c_port_t of the controller, -1 : i2c_mux_write */
+    uint16_t speed_khz;
+    uint8_t mux_address;        /*!< 7 bit address of the channel multiplexer, 0 : none */
+    uint8_t mux_current;        /*!< control byte the multiplexer holds, 0 : unknown */
+    VL53L0X_BusArbiter_t arbiter;   /*!< held from the channel check to the end of the transfer */
+    void *ctx;                  /*!< data of other transports */
+    VL53L0X_BusStats_t stats;
+};
+
+/** transfers through the esp32 I2C driver, the transport of VL53L0X_Bus_init */
+extern const VL53L0X_BusOps_t VL53L0X_Esp32BusOps;
+
+/**
+ * Bus of the devices without one, on i2c_mux_write. It is arbitrated like
+ * the others, its arbiter created once, on its first transfer.
+ */
+VL53L0X_Bus_t *VL53L0X_Bus_default(void);
+
+/**
+ * Bus on an I2C controller, whose driver the application installed.
+ * @param   port        i2c_port_t, -1 : i2c_mux_write
+ * @param   mux_address multiplexer in front of the devices with a MuxMask, 0 : none.
+ *                      Its control byte is written, in the same bus submission,
+ *                      in front of a transfer to a device on another channel.
+ * The bus is arbitrated: a transfer waiting for it goes before the waiting
+ * transfers of lower priority, the device BusPriority. The transfers on a
+ * bus not initialised fail. On VL53L0X_Bus_default() only the port, speed
+ * and multiplexer are set, its arbiter is kept.
+ */
+VL53L0X_Error VL53L0X_Bus_init(VL53L0X_Bus_t *bus, int port, uint16_t speed_khz, uint8_t mux_address);
+
+/**
+ * Hold an arbitrated bus for the transfers of another driver sharing it, at
+ * the given priority. Waits at most timeout_us (rounded up to a tick, 0 : 2 s).
+ * A driver writing to the multiplexer calls VL53L0X_Bus_invalidateMux before
+ * VL53L0X_Bus_release.
+ * @return  VL53L0X_ERROR_TIME_OUT if the bus stayed busy
+ */
+VL53L0X_Error VL53L0X_Bus_acquire(VL53L0X_Bus_t *bus, int8_t priority, uint32_t timeout_us);
+void VL53L0X_Bus_release(VL53L0X_Bus_t *bus);
+
+/**
+ * Forget the multiplexer channel, e.g. after it was reset or another master
+ * used it. The next transfer behind it selects its channel again.
+ */
+void VL53L0X_Bus_invalidateMux(VL53L0X_Bus_t *bus);
+
+void VL53L0X_Bus_getStats(VL53L0X_Bus_t *bus, VL53L0X_BusStats_t *pstats);
+void VL53L0X_Bus_resetStats(VL53L0X_Bus_t *bus);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+#endif // VL53L0X_PLATFORM_ESP32_H_
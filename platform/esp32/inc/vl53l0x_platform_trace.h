@@ -0,0 +1,79 @@
+/*
+ * File : vl53l0x_platform_trace.h
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#ifndef VL53L0X_PLATFORM_TRACE_H_
+#define VL53L0X_PLATFORM_TRACE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Deferred trace, with VL53L0X_LOG_ENABLE and VL53L0X_LOG_DEFERRED defined.
+ *
+ * trace_print_module_function stores the format address, a timestamp and
+ * the raw arguments in a ring instead of printing. The records are
+ * formatted later, by VL53L0X_trace_drain from a low priority task, or on
+ * the host from a VL53L0X_trace_dump with tools/vl53l0x_trace_decode.py.
+ * %s arguments are kept by address: they must be string constants, as the
+ * function names of LOG_FUNCTION_START / LOG_FUNCTION_END.
+ * Any task may record, a single task drains. Once full the ring overwrites
+ * its oldest records.
+ */
+
+/** records in the ring, a power of two */
+#ifndef VL53L0X_TRACE_RECORDS
+#define VL53L0X_TRACE_RECORDS   128
+#endif
+
+/** 32 bit argument words per record, 64 bit arguments take two */
+#define VL53L0X_TRACE_WORDS     8
+
+/** first bytes of a dump */
+#define VL53L0X_TRACE_MAGIC     "VLTR"
+#define VL53L0X_TRACE_VERSION   1
+
+/**
+ * Dump layout : a header, then per record the timestamp (us), the format
+ * address and VL53L0X_TRACE_WORDS argument words, little endian. A record
+ * with a null format counts the records lost before it, in its first word.
+ */
+typedef struct {
+    char magic[4];
+    uint8_t version;
+    uint8_t pointer_size;
+    uint8_t words;
+    uint8_t long_size;
+} VL53L0X_TraceDumpHeader_t;
+
+typedef void (*VL53L0X_TraceWriteFn)(const void *data, size_t size, void *ctx);
+
+/**
+ * Print up to max records (0 : all) with printf.
+ * @return  the number of records taken from the ring
+ */
+uint32_t VL53L0X_trace_drain(uint32_t max);
+
+/**
+ * Hand up to max records (0 : all) to write, header first, in the dump layout.
+ * @return  the number of records taken from the ring
+ */
+uint32_t VL53L0X_trace_dump(VL53L0X_TraceWriteFn write, void *ctx, uint32_t max);
+
+/**
+ * Records overwritten before being taken, since start.
+ */
+uint32_t VL53L0X_trace_dropped(void);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+#endif // VL53L0X_PLATFORM_TRACE_H_
@@ -15,11 +15,13 @@
 
 #include "vl53l0x_i2c_platform.h"
 #include "vl53l0x_platform_log.h"
+#include "vl53l0x_platform_esp32.h"
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "driver/i2c.h"
 #include "driver/gpio.h"
+#include "esp_timer.h"
 
 #include "i2c_mux.h"
 
@@ -34,6 +36,10 @@
 #define ACK_CHECK_EN true
 #define I2C_FLUSH_DELAY (2000 / portTICK_PERIOD_MS)
 
+// bytes on the wire besides data : address + index (+ address for reads)
+#define I2C_WRITE_OVERHEAD  2
+#define I2C_READ_OVERHEAD   3
+
 inline VL53L0X_Error esp_to_vl53l0x_error(esp_err_t esp_err)
 {
     switch (esp_err)
@@ -48,9 +54,300 @@ inline VL53L0X_Error esp_to_vl53l0x_error(esp_err_t esp_err)
     }
 }
 
+static VL53L0X_Bus_t default_bus = {
+    .ops = &VL53L0X_Esp32BusOps,
+    .port = -1,
+    .speed_khz = I2C_MUX_BAUDRATE / 1000,
+};
+
+static portMUX_TYPE default_spinlock = portMUX_INITIALIZER_UNLOCKED;
+
+VL53L0X_Bus_t *VL53L0X_Bus_default(void)
+{
+    return &default_bus;
+}
+
+/*
+ * Bus arbitration
+ *
+ * A transfer holds the bus from the multiplexer check to the end of its
+ * submission. On release the bus goes straight to the highest priority
+ * waiter, so a transfer waits for the one in progress and the waiting ones
+ * of higher priority only: bulk register loads, split in several
+ * submissions, let urgent transfers in between.
+ */
+static uint8_t priority_level(int8_t priority)
+{
+    if (priority < VL53L0X_BUS_PRIORITY_LOW)
+        priority = VL53L0X_BUS_PRIORITY_LOW;
+    if (priority > VL53L0X_BUS_PRIORITY_HIGH)
+        priority = VL53L0X_BUS_PRIORITY_HIGH;
+
+    return (uint8_t)(priority - VL53L0X_BUS_PRIORITY_LOW);
+}
+
+static void arbiter_delete(VL53L0X_BusArbiter_t *arb)
+{
+    int level;
+
+    if (arb->lock != NULL)
+        vSemaphoreDelete(arb->lock);
+    arb->lock = NULL;
+
+    for (level = 0; level < VL53L0X_BUS_PRIORITIES; level++)
+    {
+        if (arb->grant[level] != NULL)
+            vSemaphoreDelete(arb->grant[level]);
+        arb->grant[level] = NULL;
+    }
+}
+
+static VL53L0X_Error arbiter_init(VL53L0X_BusArbiter_t *arb)
+{
+    int level;
+
+    arb->busy = 0;
+    arb->lock = xSemaphoreCreateMutex();
+    for (level = 0; level < VL53L0X_BUS_PRIORITIES; level++)
+    {
+        arb->waiting[level] = 0;
+        arb->grant[level] = xSemaphoreCreateBinary();
+    }
+
+    for (level = 0; level < VL53L0X_BUS_PRIORITIES; level++)
+    {
+        if (arb->lock == NULL || arb->grant[level] == NULL)
+        {
+            arbiter_delete(arb);
+            return VL53L0X_ERROR_UNDEFINED;
+        }
+    }
+
+    return VL53L0X_ERROR_NONE;
+}
+
+// arbiter of the default bus, created on its first transfer. Of the tasks
+// racing for it, one installs its semaphores and the others delete theirs.
+static VL53L0X_Error default_arbiter(void)
+{
+    VL53L0X_BusArbiter_t arb;
+    uint8_t installed = 0;
+
+    portENTER_CRITICAL(&default_spinlock);
+    installed = default_bus.arbiter.lock != NULL;
+    portEXIT_CRITICAL(&default_spinlock);
+    if (installed)
+        return VL53L0X_ERROR_NONE;
+
+    if (arbiter_init(&arb) != VL53L0X_ERROR_NONE)
+        return VL53L0X_ERROR_UNDEFINED;
+
+    portENTER_CRITICAL(&default_spinlock);
+    if (default_bus.arbiter.lock == NULL)
+    {
+        default_bus.arbiter = arb;
+        installed = 1;
+    }
+    portEXIT_CRITICAL(&default_spinlock);
+    if (!installed)
+        arbiter_delete(&arb);
+
+    return VL53L0X_ERROR_NONE;
+}
+
+// *pwait : bus wait of the transfer, the time left of it on return
+static esp_err_t arbiter_take(VL53L0X_Bus_t *bus, int8_t priority, TickType_t *pwait)
+{
+    VL53L0X_BusArbiter_t *arb = &bus->arbiter;
+    uint8_t level = priority_level(priority);
+    TickType_t ticks;
+    int64_t start;
+    uint32_t waited_us;
+
+    if (bus == &default_bus)
+        default_arbiter();
+    // every transfer holds the bus, its counters with it
+    if (arb->lock == NULL)
+        return ESP_ERR_INVALID_STATE;
+
+    xSemaphoreTake(arb->lock, portMAX_DELAY);
+    if (!arb->busy)
+    {
+        arb->busy = 1;
+        xSemaphoreGive(arb->lock);
+        return ESP_OK;
+    }
+    arb->waiting[level]++;
+    xSemaphoreGive(arb->lock);
+
+    start = esp_timer_get_time();
+    ticks = xTaskGetTickCount();
+    if (xSemaphoreTake(arb->grant[level], *pwait) != pdTRUE)
+    {
+        xSemaphoreTake(arb->lock, portMAX_DELAY);
+        // the bus may have been handed over between the timeout and the lock
+        if (xSemaphoreTake(arb->grant[level], 0) != pdTRUE)
+        {
+            arb->waiting[level]--;
+            xSemaphoreGive(arb->lock);
+            return ESP_ERR_TIMEOUT;
+        }
+        xSemaphoreGive(arb->lock);
+    }
+
+    // the submission gets what is left of the wait
+    ticks = xTaskGetTickCount() - ticks;
+    *pwait = ticks < *pwait ? *pwait - ticks : 0;
+
+    // the bus is ours, the counters with it
+    waited_us = (uint32_t)(esp_timer_get_time() - start);
+    bus->stats.arbitration_waits++;
+    if (waited_us > bus->stats.max_wait_us[level])
+        bus->stats.max_wait_us[level] = waited_us;
+
+    return ESP_OK;
+}
+
+static void arbiter_give(VL53L0X_Bus_t *bus)
+{
+    VL53L0X_BusArbiter_t *arb = &bus->arbiter;
+    int level;
+
+    if (arb->lock == NULL)
+        return;
+
+    xSemaphoreTake(arb->lock, portMAX_DELAY);
+    for (level = VL53L0X_BUS_PRIORITIES - 1; level >= 0; level--)
+    {
+        if (arb->waiting[level] > 0)
+        {
+            // still busy, now for the waiter
+            arb->waiting[level]--;
+            xSemaphoreGive(arb->grant[level]);
+            xSemaphoreGive(arb->lock);
+            return;
+        }
+    }
+    arb->busy = 0;
+    xSemaphoreGive(arb->lock);
+}
+
+void VL53L0X_Bus_invalidateMux(VL53L0X_Bus_t *bus)
+{
+    bus->mux_current = 0;
+}
+
+/*
+ * The transfers update the counters holding the bus, the elided page writes
+ * holding the arbiter lock: reading or clearing them takes both.
+ */
+static uint8_t stats_lock(VL53L0X_Bus_t *bus)
+{
+    TickType_t wait = portMAX_DELAY;
+
+    if (arbiter_take(bus, VL53L0X_BUS_PRIORITY_HIGH, &wait) != ESP_OK)
+        return 0;
+
+    xSemaphoreTake(bus->arbiter.lock, portMAX_DELAY);
+    return 1;
+}
+
+static void stats_unlock(VL53L0X_Bus_t *bus, uint8_t locked)
+{
+    if (!locked)
+        return;
+
+    xSemaphoreGive(bus->arbiter.lock);
+    arbiter_give(bus);
+}
+
+void VL53L0X_Bus_getStats(VL53L0X_Bus_t *bus, VL53L0X_BusStats_t *pstats)
+{
+    uint8_t locked = stats_lock(bus);
+
+    *pstats = bus->stats;
+    stats_unlock(bus, locked);
+}
+
+static void reset_stats(VL53L0X_Bus_t *bus)
+{
+    bus->stats.transactions = 0;
+    bus->stats.bytes = 0;
+    bus->stats.page_writes_elided = 0;
+    bus->stats.page_writes_merged = 0;
+    bus->stats.mux_switches = 0;
+    bus->stats.mux_selects_elided = 0;
+    bus->stats.arbitration_waits = 0;
+    for (int i = 0; i < VL53L0X_BUS_PRIORITIES; i++)
+        bus->stats.max_wait_us[i] = 0;
+}
+
+void VL53L0X_Bus_resetStats(VL53L0X_Bus_t *bus)
+{
+    uint8_t locked = stats_lock(bus);
+
+    reset_stats(bus);
+    stats_unlock(bus, locked);
+}
+
+VL53L0X_Error VL53L0X_Bus_init(VL53L0X_Bus_t *bus, int port, uint16_t speed_khz, uint8_t mux_address)
+{
+    if (port >= I2C_NUM_MAX)
+        return VL53L0X_ERROR_INVALID_PARAMS;
+
+    // the default bus keeps the arbiter its devices may be waiting on
+    if (bus == &default_bus)
+    {
+        bus->port = port;
+        bus->speed_khz = speed_khz;
+        bus->mux_address = mux_address;
+        bus->mux_current = 0;
+        return default_arbiter();
+    }
+
+    bus->ops = &VL53L0X_Esp32BusOps;
+    bus->port = port;
+    bus->speed_khz = speed_khz;
+    bus->mux_address = mux_address;
+    bus->mux_current = 0;
+    bus->ctx = NULL;
+    reset_stats(bus);
+
+    return arbiter_init(&bus->arbiter);
+}
+
+static VL53L0X_Bus_t *dev_bus(VL53L0X_DEV Dev)
+{
+    return Dev->Bus != NULL ? Dev->Bus : &default_bus;
+}
+
+void VL53L0X_get_bus_stats(VL53L0X_BusStats_t *pstats)
+{
+    VL53L0X_Bus_getStats(&default_bus, pstats);
+}
+
+void VL53L0X_reset_bus_stats(void)
+{
+    VL53L0X_Bus_resetStats(&default_bus);
+}
+
+void VL53L0X_count_page_write_elided(VL53L0X_DEV Dev)
+{
+    VL53L0X_Bus_t *bus = dev_bus(Dev);
+
+    if (bus->arbiter.lock == NULL)
+        return;
+
+    xSemaphoreTake(bus->arbiter.lock, portMAX_DELAY);
+    bus->stats.page_writes_elided++;
+    xSemaphoreGive(bus->arbiter.lock);
+}
+
 int32_t VL53L0X_comms_initialise(uint8_t  comms_type,
                                           uint16_t comms_speed_khz)
 {
+    // the application installs the driver behind i2c_mux_write
+    default_bus.speed_khz = comms_speed_khz;
     return VL53L0X_ERROR_NONE;
 }
 
@@ -68,10 +365,115 @@ int32_t VL53L0X_cycle_power(void)
     return status;
 }
 
-int32_t VL53L0X_write_multi(uint8_t address, uint8_t index, uint8_t *pdata, int32_t count)
+// bus wait of a transfer, rounded up to a tick, never above I2C_FLUSH_DELAY
+static TickType_t bus_wait(uint32_t timeout_us)
+{
+    uint32_t tick_us = portTICK_PERIOD_MS * 1000;
+    TickType_t wait;
+
+    if (timeout_us == 0)
+        return I2C_FLUSH_DELAY;
+
+    wait = timeout_us / tick_us + (timeout_us % tick_us != 0);
+    return wait < I2C_FLUSH_DELAY ? wait : I2C_FLUSH_DELAY;
+}
+
+VL53L0X_Error VL53L0X_Bus_acquire(VL53L0X_Bus_t *bus, int8_t priority, uint32_t timeout_us)
+{
+    TickType_t wait = bus_wait(timeout_us);
+
+    return esp_to_vl53l0x_error(arbiter_take(bus, priority, &wait));
+}
+
+void VL53L0X_Bus_release(VL53L0X_Bus_t *bus)
+{
+    arbiter_give(bus);
+}
+
+// multiplexer control byte in front of the transfer, for a device behind it on
+// another channel than the current one
+static void append_mux_select(i2c_cmd_handle_t cmd, VL53L0X_Bus_t *bus, uint8_t mux)
+{
+    if (mux == 0 || bus->mux_address == 0)
+        return;
+
+    if (bus->mux_current == mux)
+    {
+        bus->stats.mux_selects_elided++;
+        return;
+    }
+
+    ESP_ERROR_CHECK(i2c_master_start(cmd));
+    ESP_ERROR_CHECK(i2c_master_write_byte(cmd, (bus->mux_address << 1) | I2C_MASTER_WRITE, ACK_CHECK_EN));
+    ESP_ERROR_CHECK(i2c_master_write_byte(cmd, mux, ACK_CHECK_EN));
+
+    bus->stats.bytes += 2;
+    bus->stats.mux_switches++;
+}
+
+// prepend a 0xFF page select write, separated by a repeated start
+static void append_page_select(i2c_cmd_handle_t cmd, VL53L0X_Bus_t *bus, uint8_t address, uint8_t page)
+{
+    ESP_ERROR_CHECK(i2c_master_start(cmd));
+    ESP_ERROR_CHECK(i2c_master_write_byte(cmd, (address << 1) | I2C_MASTER_WRITE, ACK_CHECK_EN));
+    ESP_ERROR_CHECK(i2c_master_write_byte(cmd, VL53L0X_PAGE_SELECT_INDEX, ACK_CHECK_EN));
+    ESP_ERROR_CHECK(i2c_master_write_byte(cmd, page, ACK_CHECK_EN));
+
+    bus->stats.bytes += I2C_WRITE_OVERHEAD + 1;
+    bus->stats.page_writes_merged++;
+}
+
+// take the bus, then start the command link with the channel and page selects.
+// *pwait is left with the wait of the submission, *pstart with the bus bytes
+// before the transfer.
+static esp_err_t begin(VL53L0X_Bus_t *bus, int8_t priority, uint8_t address, uint8_t mux, int16_t page,
+                       TickType_t *pwait, uint32_t *pstart, i2c_cmd_handle_t *pcmd)
+{
+    esp_err_t err = arbiter_take(bus, priority, pwait);
+
+    if (err != ESP_OK)
+        return err;
+
+    *pstart = bus->stats.bytes;
+    *pcmd = i2c_cmd_link_create();
+    append_mux_select(*pcmd, bus, mux);
+    if (page >= 0)
+        append_page_select(*pcmd, bus, address, (uint8_t)page);
+
+    return ESP_OK;
+}
+
+// pbytes : byte counter of the device, NULL : none. Updated with the bus held,
+// it only counts the transfers of its device.
+static esp_err_t submit(VL53L0X_Bus_t *bus, uint8_t mux, i2c_cmd_handle_t cmd, TickType_t wait,
+                        uint32_t start, uint32_t *pbytes)
+{
+    esp_err_t err;
+
+    if (pbytes != NULL)
+        *pbytes += bus->stats.bytes - start;
+
+    ESP_ERROR_CHECK(i2c_master_stop(cmd));
+    if (bus->port < 0)
+        err = i2c_mux_write(cmd, wait);
+    else
+        err = i2c_master_cmd_begin((i2c_port_t)bus->port, cmd, wait);
+    i2c_cmd_link_delete(cmd);
+
+    bus->stats.transactions++;
+
+    // a failed transfer may have stopped before the control byte
+    if (mux != 0 && bus->mux_address != 0)
+        bus->mux_current = (err == ESP_OK) ? mux : 0;
+
+    arbiter_give(bus);
+
+    return err;
+}
+
+static void append_write(i2c_cmd_handle_t cmd, VL53L0X_Bus_t *bus, uint8_t address,
+                         uint8_t index, const uint8_t *pdata, int32_t count)
 {
-    int32_t status = STATUS_OK;
-    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
     ESP_ERROR_CHECK(i2c_master_start(cmd));
 
     // write I2C address
@@ -88,20 +490,12 @@ int32_t VL53L0X_write_multi(uint8_t address, uint8_t index, uint8_t *pdata, int3
         ESP_ERROR_CHECK(i2c_master_write_byte(cmd, *(pdata + i), ACK_CHECK_EN));
     }
 
-    ESP_ERROR_CHECK(i2c_master_stop(cmd));
-    esp_err_t err = i2c_mux_write(cmd, I2C_FLUSH_DELAY);
-    i2c_cmd_link_delete(cmd);
-
-    return esp_to_vl53l0x_error(err);
+    bus->stats.bytes += I2C_WRITE_OVERHEAD + count;
 }
 
-int32_t VL53L0X_read_multi(uint8_t address, uint8_t index, uint8_t *pdata, int32_t count)
+static void append_read(i2c_cmd_handle_t cmd, VL53L0X_Bus_t *bus, uint8_t address,
+                        uint8_t index, uint8_t *pdata, int32_t count)
 {
-    int32_t status = STATUS_OK;
-
-    // I2C write
-    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-
     ////// First tell the VL53L0X which register we are reading from
     ESP_ERROR_CHECK(i2c_master_start(cmd));
 
@@ -119,13 +513,213 @@ int32_t VL53L0X_read_multi(uint8_t address, uint8_t index, uint8_t *pdata, int32
     // Read data from register
     ESP_ERROR_CHECK(i2c_master_read(cmd, pdata, count, I2C_MASTER_LAST_NACK));
 
-    ESP_ERROR_CHECK(i2c_master_stop(cmd));
-    esp_err_t err = i2c_mux_write(cmd, I2C_FLUSH_DELAY);
-    i2c_cmd_link_delete(cmd);
+    bus->stats.bytes += I2C_READ_OVERHEAD + count;
+}
+
+static int32_t write_multi(VL53L0X_Bus_t *bus, int8_t priority, uint8_t address, uint8_t mux, int16_t page,
+                           uint8_t index, uint8_t *pdata, int32_t count, TickType_t wait, uint32_t *pbytes)
+{
+    i2c_cmd_handle_t cmd;
+    uint32_t start;
+    esp_err_t err = begin(bus, priority, address, mux, page, &wait, &start, &cmd);
+
+    if (err != ESP_OK)
+        return esp_to_vl53l0x_error(err);
+
+    append_write(cmd, bus, address, index, pdata, count);
+
+    return esp_to_vl53l0x_error(submit(bus, mux, cmd, wait, start, pbytes));
+}
+
+static int32_t read_multi(VL53L0X_Bus_t *bus, int8_t priority, uint8_t address, uint8_t mux, int16_t page,
+                          uint8_t index, uint8_t *pdata, int32_t count, TickType_t wait, uint32_t *pbytes)
+{
+    i2c_cmd_handle_t cmd;
+    uint32_t start;
+    esp_err_t err = begin(bus, priority, address, mux, page, &wait, &start, &cmd);
+
+    if (err != ESP_OK)
+        return esp_to_vl53l0x_error(err);
+
+    append_read(cmd, bus, address, index, pdata, count);
+
+    return esp_to_vl53l0x_error(submit(bus, mux, cmd, wait, start, pbytes));
+}
+
+int32_t VL53L0X_write_multi(uint8_t address, uint8_t index, uint8_t *pdata, int32_t count)
+{
+    return write_multi(&default_bus, VL53L0X_BUS_PRIORITY_NORMAL, address, 0, -1, index, pdata, count, I2C_FLUSH_DELAY, NULL);
+}
+
+int32_t VL53L0X_read_multi(uint8_t address, uint8_t index, uint8_t *pdata, int32_t count)
+{
+    return read_multi(&default_bus, VL53L0X_BUS_PRIORITY_NORMAL, address, 0, -1, index, pdata, count, I2C_FLUSH_DELAY, NULL);
+}
+
+int32_t VL53L0X_write_multi_ex(uint8_t address, int16_t page, uint8_t index, uint8_t *pdata, int32_t count, uint32_t timeout_us)
+{
+    return write_multi(&default_bus, VL53L0X_BUS_PRIORITY_NORMAL, address, 0, page, index, pdata, count, bus_wait(timeout_us), NULL);
+}
+
+int32_t VL53L0X_read_multi_ex(uint8_t address, int16_t page, uint8_t index, uint8_t *pdata, int32_t count, uint32_t timeout_us)
+{
+    return read_multi(&default_bus, VL53L0X_BUS_PRIORITY_NORMAL, address, 0, page, index, pdata, count, bus_wait(timeout_us), NULL);
+}
+
+static int32_t write_sequence(VL53L0X_Bus_t *bus, int8_t priority, uint8_t address, uint8_t mux, int16_t page,
+                              const uint8_t *pairs, int32_t count, TickType_t wait, uint32_t *pbytes)
+{
+    i2c_cmd_handle_t cmd;
+    uint32_t start;
+    esp_err_t err = begin(bus, priority, address, mux, page, &wait, &start, &cmd);
+
+    if (err != ESP_OK)
+        return esp_to_vl53l0x_error(err);
 
-    return esp_to_vl53l0x_error(err);
+    // one command link, a repeated start before each register write
+    for (int i = 0; i < count; i++)
+    {
+        ESP_ERROR_CHECK(i2c_master_start(cmd));
+        ESP_ERROR_CHECK(i2c_master_write_byte(cmd, (address << 1) | I2C_MASTER_WRITE, ACK_CHECK_EN));
+        ESP_ERROR_CHECK(i2c_master_write_byte(cmd, pairs[2 * i], ACK_CHECK_EN));
+        ESP_ERROR_CHECK(i2c_master_write_byte(cmd, pairs[2 * i + 1], ACK_CHECK_EN));
+    }
+
+    bus->stats.bytes += (I2C_WRITE_OVERHEAD + 1) * count;
+
+    return esp_to_vl53l0x_error(submit(bus, mux, cmd, wait, start, pbytes));
+}
+
+int32_t VL53L0X_write_sequence(uint8_t address, const uint8_t *pairs, int32_t count)
+{
+    return write_sequence(&default_bus, VL53L0X_BUS_PRIORITY_NORMAL, address, 0, -1, pairs, count, I2C_FLUSH_DELAY, NULL);
 }
 
+int32_t VL53L0X_write_sequence_ex(uint8_t address, int16_t page, const uint8_t *pairs, int32_t count, uint32_t timeout_us)
+{
+    return write_sequence(&default_bus, VL53L0X_BUS_PRIORITY_NORMAL, address, 0, page, pairs, count, bus_wait(timeout_us), NULL);
+}
+
+static int32_t read_blocks(VL53L0X_Bus_t *bus, int8_t priority, uint8_t address, uint8_t mux, int16_t page,
+                           const VL53L0X_ReadBlock_t *blocks, int32_t count, TickType_t wait, uint32_t *pbytes)
+{
+    i2c_cmd_handle_t cmd;
+    uint32_t start;
+    esp_err_t err = begin(bus, priority, address, mux, page, &wait, &start, &cmd);
+
+    if (err != ESP_OK)
+        return esp_to_vl53l0x_error(err);
+
+    // one command link, index write and data read of each block behind a repeated start
+    for (int i = 0; i < count; i++)
+    {
+        ESP_ERROR_CHECK(i2c_master_start(cmd));
+        ESP_ERROR_CHECK(i2c_master_write_byte(cmd, (address << 1) | I2C_MASTER_WRITE, ACK_CHECK_EN));
+        ESP_ERROR_CHECK(i2c_master_write_byte(cmd, blocks[i].index, ACK_CHECK_EN));
+
+        ESP_ERROR_CHECK(i2c_master_start(cmd));
+        ESP_ERROR_CHECK(i2c_master_write_byte(cmd, (address << 1) | I2C_MASTER_READ, ACK_CHECK_EN));
+        ESP_ERROR_CHECK(i2c_master_read(cmd, blocks[i].pdata, blocks[i].count, I2C_MASTER_LAST_NACK));
+
+        bus->stats.bytes += I2C_READ_OVERHEAD + blocks[i].count;
+    }
+
+    return esp_to_vl53l0x_error(submit(bus, mux, cmd, wait, start, pbytes));
+}
+
+int32_t VL53L0X_read_blocks(uint8_t address, const VL53L0X_ReadBlock_t *blocks, int32_t count)
+{
+    return read_blocks(&default_bus, VL53L0X_BUS_PRIORITY_NORMAL, address, 0, -1, blocks, count, I2C_FLUSH_DELAY, NULL);
+}
+
+int32_t VL53L0X_read_blocks_ex(uint8_t address, int16_t page, const VL53L0X_ReadBlock_t *blocks, int32_t count, uint32_t timeout_us)
+{
+    return read_blocks(&default_bus, VL53L0X_BUS_PRIORITY_NORMAL, address, 0, page, blocks, count, bus_wait(timeout_us), NULL);
+}
+
+/*
+ * esp32 transport of a device : its bus, address and multiplexer channel
+ */
+static int32_t esp32_write_multi(VL53L0X_DEV Dev, int16_t page, uint8_t index, uint8_t *pdata, int32_t count, uint32_t timeout_us)
+{
+    return write_multi(dev_bus(Dev), Dev->BusPriority, Dev->I2cDevAddr, Dev->MuxMask, page, index, pdata, count, bus_wait(timeout_us), &Dev->BusBytes);
+}
+
+static int32_t esp32_read_multi(VL53L0X_DEV Dev, int16_t page, uint8_t index, uint8_t *pdata, int32_t count, uint32_t timeout_us)
+{
+    return read_multi(dev_bus(Dev), Dev->BusPriority, Dev->I2cDevAddr, Dev->MuxMask, page, index, pdata, count, bus_wait(timeout_us), &Dev->BusBytes);
+}
+
+static int32_t esp32_write_sequence(VL53L0X_DEV Dev, int16_t page, const uint8_t *pairs, int32_t count, uint32_t timeout_us)
+{
+    return write_sequence(dev_bus(Dev), Dev->BusPriority, Dev->I2cDevAddr, Dev->MuxMask, page, pairs, count, bus_wait(timeout_us), &Dev->BusBytes);
+}
+
+static int32_t esp32_read_blocks(VL53L0X_DEV Dev, int16_t page, const VL53L0X_ReadBlock_t *blocks, int32_t count, uint32_t timeout_us)
+{
+    return read_blocks(dev_bus(Dev), Dev->BusPriority, Dev->I2cDevAddr, Dev->MuxMask, page, blocks, count, bus_wait(timeout_us), &Dev->BusBytes);
+}
+
+// transfers of several devices of the bus in one command link, each one
+// behind the channel and page selects it needs
+static int32_t esp32_batch(VL53L0X_Bus_t *bus, VL53L0X_Transfer_t *const *transfers, int32_t count, uint32_t timeout_us)
+{
+    VL53L0X_Transfer_t *t;
+    i2c_cmd_handle_t cmd;
+    TickType_t wait = bus_wait(timeout_us);
+    int8_t priority = VL53L0X_BUS_PRIORITY_LOW;
+    uint32_t start;
+    uint8_t mux = 0;
+    esp_err_t err;
+    int i;
+
+    for (i = 0; i < count; i++)
+    {
+        if (transfers[i]->device->BusPriority > priority)
+            priority = transfers[i]->device->BusPriority;
+    }
+
+    err = arbiter_take(bus, priority, &wait);
+    if (err != ESP_OK)
+        return esp_to_vl53l0x_error(err);
+
+    cmd = i2c_cmd_link_create();
+    for (i = 0; i < count; i++)
+    {
+        t = transfers[i];
+        start = bus->stats.bytes;
+
+        append_mux_select(cmd, bus, t->device->MuxMask);
+        if (t->device->MuxMask != 0 && bus->mux_address != 0)
+        {
+            // on that channel for the transfers behind this one
+            mux = t->device->MuxMask;
+            bus->mux_current = mux;
+        }
+
+        if (t->page >= 0)
+            append_page_select(cmd, bus, t->device->I2cDevAddr, (uint8_t)t->page);
+
+        if (t->write)
+            append_write(cmd, bus, t->device->I2cDevAddr, t->index, t->pdata, t->count);
+        else
+            append_read(cmd, bus, t->device->I2cDevAddr, t->index, t->pdata, t->count);
+
+        // the bus is held: the counter of the device is ours
+        t->device->BusBytes += bus->stats.bytes - start;
+    }
+
+    return esp_to_vl53l0x_error(submit(bus, mux, cmd, wait, 0, NULL));
+}
+
+const VL53L0X_BusOps_t VL53L0X_Esp32BusOps = {
+    .write_multi = esp32_write_multi,
+    .read_multi = esp32_read_multi,
+    .write_sequence = esp32_write_sequence,
+    .read_blocks = esp32_read_blocks,
+    .batch = esp32_batch,
+};
+
 int32_t VL53L0X_write_byte(uint8_t address, uint8_t index, uint8_t data)
 {
     int32_t status = STATUS_OK;
@@ -255,12 +849,13 @@ int32_t VL53L0X_release_gpio(void)
 
 int32_t VL53L0X_get_timer_frequency(int32_t *ptimer_freq_hz)
 {
-    *ptimer_freq_hz = 0;
+    *ptimer_freq_hz = 1000000;
     return STATUS_OK;
 }
 
 int32_t VL53L0X_get_timer_value(int32_t *ptimer_count)
 {
-    *ptimer_count = 0;
+    // microseconds, wraps around
+    *ptimer_count = (int32_t)esp_timer_get_time();
     return STATUS_OK;
 }
@@ -37,14 +37,20 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "vl53l0x_platform.h"
 #include "vl53l0x_i2c_platform.h"
 #include "vl53l0x_api.h"
+#include "vl53l0x_platform_esp32.h"
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "esp_timer.h"
 
 #define LOG_FUNCTION_START(fmt, ... )           _LOG_FUNCTION_START(TRACE_MODULE_PLATFORM, fmt, ##__VA_ARGS__)
 #define LOG_FUNCTION_END(status, ... )          _LOG_FUNCTION_END(TRACE_MODULE_PLATFORM, status, ##__VA_ARGS__)
 #define LOG_FUNCTION_END_FMT(status, fmt, ... ) _LOG_FUNCTION_END_FMT(TRACE_MODULE_PLATFORM, status, fmt, ##__VA_ARGS__)
 
+#ifdef VL53L0X_LOG_ENABLE
+#define trace_print(level, ...) trace_print_module_function(TRACE_MODULE_PLATFORM, level, TRACE_FUNCTION_NONE, ##__VA_ARGS__)
+#endif
+
 /**
  * @def I2C_BUFFER_CONFIG
  *
@@ -86,6 +92,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #endif
 
 
+/** polling delay of the API wait loops */
+#define VL53L0X_POLLING_DELAY_US    10000
+
 #define VL53L0X_I2C_USER_VAR         /* none but could be for a flag var to get/pass to mutex interruptible  return flags and try again */
 #define VL53L0X_GetI2CAccess(Dev)    /* todo mutex acquire */
 #define VL53L0X_DoneI2CAcces(Dev)    /* todo mutex release */
@@ -103,165 +112,465 @@ VL53L0X_Error VL53L0X_UnlockSequenceAccess(VL53L0X_DEV Dev){
     return Status;
 }
 
-// the ranging_sensor_comms.dll will take care of the page selection
-VL53L0X_Error VL53L0X_WriteMulti(VL53L0X_DEV Dev, uint8_t index, uint8_t *pdata, uint32_t count){
+/*
+ * Deadline
+ *
+ * With a deadline set, register accesses past it fail with
+ * VL53L0X_ERROR_TIME_OUT without touching the bus, and the bus wait of each
+ * transfer as well as the polling delay are cut to the time left.
+ */
+int64_t VL53L0X_SetDeadline(VL53L0X_DEV Dev, int64_t deadline_us)
+{
+    int64_t previous = Dev->Deadline;
 
-    VL53L0X_Error Status = VL53L0X_ERROR_NONE;
-    int32_t status_int = 0;
-	uint8_t deviceAddress;
+    Dev->Deadline = deadline_us;
+    return previous;
+}
 
-    if (count>=VL53L0X_MAX_I2C_XFER_SIZE){
-        Status = VL53L0X_ERROR_INVALID_PARAMS;
+int8_t VL53L0X_SetBusPriority(VL53L0X_DEV Dev, int8_t priority)
+{
+    int8_t previous = Dev->BusPriority;
+
+    Dev->BusPriority = priority;
+    return previous;
+}
+
+VL53L0X_Error VL53L0X_GetRemainingTime(VL53L0X_DEV Dev, uint32_t *premaining_us)
+{
+    int64_t left;
+
+    if (Dev->Deadline == 0) {
+        *premaining_us = UINT32_MAX;
+        return VL53L0X_ERROR_NONE;
+    }
+
+    left = Dev->Deadline - esp_timer_get_time();
+    if (left <= 0) {
+        *premaining_us = 0;
+        return VL53L0X_ERROR_TIME_OUT;
     }
 
-	deviceAddress = Dev->I2cDevAddr;
+    *premaining_us = left > UINT32_MAX ? UINT32_MAX : (uint32_t)left;
+    return VL53L0X_ERROR_NONE;
+}
 
-	status_int = VL53L0X_write_multi(deviceAddress, index, pdata, count);
+VL53L0X_Error VL53L0X_Sleep(VL53L0X_DEV Dev, uint32_t wait_us)
+{
+    VL53L0X_Error Status;
+    uint32_t remaining_us;
+    uint32_t tick_us = portTICK_PERIOD_MS * 1000;
 
-	if (status_int != 0)
-		Status = VL53L0X_ERROR_CONTROL_INTERFACE;
+    Status = VL53L0X_GetRemainingTime(Dev, &remaining_us);
+    if (Status != VL53L0X_ERROR_NONE)
+        return Status;
+
+    if (remaining_us < wait_us) {
+        wait_us = remaining_us;
+        Status = VL53L0X_ERROR_TIME_OUT;
+    }
+
+    // less than a tick left : spin rather than oversleep
+    if (wait_us >= tick_us)
+        vTaskDelay(wait_us / tick_us);
+    else
+        VL53L0X_platform_wait_us(wait_us);
 
     return Status;
 }
 
-// the ranging_sensor_comms.dll will take care of the page selection
-VL53L0X_Error VL53L0X_ReadMulti(VL53L0X_DEV Dev, uint8_t index, uint8_t *pdata, uint32_t count){
-    VL53L0X_I2C_USER_VAR
-    VL53L0X_Error Status = VL53L0X_ERROR_NONE;
-    int32_t status_int;
-	uint8_t deviceAddress;
+/*
+ * Page select (0xFF) handling
+ *
+ * A page select write is not sent right away: it stays pending in the device
+ * handle and goes out in the same bus submission as the next register access.
+ * A page select to the page the device already is on, or one overwritten by
+ * another page select before any access, is dropped.
+ */
+void VL53L0X_InvalidatePage(VL53L0X_DEV Dev)
+{
+    Dev->PageFlags = 0;
+}
 
-    if (count>=VL53L0X_MAX_I2C_XFER_SIZE){
-        Status = VL53L0X_ERROR_INVALID_PARAMS;
+static VL53L0X_Error select_page(VL53L0X_DEV Dev, uint8_t page)
+{
+    // a pending page never reached the device
+    if (Dev->PageFlags & VL53L0X_PAGE_PENDING)
+        VL53L0X_count_page_write_elided(Dev);
+
+    if ((Dev->PageFlags & VL53L0X_PAGE_KNOWN) && Dev->PageCurrent == page) {
+        Dev->PageFlags &= ~VL53L0X_PAGE_PENDING;
+        VL53L0X_count_page_write_elided(Dev);
+    } else {
+        Dev->PagePending = page;
+        Dev->PageFlags |= VL53L0X_PAGE_PENDING;
     }
 
-    deviceAddress = Dev->I2cDevAddr;
+    return VL53L0X_ERROR_NONE;
+}
 
-	status_int = VL53L0X_read_multi(deviceAddress, index, pdata, count);
+static VL53L0X_Bus_t *dev_bus(VL53L0X_DEV Dev)
+{
+    return Dev->Bus != NULL ? Dev->Bus : VL53L0X_Bus_default();
+}
 
-	if (status_int != 0)
-		Status = VL53L0X_ERROR_CONTROL_INTERFACE;
+static const VL53L0X_BusOps_t *bus_ops(VL53L0X_DEV Dev)
+{
+    return dev_bus(Dev)->ops;
+}
 
-    return Status;
+static int16_t pending_page(VL53L0X_DEV Dev)
+{
+    return (Dev->PageFlags & VL53L0X_PAGE_PENDING) ? Dev->PagePending : -1;
 }
 
+// page tracking and status of a finished transfer
+static VL53L0X_Error bus_end(VL53L0X_DEV Dev, int32_t status_int)
+{
+    if (status_int != 0) {
+        Dev->PageFlags = 0;
+    } else if (Dev->PageFlags & VL53L0X_PAGE_PENDING) {
+        Dev->PageCurrent = Dev->PagePending;
+        Dev->PageFlags = VL53L0X_PAGE_KNOWN;
+    }
 
-VL53L0X_Error VL53L0X_WrByte(VL53L0X_DEV Dev, uint8_t index, uint8_t data){
-    VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+    if (status_int == 0)
+        return VL53L0X_ERROR_NONE;
+    if (status_int == VL53L0X_ERROR_TIME_OUT && Dev->Deadline != 0)
+        return VL53L0X_ERROR_TIME_OUT;
+    return VL53L0X_ERROR_CONTROL_INTERFACE;
+}
+
+// device state after a register write
+static void write_done(VL53L0X_DEV Dev, uint8_t index, uint32_t count)
+{
+    // device back on page 0 after a soft reset, or page written as part of a block
+    if (index == VL53L0X_REG_SOFT_RESET_GO2_SOFT_RESET_N ||
+        (uint32_t)index + count > VL53L0X_PAGE_SELECT_INDEX)
+        VL53L0X_InvalidatePage(Dev);
+
+    // a reset drops the interrupt threshold settings
+    if (index == VL53L0X_REG_SOFT_RESET_GO2_SOFT_RESET_N)
+        Dev->InterruptSettings = VL53L0X_INTERRUPT_SETTINGS_UNKNOWN;
+}
+
+static VL53L0X_Error dev_write(VL53L0X_DEV Dev, uint8_t index, uint8_t *pdata, uint32_t count){
+    VL53L0X_Error Status;
     int32_t status_int;
-	uint8_t deviceAddress;
+    uint32_t timeout_us;
 
-    deviceAddress = Dev->I2cDevAddr;
+    if (index == VL53L0X_PAGE_SELECT_INDEX && count == 1)
+        return select_page(Dev, *pdata);
 
-	status_int = VL53L0X_write_byte(deviceAddress, index, data);
+    // the time left is the bus wait of the transfer
+    Status = VL53L0X_GetRemainingTime(Dev, &timeout_us);
+    if (Status != VL53L0X_ERROR_NONE)
+        return Status;
 
-	if (status_int != 0)
-		Status = VL53L0X_ERROR_CONTROL_INTERFACE;
+#ifdef VL53L0X_LOG_ENABLE
+    if (count == 1)
+        trace_print(TRACE_LEVEL_INFO, "Write reg : 0x%02X, Val : 0x%02X\n", index, *pdata);
+#endif
+
+    status_int = bus_ops(Dev)->write_multi(Dev, pending_page(Dev), index, pdata, count, timeout_us);
+    Status = bus_end(Dev, status_int);
+    write_done(Dev, index, count);
 
     return Status;
 }
 
-VL53L0X_Error VL53L0X_WrWord(VL53L0X_DEV Dev, uint8_t index, uint16_t data){
-    VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+static VL53L0X_Error dev_read(VL53L0X_DEV Dev, uint8_t index, uint8_t *pdata, uint32_t count){
+    VL53L0X_Error Status;
     int32_t status_int;
-	uint8_t deviceAddress;
+    uint32_t timeout_us;
 
-    deviceAddress = Dev->I2cDevAddr;
+    // the time left is the bus wait of the transfer
+    Status = VL53L0X_GetRemainingTime(Dev, &timeout_us);
+    if (Status != VL53L0X_ERROR_NONE)
+        return Status;
 
-	status_int = VL53L0X_write_word(deviceAddress, index, data);
+    status_int = bus_ops(Dev)->read_multi(Dev, pending_page(Dev), index, pdata, count, timeout_us);
+    Status = bus_end(Dev, status_int);
 
-	if (status_int != 0)
-		Status = VL53L0X_ERROR_CONTROL_INTERFACE;
+#ifdef VL53L0X_LOG_ENABLE
+    if (count == 1)
+        trace_print(TRACE_LEVEL_INFO, "Read reg : 0x%02X, Val : 0x%02X\n", index, *pdata);
+#endif
 
     return Status;
 }
 
-VL53L0X_Error VL53L0X_WrDWord(VL53L0X_DEV Dev, uint8_t index, uint32_t data){
-    VL53L0X_Error Status = VL53L0X_ERROR_NONE;
-    int32_t status_int;
-	uint8_t deviceAddress;
+VL53L0X_Error VL53L0X_WriteMulti(VL53L0X_DEV Dev, uint8_t index, uint8_t *pdata, uint32_t count){
+
+    if (count>=VL53L0X_MAX_I2C_XFER_SIZE){
+        return VL53L0X_ERROR_INVALID_PARAMS;
+    }
+
+    return dev_write(Dev, index, pdata, count);
+}
+
+VL53L0X_Error VL53L0X_ReadMulti(VL53L0X_DEV Dev, uint8_t index, uint8_t *pdata, uint32_t count){
+
+    if (count>=VL53L0X_MAX_I2C_XFER_SIZE){
+        return VL53L0X_ERROR_INVALID_PARAMS;
+    }
 
-    deviceAddress = Dev->I2cDevAddr;
+    return dev_read(Dev, index, pdata, count);
+}
 
-	status_int = VL53L0X_write_dword(deviceAddress, index, data);
 
-	if (status_int != 0)
-		Status = VL53L0X_ERROR_CONTROL_INTERFACE;
+VL53L0X_Error VL53L0X_WrByte(VL53L0X_DEV Dev, uint8_t index, uint8_t data){
+    return dev_write(Dev, index, &data, 1);
+}
+
+VL53L0X_Error VL53L0X_WrWord(VL53L0X_DEV Dev, uint8_t index, uint16_t data){
+    VL53L0X_Error Status;
+    uint8_t buffer[BYTES_PER_WORD];
+
+    // Split 16-bit word into MS and LS uint8_t
+    buffer[0] = (uint8_t)(data >> 8);
+    buffer[1] = (uint8_t)(data & 0x00FF);
+
+    if (index % 2 == 1) {
+        // serial comms cannot handle word writes to non 2-byte aligned registers.
+        Status = dev_write(Dev, index, &buffer[0], 1);
+        if (Status == VL53L0X_ERROR_NONE)
+            Status = dev_write(Dev, index + 1, &buffer[1], 1);
+    } else {
+        Status = dev_write(Dev, index, buffer, BYTES_PER_WORD);
+    }
 
     return Status;
 }
 
-VL53L0X_Error VL53L0X_UpdateByte(VL53L0X_DEV Dev, uint8_t index, uint8_t AndData, uint8_t OrData){
-    VL53L0X_Error Status = VL53L0X_ERROR_NONE;
-    int32_t status_int;
-    uint8_t deviceAddress;
-    uint8_t data;
+VL53L0X_Error VL53L0X_WrDWord(VL53L0X_DEV Dev, uint8_t index, uint32_t data){
+    uint8_t buffer[BYTES_PER_DWORD];
 
-    deviceAddress = Dev->I2cDevAddr;
+    // Split 32-bit word into MS ... LS bytes
+    buffer[0] = (uint8_t)(data >> 24);
+    buffer[1] = (uint8_t)((data & 0x00FF0000) >> 16);
+    buffer[2] = (uint8_t)((data & 0x0000FF00) >> 8);
+    buffer[3] = (uint8_t)(data & 0x000000FF);
 
-    status_int = VL53L0X_read_byte(deviceAddress, index, &data);
+    return dev_write(Dev, index, buffer, BYTES_PER_DWORD);
+}
+
+VL53L0X_Error VL53L0X_UpdateByte(VL53L0X_DEV Dev, uint8_t index, uint8_t AndData, uint8_t OrData){
+    VL53L0X_Error Status;
+    uint8_t data;
 
-    if (status_int != 0)
-        Status = VL53L0X_ERROR_CONTROL_INTERFACE;
+    Status = dev_read(Dev, index, &data, 1);
 
     if (Status == VL53L0X_ERROR_NONE) {
         data = (data & AndData) | OrData;
-        status_int = VL53L0X_write_byte(deviceAddress, index, data);
-
-        if (status_int != 0)
-            Status = VL53L0X_ERROR_CONTROL_INTERFACE;
+        Status = dev_write(Dev, index, &data, 1);
     }
 
     return Status;
 }
 
 VL53L0X_Error VL53L0X_RdByte(VL53L0X_DEV Dev, uint8_t index, uint8_t *data){
-    VL53L0X_Error Status = VL53L0X_ERROR_NONE;
-    int32_t status_int;
-    uint8_t deviceAddress;
+    return dev_read(Dev, index, data, 1);
+}
 
-    deviceAddress = Dev->I2cDevAddr;
+VL53L0X_Error VL53L0X_RdWord(VL53L0X_DEV Dev, uint8_t index, uint16_t *data){
+    VL53L0X_Error Status;
+    uint8_t buffer[BYTES_PER_WORD];
 
-    status_int = VL53L0X_read_byte(deviceAddress, index, data);
+    Status = dev_read(Dev, index, buffer, BYTES_PER_WORD);
+    *data = ((uint16_t)buffer[0] << 8) + (uint16_t)buffer[1];
 
-    if (status_int != 0)
-        Status = VL53L0X_ERROR_CONTROL_INTERFACE;
+    return Status;
+}
+
+VL53L0X_Error  VL53L0X_RdDWord(VL53L0X_DEV Dev, uint8_t index, uint32_t *data){
+    VL53L0X_Error Status;
+    uint8_t buffer[BYTES_PER_DWORD];
+
+    Status = dev_read(Dev, index, buffer, BYTES_PER_DWORD);
+    *data = ((uint32_t)buffer[0] << 24) + ((uint32_t)buffer[1] << 16) + ((uint32_t)buffer[2] << 8) + (uint32_t)buffer[3];
 
     return Status;
 }
 
-VL53L0X_Error VL53L0X_RdWord(VL53L0X_DEV Dev, uint8_t index, uint16_t *data){
+static VL53L0X_Error write_chunk(VL53L0X_DEV Dev, const uint8_t *pairs, uint32_t count){
+    VL53L0X_Error Status;
+    int32_t status_int;
+    uint32_t timeout_us;
+
+    uint32_t i;
+
+    // the time left is the bus wait of the transfer
+    Status = VL53L0X_GetRemainingTime(Dev, &timeout_us);
+    if (Status != VL53L0X_ERROR_NONE)
+        return Status;
+
+    status_int = bus_ops(Dev)->write_sequence(Dev, pending_page(Dev), pairs, count, timeout_us);
+    Status = bus_end(Dev, status_int);
+
+    // follow the page selects of the sequence itself
+    for (i = 0; i < count && status_int == 0; i++) {
+        if (pairs[2 * i] == VL53L0X_PAGE_SELECT_INDEX) {
+            Dev->PageCurrent = pairs[2 * i + 1];
+            Dev->PageFlags = VL53L0X_PAGE_KNOWN;
+        } else if (pairs[2 * i] == VL53L0X_REG_SOFT_RESET_GO2_SOFT_RESET_N) {
+            VL53L0X_InvalidatePage(Dev);
+            Dev->InterruptSettings = VL53L0X_INTERRUPT_SETTINGS_UNKNOWN;
+        }
+    }
+
+    return Status;
+}
+
+VL53L0X_Error VL53L0X_WriteSequence(VL53L0X_DEV Dev, const uint8_t *pairs, uint32_t count){
     VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+    uint32_t chunk;
+
+    // the bus is released between chunks, for the transfers waiting on it
+    while (count > 0 && Status == VL53L0X_ERROR_NONE) {
+        chunk = count < VL53L0X_SEQUENCE_CHUNK ? count : VL53L0X_SEQUENCE_CHUNK;
+        Status = write_chunk(Dev, pairs, chunk);
+        pairs += 2 * chunk;
+        count -= chunk;
+    }
+
+    return Status;
+}
+
+VL53L0X_Error VL53L0X_ReadBlocks(VL53L0X_DEV Dev, const VL53L0X_ReadBlock_t *blocks, uint32_t count){
+    VL53L0X_Error Status;
     int32_t status_int;
-    uint8_t deviceAddress;
+    uint32_t timeout_us;
 
-    deviceAddress = Dev->I2cDevAddr;
+    uint32_t i;
 
-    status_int = VL53L0X_read_word(deviceAddress, index, data);
+    for (i = 0; i < count; i++) {
+        if (blocks[i].count == 0 || blocks[i].count >= VL53L0X_MAX_I2C_XFER_SIZE)
+            return VL53L0X_ERROR_INVALID_PARAMS;
+    }
 
-    if (status_int != 0)
-        Status = VL53L0X_ERROR_CONTROL_INTERFACE;
+    // the time left is the bus wait of the transfer
+    Status = VL53L0X_GetRemainingTime(Dev, &timeout_us);
+    if (Status != VL53L0X_ERROR_NONE)
+        return Status;
 
-    return Status;
+    status_int = bus_ops(Dev)->read_blocks(Dev, pending_page(Dev), blocks, count, timeout_us);
+
+    return bus_end(Dev, status_int);
 }
 
-VL53L0X_Error  VL53L0X_RdDWord(VL53L0X_DEV Dev, uint8_t index, uint32_t *data){
-    VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+/*
+ * Transfer batch
+ *
+ * The pending page of a device goes in front of its first transfer, and is
+ * taken as selected for the following ones. The transport marks the
+ * transfers of a failed submission that went through anyway. The pages of
+ * the others go back to pending, their reads are retried one by one, their
+ * writes are not sent twice: they fail with VL53L0X_ERROR_CONTROL_INTERFACE.
+ */
+static void batch_run(VL53L0X_Bus_t *bus, VL53L0X_Transfer_t *transfers, uint32_t count)
+{
+    VL53L0X_Transfer_t *queued[VL53L0X_SEQUENCE_CHUNK];
+    VL53L0X_Transfer_t *t;
+    uint32_t timeout_us = UINT32_MAX;
+    uint32_t remaining_us;
+    uint32_t queued_count = 0;
     int32_t status_int;
-    uint8_t deviceAddress;
+    uint32_t i;
 
-    deviceAddress = Dev->I2cDevAddr;
+    for (i = 0; i < count; i++) {
+        t = &transfers[i];
 
-    status_int = VL53L0X_read_dword(deviceAddress, index, data);
+        if (t->count == 0 || t->count >= VL53L0X_MAX_I2C_XFER_SIZE) {
+            t->Status = VL53L0X_ERROR_INVALID_PARAMS;
+            continue;
+        }
 
-    if (status_int != 0)
-        Status = VL53L0X_ERROR_CONTROL_INTERFACE;
+        t->Status = VL53L0X_GetRemainingTime(t->device, &remaining_us);
+        if (t->Status != VL53L0X_ERROR_NONE)
+            continue;
 
-    return Status;
+        if (t->write && t->index == VL53L0X_PAGE_SELECT_INDEX && t->count == 1) {
+            t->Status = select_page(t->device, *t->pdata);
+            continue;
+        }
+
+        if (remaining_us < timeout_us)
+            timeout_us = remaining_us;
+
+        t->page = pending_page(t->device);
+        bus_end(t->device, 0);
+        t->Status = VL53L0X_ERROR_CONTROL_INTERFACE;
+        queued[queued_count++] = t;
+    }
+
+    if (queued_count == 0)
+        return;
+
+    status_int = -1;
+    if (bus->ops->batch != NULL)
+        status_int = bus->ops->batch(bus, queued, queued_count, timeout_us);
+
+    if (status_int == 0) {
+        for (i = 0; i < queued_count; i++) {
+            queued[i]->Status = VL53L0X_ERROR_NONE;
+            if (queued[i]->write)
+                write_done(queued[i]->device, queued[i]->index, queued[i]->count);
+        }
+        return;
+    }
+
+    for (i = 0; i < queued_count; i++) {
+        t = queued[i];
+        if (t->Status == VL53L0X_ERROR_NONE) {
+            if (t->write)
+                write_done(t->device, t->index, t->count);
+        } else if (t->page >= 0) {
+            t->device->PagePending = (uint8_t)t->page;
+            t->device->PageFlags = VL53L0X_PAGE_PENDING;
+        }
+    }
+
+    for (i = 0; i < queued_count; i++) {
+        t = queued[i];
+        if (t->Status == VL53L0X_ERROR_NONE)
+            continue;
+
+        if (!t->write)
+            t->Status = dev_read(t->device, t->index, t->pdata, t->count);
+        else if (bus->ops->batch == NULL)
+            t->Status = dev_write(t->device, t->index, t->pdata, t->count);
+        else
+            write_done(t->device, t->index, t->count);  // may have reached the device
+    }
+}
+
+VL53L0X_Error VL53L0X_TransferBatch(VL53L0X_Transfer_t *transfers, uint32_t count){
+    VL53L0X_Bus_t *bus;
+    uint32_t start = 0;
+    uint32_t end;
+    uint32_t i;
+
+    // runs of transfers on the same bus
+    while (start < count) {
+        bus = dev_bus(transfers[start].device);
+        end = start + 1;
+        while (end < count && end - start < VL53L0X_SEQUENCE_CHUNK &&
+               dev_bus(transfers[end].device) == bus)
+            end++;
+
+        batch_run(bus, &transfers[start], end - start);
+        start = end;
+    }
+
+    for (i = 0; i < count; i++) {
+        if (transfers[i].Status != VL53L0X_ERROR_NONE)
+            return transfers[i].Status;
+    }
+
+    return VL53L0X_ERROR_NONE;
 }
 
 VL53L0X_Error VL53L0X_PollingDelay(VL53L0X_DEV Dev)
 {
-    vTaskDelay(10 / portTICK_PERIOD_MS);
-    return VL53L0X_ERROR_NONE;
+    return VL53L0X_Sleep(Dev, VL53L0X_POLLING_DELAY_US);
 }
@@ -6,12 +6,20 @@
  * Modified: Friday, 05 February 2021
  * 
  */
+#include <stdint.h>     // before vl53l0x_platform_log.h, which uses it without including it
+
 #include "vl53l0x_platform_log.h"
 #include "vl53l0x_i2c_platform.h"
 #include "vl53l0x_def.h"
 
 #include <stdio.h>    // sprintf(), vsnprintf(), //printf()
 
+#ifdef VL53L0X_LOG_DEFERRED
+#include "vl53l0x_platform_trace.h"
+
+#include "esp_timer.h"
+#endif
+
 #define trace_print(level, ...) trace_print_module_function(TRACE_MODULE_PLATFORM, level, TRACE_FUNCTION_NONE, ##__VA_ARGS__)
 #define trace_i2c(...) trace_print_module_function(TRACE_MODULE_NONE, TRACE_LEVEL_NONE, TRACE_FUNCTION_I2C, ##__VA_ARGS__)
 
@@ -27,7 +35,314 @@ int32_t VL53L0X_trace_config(char *filename, uint32_t modules, uint32_t level, u
     return 0;
 }
 
-void trace_print_module_function(uint32_t module, uint32_t level, uint32_t function, const char *format, ...)
+#ifdef VL53L0X_LOG_DEFERRED
+
+#if (VL53L0X_TRACE_RECORDS & (VL53L0X_TRACE_RECORDS - 1)) != 0
+#error "VL53L0X_TRACE_RECORDS must be a power of two"
+#endif
+
+typedef struct {
+    uint32_t seq;                       // index + 1 once written, 0 : being written
+    uint32_t timestamp_us;
+    const char *format;
+    uint32_t words[VL53L0X_TRACE_WORDS];
+} trace_record_t;
+
+enum {
+    ARG_NONE,
+    ARG_WORD,
+    ARG_WIDE,
+    ARG_DOUBLE,
+    ARG_POINTER,
+};
+
+static trace_record_t trace_ring[VL53L0X_TRACE_RECORDS];
+static uint32_t trace_head;             // records reserved by the writers
+static uint32_t trace_tail;             // records taken, draining task only
+static uint32_t trace_lost;
+static uint32_t trace_reported;         // trace_lost already told about
+
+// conversion starting just past its '%' : kind of its argument, returns its end
+static const char *conversion(const char *p, uint8_t *pkind)
+{
+    uint8_t longs = 0;
+
+    if (*p == '%')
+    {
+        *pkind = ARG_NONE;
+        return p + 1;
+    }
+
+    while (*p != '\0' && strchr("-+ #0123456789.", *p) != NULL)
+        p++;
+    for (; *p != '\0' && strchr("hlLjzt", *p) != NULL; p++)
+    {
+        if (*p == 'l' || *p == 'z' || *p == 't')
+            longs++;
+        else if (*p == 'L' || *p == 'j')
+            longs = 2;
+    }
+
+    switch (*p)
+    {
+    case '\0':
+        *pkind = ARG_NONE;
+        return p;
+    case 'a': case 'A': case 'e': case 'E': case 'f': case 'F': case 'g': case 'G':
+        *pkind = ARG_DOUBLE;
+        break;
+    case 's': case 'p':
+        *pkind = ARG_POINTER;
+        break;
+    default:
+        *pkind = (longs >= 2 || (longs == 1 && sizeof(long) > 4)) ? ARG_WIDE : ARG_WORD;
+        break;
+    }
+
+    return p + 1;
+}
+
+static uint32_t arg_words(uint8_t kind)
+{
+    switch (kind)
+    {
+    case ARG_WORD:      return 1;
+    case ARG_POINTER:   return sizeof(void *) / 4;
+    case ARG_NONE:      return 0;
+    default:            return 2;
+    }
+}
+
+static void put_wide(uint32_t *words, uint64_t value)
+{
+    words[0] = (uint32_t)value;
+    words[1] = (uint32_t)(value >> 32);
+}
+
+static uint64_t get_wide(const uint32_t *words, uint32_t count)
+{
+    return count == 1 ? words[0] : ((uint64_t)words[1] << 32) | words[0];
+}
+
+// no formatting here, only the raw arguments up to VL53L0X_TRACE_WORDS
+static void trace_record(const char *format, va_list args)
+{
+    uint32_t index = __atomic_fetch_add(&trace_head, 1, __ATOMIC_RELAXED);
+    trace_record_t *r = &trace_ring[index & (VL53L0X_TRACE_RECORDS - 1)];
+    const char *p = format;
+    uint32_t n = 0;
+    uint8_t kind;
+    double d;
+    uint64_t bits;
+
+    __atomic_store_n(&r->seq, 0, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    r->timestamp_us = (uint32_t)esp_timer_get_time();
+    r->format = format;
+
+    while ((p = strchr(p, '%')) != NULL)
+    {
+        p = conversion(p + 1, &kind);
+        if (kind == ARG_NONE)
+            continue;
+        if (n + arg_words(kind) > VL53L0X_TRACE_WORDS)
+            break;
+
+        switch (kind)
+        {
+        case ARG_WORD:
+            r->words[n] = va_arg(args, unsigned int);
+            break;
+        case ARG_WIDE:
+            put_wide(&r->words[n], va_arg(args, unsigned long long));
+            break;
+        case ARG_DOUBLE:
+            d = va_arg(args, double);
+            memcpy(&bits, &d, sizeof(bits));
+            put_wide(&r->words[n], bits);
+            break;
+        default:
+            bits = (uintptr_t)va_arg(args, void *);
+            if (sizeof(void *) > 4)
+                put_wide(&r->words[n], bits);
+            else
+                r->words[n] = (uint32_t)bits;
+            break;
+        }
+        n += arg_words(kind);
+    }
+
+    __atomic_store_n(&r->seq, index + 1, __ATOMIC_RELEASE);
+}
+
+// copy out the oldest record, 0 if none is complete
+static uint8_t trace_take(trace_record_t *out)
+{
+    uint32_t head;
+    trace_record_t *r;
+    uint32_t seq;
+
+    for (;;)
+    {
+        head = __atomic_load_n(&trace_head, __ATOMIC_ACQUIRE);
+
+        // lapped by the writers
+        if (head - trace_tail > VL53L0X_TRACE_RECORDS)
+        {
+            trace_lost += head - trace_tail - VL53L0X_TRACE_RECORDS;
+            trace_tail = head - VL53L0X_TRACE_RECORDS;
+        }
+        if (trace_tail == head)
+            return 0;
+
+        r = &trace_ring[trace_tail & (VL53L0X_TRACE_RECORDS - 1)];
+        seq = __atomic_load_n(&r->seq, __ATOMIC_ACQUIRE);
+        if (seq != trace_tail + 1)
+            return 0;
+
+        *out = *r;
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        trace_tail++;
+
+        // not overwritten while copied
+        if (__atomic_load_n(&r->seq, __ATOMIC_RELAXED) == seq)
+            return 1;
+        trace_lost++;
+    }
+}
+
+static void trace_format(const trace_record_t *r)
+{
+    const char *p = r->format;
+    const char *start;
+    char spec[16];
+    uint32_t n = 0;
+    uint32_t words;
+    uint8_t kind;
+    uint64_t bits;
+    double d;
+
+    printf("%u: ", r->timestamp_us);
+
+    while (*p != '\0')
+    {
+        if (*p != '%')
+        {
+            putchar(*p++);
+            continue;
+        }
+
+        start = p;
+        p = conversion(p + 1, &kind);
+        words = arg_words(kind);
+
+        if (kind == ARG_NONE)
+        {
+            if (start[1] == '%')
+                putchar('%');
+            continue;
+        }
+        if (p - start >= (int)sizeof(spec) || n + words > VL53L0X_TRACE_WORDS)
+        {
+            fputs("?", stdout);
+            continue;
+        }
+
+        memcpy(spec, start, p - start);
+        spec[p - start] = '\0';
+        bits = get_wide(&r->words[n], words);
+        n += words;
+
+        switch (kind)
+        {
+        case ARG_WORD:
+            printf(spec, (unsigned int)bits);
+            break;
+        case ARG_WIDE:
+            printf(spec, (unsigned long long)bits);
+            break;
+        case ARG_DOUBLE:
+            memcpy(&d, &bits, sizeof(d));
+            printf(spec, d);
+            break;
+        default:
+            printf(spec, (void *)(uintptr_t)bits);
+            break;
+        }
+    }
+}
+
+uint32_t VL53L0X_trace_drain(uint32_t max)
+{
+    trace_record_t r;
+    uint32_t taken = 0;
+
+    while ((max == 0 || taken < max) && trace_take(&r))
+    {
+        if (trace_lost != trace_reported)
+        {
+            printf("%u trace records lost\n", trace_lost - trace_reported);
+            trace_reported = trace_lost;
+        }
+        trace_format(&r);
+        taken++;
+    }
+
+    return taken;
+}
+
+static void dump_record(VL53L0X_TraceWriteFn write, void *ctx, uint32_t timestamp_us,
+                        const char *format, const uint32_t *words)
+{
+    uint8_t buf[sizeof(uint32_t) + sizeof(void *) + sizeof(uint32_t) * VL53L0X_TRACE_WORDS];
+    uintptr_t address = (uintptr_t)format;
+
+    memcpy(buf, &timestamp_us, sizeof(uint32_t));
+    memcpy(&buf[sizeof(uint32_t)], &address, sizeof(void *));
+    memcpy(&buf[sizeof(uint32_t) + sizeof(void *)], words, sizeof(uint32_t) * VL53L0X_TRACE_WORDS);
+    write(buf, sizeof(buf), ctx);
+}
+
+uint32_t VL53L0X_trace_dump(VL53L0X_TraceWriteFn write, void *ctx, uint32_t max)
+{
+    VL53L0X_TraceDumpHeader_t header = {
+        .magic = VL53L0X_TRACE_MAGIC,
+        .version = VL53L0X_TRACE_VERSION,
+        .pointer_size = sizeof(void *),
+        .words = VL53L0X_TRACE_WORDS,
+        .long_size = sizeof(long),
+    };
+    uint32_t lost[VL53L0X_TRACE_WORDS] = { 0 };
+    trace_record_t r;
+    uint32_t taken = 0;
+
+    write(&header, sizeof(header), ctx);
+
+    while ((max == 0 || taken < max) && trace_take(&r))
+    {
+        if (trace_lost != trace_reported)
+        {
+            lost[0] = trace_lost - trace_reported;
+            dump_record(write, ctx, r.timestamp_us, NULL, lost);
+            trace_reported = trace_lost;
+        }
+        dump_record(write, ctx, r.timestamp_us, r.format, r.words);
+        taken++;
+    }
+
+    return taken;
+}
+
+uint32_t VL53L0X_trace_dropped(void)
+{
+    return trace_lost;
+}
+
+#endif // VL53L0X_LOG_DEFERRED
+
+// parenthesized past the compile time filter of vl53l0x_platform_log.h
+void (trace_print_module_function)(uint32_t module, uint32_t level, uint32_t function, const char *format, ...)
 {
     if ( ((level <=_trace_level) && ((module & _trace_modules) > 0))
         || ((function & _trace_functions) > 0) )
@@ -36,8 +351,12 @@ void trace_print_module_function(uint32_t module, uint32_t level, uint32_t funct
         // char message[VL53L0X_MAX_STRING_LENGTH_PLT];
 
         va_start(arg_list, format);
+#ifdef VL53L0X_LOG_DEFERRED
+        trace_record(format, arg_list);
+#else
         // vsnprintf(message, VL53L0X_MAX_STRING_LENGTH_PLT, format, arg_list);
         vprintf(format, arg_list);
+#endif
         va_end(arg_list);
         // //printf(message);
     }
@@ -0,0 +1,24 @@
+/*
+ * File : esp_timer.h
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#ifndef VL53L0X_LINUX_ESP_TIMER_H_
+#define VL53L0X_LINUX_ESP_TIMER_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** CLOCK_MONOTONIC, us */
+int64_t esp_timer_get_time(void);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+#endif // VL53L0X_LINUX_ESP_TIMER_H_
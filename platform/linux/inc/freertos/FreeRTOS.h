@@ -0,0 +1,33 @@
+/*
+ * File : FreeRTOS.h
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#ifndef VL53L0X_LINUX_FREERTOS_H_
+#define VL53L0X_LINUX_FREERTOS_H_
+
+/*
+ * The FreeRTOS names the driver sources use, on Linux: 1 ms ticks.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "sdkconfig.h"
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+
+#define portTICK_PERIOD_MS      1
+#define portMAX_DELAY           ((TickType_t)0xFFFFFFFFUL)
+#define pdMS_TO_TICKS(ms)       ((TickType_t)(ms))
+
+#define pdFALSE                 0
+#define pdTRUE                  1
+
+#endif // VL53L0X_LINUX_FREERTOS_H_
@@ -0,0 +1,17 @@
+/*
+ * File : semphr.h
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#ifndef VL53L0X_LINUX_SEMPHR_H_
+#define VL53L0X_LINUX_SEMPHR_H_
+
+#include "freertos/FreeRTOS.h"
+
+/* type of VL53L0X_BusArbiter_t only, the Linux buses arbitrate with pthreads */
+typedef void *SemaphoreHandle_t;
+
+#endif // VL53L0X_LINUX_SEMPHR_H_
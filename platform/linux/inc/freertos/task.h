@@ -0,0 +1,24 @@
+/*
+ * File : task.h
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#ifndef VL53L0X_LINUX_TASK_H_
+#define VL53L0X_LINUX_TASK_H_
+
+#include "freertos/FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** sleep the calling thread */
+void vTaskDelay(TickType_t ticks);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+#endif // VL53L0X_LINUX_TASK_H_
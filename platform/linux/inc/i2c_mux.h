@@ -0,0 +1,15 @@
+/*
+ * File : i2c_mux.h
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#ifndef VL53L0X_LINUX_I2C_MUX_H_
+#define VL53L0X_LINUX_I2C_MUX_H_
+
+/* nominal clock of the buses, the adapter sets the real one */
+#define I2C_MUX_BAUDRATE    400000
+
+#endif // VL53L0X_LINUX_I2C_MUX_H_
@@ -0,0 +1,22 @@
+/*
+ * File : sdkconfig.h
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#ifndef VL53L0X_LINUX_SDKCONFIG_H_
+#define VL53L0X_LINUX_SDKCONFIG_H_
+
+/* Kconfig defaults of the component, override them on the compiler command line */
+
+#ifndef CONFIG_VL53L0X_I2C_ADDR
+#define CONFIG_VL53L0X_I2C_ADDR             0x29
+#endif
+
+#ifndef CONFIG_VL53L0X_DEVICE_POOL_SIZE
+#define CONFIG_VL53L0X_DEVICE_POOL_SIZE     4
+#endif
+
+#endif // VL53L0X_LINUX_SDKCONFIG_H_
@@ -0,0 +1,78 @@
+/*
+ * File : vl53l0x_platform_linux.h
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#ifndef VL53L0X_PLATFORM_LINUX_H_
+#define VL53L0X_PLATFORM_LINUX_H_
+
+#include <stdint.h>
+#include <pthread.h>
+#include <linux/i2c.h>
+
+#include "vl53l0x_platform_esp32.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** adapter of the default bus, opened by VL53L0X_comms_initialise */
+#ifndef VL53L0X_LINUX_I2C_DEVICE
+#define VL53L0X_LINUX_I2C_DEVICE    "/dev/i2c-1"
+#endif
+
+/**
+ * Run the messages as one combined transaction, a repeated start between
+ * two messages and a single stop.
+ * @return  0, or the errno of the failure
+ */
+typedef int (*VL53L0X_LinuxTransferFn)(void *ctx, struct i2c_msg *msgs, uint32_t count);
+
+/**
+ * Linux i2c-dev adapter behind a VL53L0X_Bus_t (bus->ctx).
+ * transfer is the I2C_RDWR ioctl on fd for an opened /dev/i2c-N; a stand-in,
+ * e.g. a simulated device, sets its own transfer and ctx instead.
+ * The bus is arbitrated between the threads as on the esp32: a transfer
+ * waiting for it goes before the waiting transfers of lower priority.
+ */
+typedef struct {
+    int fd;                             /*!< /dev/i2c-N, -1 : not opened */
+    VL53L0X_LinuxTransferFn transfer;
+    void *ctx;                          /*!< of transfer */
+
+    pthread_mutex_t lock;               /*!< guards the fields below */
+    pthread_cond_t released;
+    uint8_t busy;
+    uint16_t waiting[VL53L0X_BUS_PRIORITIES];
+} VL53L0X_LinuxAdapter_t;
+
+/** transfers through an i2c-dev adapter, the transport of VL53L0X_LinuxBus_open */
+extern const VL53L0X_BusOps_t VL53L0X_LinuxBusOps;
+
+/**
+ * Bus on an i2c-dev adapter, e.g. "/dev/i2c-1".
+ * @param   mux_address multiplexer in front of the devices with a MuxMask, 0 : none.
+ *                      Muxes registered in the kernel show as their own
+ *                      adapters instead, one bus each.
+ */
+VL53L0X_Error VL53L0X_LinuxBus_open(VL53L0X_Bus_t *bus, VL53L0X_LinuxAdapter_t *adapter,
+                                    const char *path, uint8_t mux_address);
+
+/**
+ * Bus on the transfer function of an adapter, set by the caller.
+ */
+VL53L0X_Error VL53L0X_LinuxBus_init(VL53L0X_Bus_t *bus, VL53L0X_LinuxAdapter_t *adapter,
+                                    uint8_t mux_address);
+
+/**
+ * Close the adapter of the bus, its devices stopped first.
+ */
+void VL53L0X_LinuxBus_close(VL53L0X_Bus_t *bus);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+#endif // VL53L0X_PLATFORM_LINUX_H_
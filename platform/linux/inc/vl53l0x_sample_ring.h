@@ -0,0 +1,115 @@
+/*
+ * File : vl53l0x_sample_ring.h
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#ifndef VL53L0X_SAMPLE_RING_H_
+#define VL53L0X_SAMPLE_RING_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "vl53l0x_def.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Shared memory sample ring.
+ *
+ * The acquisition process publishes its measurements into a POSIX shared
+ * memory object (shm_open name, e.g. "/vl53l0x"). Any number of processes
+ * map it read-only and take the samples straight from the mapping: no
+ * system call and no copy besides the 32 byte record itself. Readers do not
+ * hold back the publisher, a reader too slow is lapped and counts the
+ * samples it lost. Several threads may publish into the same ring.
+ */
+
+/** records of a ring, a power of two, at least 2 */
+#ifndef VL53L0X_SAMPLE_RING_RECORDS
+#define VL53L0X_SAMPLE_RING_RECORDS     1024
+#endif
+
+#define VL53L0X_SAMPLE_RING_MAGIC       "VLSR"
+#define VL53L0X_SAMPLE_RING_VERSION     1
+
+/**
+ * One measurement, 32 bytes in the shared memory.
+ */
+typedef struct {
+    uint32_t seq;               /*!< record number + 1 once published */
+    uint16_t device;            /*!< number the publisher gives the device */
+    uint8_t RangeStatus;
+    uint8_t reserved;
+    int64_t timestamp_us;       /*!< esp_timer_get_time (CLOCK_MONOTONIC) at publication */
+    uint16_t RangeMilliMeter;
+    uint16_t RangeDMaxMilliMeter;
+    uint16_t EffectiveSpadRtnCount;             /*!< 8.8 */
+    uint16_t reserved2;
+    FixPoint1616_t SignalRateRtnMegaCps;
+    FixPoint1616_t AmbientRateRtnMegaCps;
+} VL53L0X_SharedSample_t;
+
+/**
+ * Start of the shared memory, the records follow.
+ */
+typedef struct {
+    char magic[4];
+    uint8_t version;
+    uint8_t record_size;
+    uint16_t reserved;
+    uint32_t records;
+    uint32_t head;              /*!< records published so far */
+} VL53L0X_SampleRingHeader_t;
+
+/**
+ * Mapping of a ring, on the publisher or on a reader side.
+ */
+typedef struct {
+    VL53L0X_SampleRingHeader_t *header;
+    VL53L0X_SharedSample_t *samples;
+    size_t size;
+    uint32_t next;              /*!< reader : next record to take */
+    uint32_t lost;              /*!< reader : records overwritten before being taken */
+} VL53L0X_SampleRing_t;
+
+/**
+ * Create the ring, replacing a previous one of that name. Readers of the
+ * previous one keep it until they open the ring again.
+ * @param   records     a power of two, at least 2, 0 : VL53L0X_SAMPLE_RING_RECORDS
+ * @return  VL53L0X_ERROR_INVALID_PARAMS for another number of records
+ */
+VL53L0X_Error VL53L0X_SampleRing_create(VL53L0X_SampleRing_t *ring, const char *name, uint32_t records);
+
+/**
+ * Publish a measurement of the device.
+ */
+void VL53L0X_SampleRing_publish(VL53L0X_SampleRing_t *ring, uint16_t device,
+                                const VL53L0X_RangingMeasurementData_t *pRangingMeasurementData);
+
+/**
+ * Map the ring read-only, from its next publication on.
+ * @return  VL53L0X_ERROR_NOT_SUPPORTED for a ring of another layout
+ */
+VL53L0X_Error VL53L0X_SampleRing_open(VL53L0X_SampleRing_t *ring, const char *name);
+
+/**
+ * Take the oldest sample not taken yet.
+ * @return  1 with *psample filled, 0 if none
+ */
+uint8_t VL53L0X_SampleRing_take(VL53L0X_SampleRing_t *ring, VL53L0X_SharedSample_t *psample);
+
+/**
+ * Unmap the ring. The publisher also removes its name with VL53L0X_SampleRing_remove.
+ */
+void VL53L0X_SampleRing_close(VL53L0X_SampleRing_t *ring);
+void VL53L0X_SampleRing_remove(const char *name);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+#endif // VL53L0X_SAMPLE_RING_H_
@@ -0,0 +1,846 @@
+/*
+ * File : vl53l0x_i2c_linux.c
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/i2c-dev.h>
+
+#include "vl53l0x_i2c_platform.h"
+#include "vl53l0x_platform_log.h"
+#include "vl53l0x_platform_linux.h"
+
+#include "esp_timer.h"
+#include "i2c_mux.h"
+
+#ifdef VL53L0X_LOG_ENABLE
+#define trace_print(level, ...) trace_print_module_function(TRACE_MODULE_PLATFORM, level, TRACE_FUNCTION_NONE, ##__VA_ARGS__)
+#endif
+
+#define STATUS_OK 0x00
+#define STATUS_FAIL 0x01
+
+// longest bus wait, as the esp32 I2C_FLUSH_DELAY
+#define I2C_FLUSH_DELAY_US  2000000
+
+// bytes on the wire besides data : address + index (+ address for reads)
+#define I2C_WRITE_OVERHEAD  2
+#define I2C_READ_OVERHEAD   3
+
+// index and data bytes of the write messages of one transaction
+#define XFER_DATA_SIZE      512
+
+static int32_t errno_to_vl53l0x_error(int err)
+{
+    switch (err)
+    {
+    case 0:         return VL53L0X_ERROR_NONE;
+    case EINVAL:    return VL53L0X_ERROR_INVALID_PARAMS;
+    case ETIMEDOUT: return VL53L0X_ERROR_TIME_OUT;
+    default:
+        return VL53L0X_ERROR_CONTROL_INTERFACE;
+    }
+}
+
+// one I2C_RDWR ioctl : repeated starts between the messages, one stop
+static int rdwr(void *ctx, struct i2c_msg *msgs, uint32_t count)
+{
+    VL53L0X_LinuxAdapter_t *adapter = ctx;
+    struct i2c_rdwr_ioctl_data data = {
+        .msgs = msgs,
+        .nmsgs = count,
+    };
+    int ret = ioctl(adapter->fd, I2C_RDWR, &data);
+
+    if (ret < 0)
+        return errno;
+    return (uint32_t)ret == count ? 0 : EIO;
+}
+
+static VL53L0X_LinuxAdapter_t default_adapter = {
+    .fd = -1,
+    .transfer = rdwr,
+    .ctx = &default_adapter,
+};
+
+static VL53L0X_Bus_t default_bus = {
+    .ops = &VL53L0X_LinuxBusOps,
+    .port = -1,
+    .speed_khz = I2C_MUX_BAUDRATE / 1000,
+    .ctx = &default_adapter,
+};
+
+static pthread_once_t default_once = PTHREAD_ONCE_INIT;
+
+/*
+ * Bus arbitration
+ *
+ * Same policy as the esp32 transport: a transfer holds the bus from the
+ * multiplexer check to the end of its transaction, and a released bus goes
+ * to the highest priority waiter.
+ */
+static uint8_t priority_level(int8_t priority)
+{
+    if (priority < VL53L0X_BUS_PRIORITY_LOW)
+        priority = VL53L0X_BUS_PRIORITY_LOW;
+    if (priority > VL53L0X_BUS_PRIORITY_HIGH)
+        priority = VL53L0X_BUS_PRIORITY_HIGH;
+
+    return (uint8_t)(priority - VL53L0X_BUS_PRIORITY_LOW);
+}
+
+static void adapter_init(VL53L0X_LinuxAdapter_t *adapter)
+{
+    pthread_condattr_t attr;
+    int level;
+
+    pthread_mutex_init(&adapter->lock, NULL);
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&adapter->released, &attr);
+    pthread_condattr_destroy(&attr);
+
+    adapter->busy = 0;
+    for (level = 0; level < VL53L0X_BUS_PRIORITIES; level++)
+        adapter->waiting[level] = 0;
+}
+
+static void default_init(void)
+{
+    adapter_init(&default_adapter);
+}
+
+static VL53L0X_Bus_t *bus_default(void)
+{
+    pthread_once(&default_once, default_init);
+    return &default_bus;
+}
+
+// a waiter of higher priority goes first
+static uint8_t waiting_above(const VL53L0X_LinuxAdapter_t *adapter, uint8_t level)
+{
+    for (level++; level < VL53L0X_BUS_PRIORITIES; level++)
+    {
+        if (adapter->waiting[level] > 0)
+            return 1;
+    }
+    return 0;
+}
+
+// bus wait of a transfer, never above I2C_FLUSH_DELAY_US
+static void wait_deadline(uint32_t timeout_us, struct timespec *deadline)
+{
+    if (timeout_us == 0 || timeout_us > I2C_FLUSH_DELAY_US)
+        timeout_us = I2C_FLUSH_DELAY_US;
+
+    clock_gettime(CLOCK_MONOTONIC, deadline);
+    deadline->tv_sec += timeout_us / 1000000;
+    deadline->tv_nsec += (long)(timeout_us % 1000000) * 1000;
+    if (deadline->tv_nsec >= 1000000000)
+    {
+        deadline->tv_sec++;
+        deadline->tv_nsec -= 1000000000;
+    }
+}
+
+static int adapter_take(VL53L0X_Bus_t *bus, int8_t priority, uint32_t timeout_us)
+{
+    VL53L0X_LinuxAdapter_t *adapter = bus->ctx;
+    uint8_t level = priority_level(priority);
+    struct timespec deadline;
+    int64_t start;
+    uint32_t waited_us;
+
+    pthread_mutex_lock(&adapter->lock);
+    if (!adapter->busy && !waiting_above(adapter, level))
+    {
+        adapter->busy = 1;
+        pthread_mutex_unlock(&adapter->lock);
+        return 0;
+    }
+
+    adapter->waiting[level]++;
+    start = esp_timer_get_time();
+    wait_deadline(timeout_us, &deadline);
+    while (adapter->busy || waiting_above(adapter, level))
+    {
+        if (pthread_cond_timedwait(&adapter->released, &adapter->lock, &deadline) == ETIMEDOUT &&
+            (adapter->busy || waiting_above(adapter, level)))
+        {
+            adapter->waiting[level]--;
+            // lower priority waiters may go now
+            pthread_cond_broadcast(&adapter->released);
+            pthread_mutex_unlock(&adapter->lock);
+            return ETIMEDOUT;
+        }
+    }
+    adapter->waiting[level]--;
+    adapter->busy = 1;
+
+    // the bus is ours, the counters with it
+    waited_us = (uint32_t)(esp_timer_get_time() - start);
+    bus->stats.arbitration_waits++;
+    if (waited_us > bus->stats.max_wait_us[level])
+        bus->stats.max_wait_us[level] = waited_us;
+
+    pthread_mutex_unlock(&adapter->lock);
+    return 0;
+}
+
+static void adapter_give(VL53L0X_Bus_t *bus)
+{
+    VL53L0X_LinuxAdapter_t *adapter = bus->ctx;
+
+    pthread_mutex_lock(&adapter->lock);
+    adapter->busy = 0;
+    pthread_cond_broadcast(&adapter->released);
+    pthread_mutex_unlock(&adapter->lock);
+}
+
+VL53L0X_Bus_t *VL53L0X_Bus_default(void)
+{
+    return bus_default();
+}
+
+VL53L0X_Error VL53L0X_LinuxBus_init(VL53L0X_Bus_t *bus, VL53L0X_LinuxAdapter_t *adapter,
+                                    uint8_t mux_address)
+{
+    if (adapter->transfer == NULL)
+        return VL53L0X_ERROR_INVALID_PARAMS;
+
+    adapter->fd = -1;
+    adapter_init(adapter);
+
+    bus->ops = &VL53L0X_LinuxBusOps;
+    bus->port = -1;
+    bus->speed_khz = I2C_MUX_BAUDRATE / 1000;
+    bus->mux_address = mux_address;
+    bus->mux_current = 0;
+    bus->arbiter.lock = NULL;
+    bus->ctx = adapter;
+    VL53L0X_Bus_resetStats(bus);
+
+    return VL53L0X_ERROR_NONE;
+}
+
+// fd of an i2c-dev adapter able to run combined transactions
+static int adapter_open(const char *path, VL53L0X_Error *pStatus)
+{
+    unsigned long funcs = 0;
+    int fd = open(path, O_RDWR | O_CLOEXEC);
+
+    if (fd < 0)
+    {
+        *pStatus = VL53L0X_ERROR_CONTROL_INTERFACE;
+        return -1;
+    }
+
+    // SMBus only adapters, i2c-stub among them, have no I2C_RDWR
+    if (ioctl(fd, I2C_FUNCS, &funcs) < 0 || !(funcs & I2C_FUNC_I2C))
+    {
+        close(fd);
+        *pStatus = VL53L0X_ERROR_NOT_SUPPORTED;
+        return -1;
+    }
+
+    *pStatus = VL53L0X_ERROR_NONE;
+    return fd;
+}
+
+VL53L0X_Error VL53L0X_LinuxBus_open(VL53L0X_Bus_t *bus, VL53L0X_LinuxAdapter_t *adapter,
+                                    const char *path, uint8_t mux_address)
+{
+    VL53L0X_Error Status;
+    int fd = adapter_open(path, &Status);
+
+    if (fd < 0)
+        return Status;
+
+    adapter->transfer = rdwr;
+    adapter->ctx = adapter;
+    Status = VL53L0X_LinuxBus_init(bus, adapter, mux_address);
+    adapter->fd = fd;
+
+    return Status;
+}
+
+void VL53L0X_LinuxBus_close(VL53L0X_Bus_t *bus)
+{
+    VL53L0X_LinuxAdapter_t *adapter = bus->ctx;
+
+    if (adapter->fd >= 0)
+        close(adapter->fd);
+    adapter->fd = -1;
+
+    pthread_cond_destroy(&adapter->released);
+    pthread_mutex_destroy(&adapter->lock);
+}
+
+// an i2c-dev bus needs its adapter, see VL53L0X_LinuxBus_open. The default
+// bus is arbitrated from the start and opened by VL53L0X_comms_initialise.
+VL53L0X_Error VL53L0X_Bus_init(VL53L0X_Bus_t *bus, int port, uint16_t speed_khz, uint8_t mux_address)
+{
+    (void)bus;
+    (void)port;
+    (void)speed_khz;
+    (void)mux_address;
+
+    return VL53L0X_ERROR_NOT_IMPLEMENTED;
+}
+
+void VL53L0X_Bus_invalidateMux(VL53L0X_Bus_t *bus)
+{
+    bus->mux_current = 0;
+}
+
+void VL53L0X_Bus_getStats(VL53L0X_Bus_t *bus, VL53L0X_BusStats_t *pstats)
+{
+    *pstats = bus->stats;
+}
+
+void VL53L0X_Bus_resetStats(VL53L0X_Bus_t *bus)
+{
+    memset(&bus->stats, 0, sizeof(bus->stats));
+}
+
+static VL53L0X_Bus_t *dev_bus(VL53L0X_DEV Dev)
+{
+    return Dev->Bus != NULL ? Dev->Bus : bus_default();
+}
+
+void VL53L0X_get_bus_stats(VL53L0X_BusStats_t *pstats)
+{
+    VL53L0X_Bus_getStats(bus_default(), pstats);
+}
+
+void VL53L0X_reset_bus_stats(void)
+{
+    VL53L0X_Bus_resetStats(bus_default());
+}
+
+void VL53L0X_count_page_write_elided(VL53L0X_DEV Dev)
+{
+    dev_bus(Dev)->stats.page_writes_elided++;
+}
+
+int32_t VL53L0X_comms_initialise(uint8_t  comms_type,
+                                          uint16_t comms_speed_khz)
+{
+    VL53L0X_Bus_t *bus = bus_default();
+    VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+
+    (void)comms_type;
+    bus->speed_khz = comms_speed_khz;
+
+    // called by the setup of every device of the default bus: open
+    // VL53L0X_LINUX_I2C_DEVICE once
+    pthread_mutex_lock(&default_adapter.lock);
+    if (default_adapter.fd < 0)
+        default_adapter.fd = adapter_open(VL53L0X_LINUX_I2C_DEVICE, &Status);
+    pthread_mutex_unlock(&default_adapter.lock);
+
+    return Status;
+}
+
+int32_t VL53L0X_comms_close(void)
+{
+    pthread_mutex_lock(&default_adapter.lock);
+    if (default_adapter.fd >= 0)
+        close(default_adapter.fd);
+    default_adapter.fd = -1;
+    pthread_mutex_unlock(&default_adapter.lock);
+
+    return STATUS_OK;
+}
+
+int32_t VL53L0X_cycle_power(void)
+{
+    int32_t status = STATUS_OK;
+
+    return status;
+}
+
+VL53L0X_Error VL53L0X_Bus_acquire(VL53L0X_Bus_t *bus, int8_t priority, uint32_t timeout_us)
+{
+    return errno_to_vl53l0x_error(adapter_take(bus, priority, timeout_us));
+}
+
+void VL53L0X_Bus_release(VL53L0X_Bus_t *bus)
+{
+    adapter_give(bus);
+}
+
+/*
+ * Messages of one combined transaction. Past I2C_RDWR_IOCTL_MAX_MSGS
+ * messages, or XFER_DATA_SIZE bytes of writes, the messages so far go out
+ * first; the bus stays held in between.
+ */
+typedef struct {
+    VL53L0X_Bus_t *bus;
+    struct i2c_msg msgs[I2C_RDWR_IOCTL_MAX_MSGS];
+    uint8_t data[XFER_DATA_SIZE];
+    uint32_t count;
+    uint32_t used;
+    uint8_t mux;        /*!< channel the transaction selects */
+    uint32_t flushed;   /*!< transactions gone through */
+    uint32_t start;     /*!< bus bytes before the transaction */
+    uint32_t *pbytes;   /*!< byte counter of the device, NULL : none */
+    int err;
+} xfer_t;
+
+static void xfer_flush(xfer_t *x)
+{
+    VL53L0X_Bus_t *bus = x->bus;
+    VL53L0X_LinuxAdapter_t *adapter = bus->ctx;
+
+    if (x->err == 0 && x->count > 0)
+    {
+        x->err = adapter->transfer(adapter->ctx, x->msgs, x->count);
+        bus->stats.transactions++;
+        if (x->err == 0)
+            x->flushed++;
+
+        // a failed transfer may have stopped before the control byte
+        if (x->mux != 0 && bus->mux_address != 0)
+            bus->mux_current = (x->err == 0) ? x->mux : 0;
+    }
+
+    x->count = 0;
+    x->used = 0;
+}
+
+// room for msgs messages and size bytes of write data
+static void xfer_reserve(xfer_t *x, uint32_t msgs, uint32_t size)
+{
+    if (x->count + msgs > I2C_RDWR_IOCTL_MAX_MSGS || x->used + size > XFER_DATA_SIZE)
+        xfer_flush(x);
+}
+
+static void append_write(xfer_t *x, uint8_t address, uint8_t index, const uint8_t *pdata, int32_t count)
+{
+    uint8_t *buf;
+
+    xfer_reserve(x, 1, 1 + count);
+    buf = &x->data[x->used];
+    buf[0] = index;
+    memcpy(&buf[1], pdata, count);
+    x->used += 1 + count;
+
+    x->msgs[x->count++] = (struct i2c_msg){
+        .addr = address,
+        .flags = 0,
+        .len = (uint16_t)(1 + count),
+        .buf = buf,
+    };
+
+    x->bus->stats.bytes += I2C_WRITE_OVERHEAD + count;
+}
+
+static void append_read(xfer_t *x, uint8_t address, uint8_t index, uint8_t *pdata, int32_t count)
+{
+    // index write and data read behind a repeated start, in the same transaction
+    xfer_reserve(x, 2, 1);
+    x->data[x->used] = index;
+
+    x->msgs[x->count++] = (struct i2c_msg){
+        .addr = address,
+        .flags = 0,
+        .len = 1,
+        .buf = &x->data[x->used],
+    };
+    x->msgs[x->count++] = (struct i2c_msg){
+        .addr = address,
+        .flags = I2C_M_RD,
+        .len = (uint16_t)count,
+        .buf = pdata,
+    };
+    x->used += 1;
+
+    x->bus->stats.bytes += I2C_READ_OVERHEAD + count;
+}
+
+// multiplexer control byte in front of the transfer, for a device behind it on
+// another channel than the current one
+static void append_mux_select(xfer_t *x, uint8_t mux)
+{
+    VL53L0X_Bus_t *bus = x->bus;
+
+    if (mux == 0 || bus->mux_address == 0)
+        return;
+
+    x->mux = mux;
+    if (bus->mux_current == mux)
+    {
+        bus->stats.mux_selects_elided++;
+        return;
+    }
+
+    xfer_reserve(x, 1, 1);
+    x->data[x->used] = mux;
+    x->msgs[x->count++] = (struct i2c_msg){
+        .addr = bus->mux_address,
+        .flags = 0,
+        .len = 1,
+        .buf = &x->data[x->used],
+    };
+    x->used += 1;
+
+    // on that channel for the transfers behind this one
+    bus->mux_current = mux;
+    bus->stats.bytes += 2;
+    bus->stats.mux_switches++;
+}
+
+// prepend a 0xFF page select write, separated by a repeated start
+static void append_page_select(xfer_t *x, uint8_t address, uint8_t page)
+{
+    append_write(x, address, VL53L0X_PAGE_SELECT_INDEX, &page, 1);
+    x->bus->stats.page_writes_merged++;
+}
+
+// take the bus, then start the transaction with the channel and page selects
+static int begin(xfer_t *x, VL53L0X_Bus_t *bus, int8_t priority, uint8_t address, uint8_t mux,
+                 int16_t page, uint32_t timeout_us, uint32_t *pbytes)
+{
+    int err = adapter_take(bus, priority, timeout_us);
+
+    if (err != 0)
+        return err;
+
+    x->bus = bus;
+    x->count = 0;
+    x->used = 0;
+    x->mux = 0;
+    x->flushed = 0;
+    x->start = bus->stats.bytes;
+    x->pbytes = pbytes;
+    x->err = 0;
+
+    append_mux_select(x, mux);
+    if (page >= 0)
+        append_page_select(x, address, (uint8_t)page);
+
+    return 0;
+}
+
+static int32_t submit(xfer_t *x)
+{
+    xfer_flush(x);
+
+    // updated with the bus held, it only counts the transfers of its device
+    if (x->pbytes != NULL)
+        *x->pbytes += x->bus->stats.bytes - x->start;
+    adapter_give(x->bus);
+
+    return errno_to_vl53l0x_error(x->err);
+}
+
+static int32_t write_multi(VL53L0X_Bus_t *bus, int8_t priority, uint8_t address, uint8_t mux, int16_t page,
+                           uint8_t index, uint8_t *pdata, int32_t count, uint32_t timeout_us, uint32_t *pbytes)
+{
+    xfer_t x;
+    int err = begin(&x, bus, priority, address, mux, page, timeout_us, pbytes);
+
+    if (err != 0)
+        return errno_to_vl53l0x_error(err);
+
+    append_write(&x, address, index, pdata, count);
+
+    return submit(&x);
+}
+
+static int32_t read_multi(VL53L0X_Bus_t *bus, int8_t priority, uint8_t address, uint8_t mux, int16_t page,
+                          uint8_t index, uint8_t *pdata, int32_t count, uint32_t timeout_us, uint32_t *pbytes)
+{
+    xfer_t x;
+    int err = begin(&x, bus, priority, address, mux, page, timeout_us, pbytes);
+
+    if (err != 0)
+        return errno_to_vl53l0x_error(err);
+
+    append_read(&x, address, index, pdata, count);
+
+    return submit(&x);
+}
+
+int32_t VL53L0X_write_multi(uint8_t address, uint8_t index, uint8_t *pdata, int32_t count)
+{
+    return write_multi(bus_default(), VL53L0X_BUS_PRIORITY_NORMAL, address, 0, -1, index, pdata, count, 0, NULL);
+}
+
+int32_t VL53L0X_read_multi(uint8_t address, uint8_t index, uint8_t *pdata, int32_t count)
+{
+    return read_multi(bus_default(), VL53L0X_BUS_PRIORITY_NORMAL, address, 0, -1, index, pdata, count, 0, NULL);
+}
+
+int32_t VL53L0X_write_multi_ex(uint8_t address, int16_t page, uint8_t index, uint8_t *pdata, int32_t count, uint32_t timeout_us)
+{
+    return write_multi(bus_default(), VL53L0X_BUS_PRIORITY_NORMAL, address, 0, page, index, pdata, count, timeout_us, NULL);
+}
+
+int32_t VL53L0X_read_multi_ex(uint8_t address, int16_t page, uint8_t index, uint8_t *pdata, int32_t count, uint32_t timeout_us)
+{
+    return read_multi(bus_default(), VL53L0X_BUS_PRIORITY_NORMAL, address, 0, page, index, pdata, count, timeout_us, NULL);
+}
+
+static int32_t write_sequence(VL53L0X_Bus_t *bus, int8_t priority, uint8_t address, uint8_t mux, int16_t page,
+                              const uint8_t *pairs, int32_t count, uint32_t timeout_us, uint32_t *pbytes)
+{
+    xfer_t x;
+    int err = begin(&x, bus, priority, address, mux, page, timeout_us, pbytes);
+
+    if (err != 0)
+        return errno_to_vl53l0x_error(err);
+
+    // one message per register write
+    for (int i = 0; i < count; i++)
+        append_write(&x, address, pairs[2 * i], &pairs[2 * i + 1], 1);
+
+    return submit(&x);
+}
+
+int32_t VL53L0X_write_sequence(uint8_t address, const uint8_t *pairs, int32_t count)
+{
+    return write_sequence(bus_default(), VL53L0X_BUS_PRIORITY_NORMAL, address, 0, -1, pairs, count, 0, NULL);
+}
+
+int32_t VL53L0X_write_sequence_ex(uint8_t address, int16_t page, const uint8_t *pairs, int32_t count, uint32_t timeout_us)
+{
+    return write_sequence(bus_default(), VL53L0X_BUS_PRIORITY_NORMAL, address, 0, page, pairs, count, timeout_us, NULL);
+}
+
+static int32_t read_blocks(VL53L0X_Bus_t *bus, int8_t priority, uint8_t address, uint8_t mux, int16_t page,
+                           const VL53L0X_ReadBlock_t *blocks, int32_t count, uint32_t timeout_us, uint32_t *pbytes)
+{
+    xfer_t x;
+    int err = begin(&x, bus, priority, address, mux, page, timeout_us, pbytes);
+
+    if (err != 0)
+        return errno_to_vl53l0x_error(err);
+
+    for (int i = 0; i < count; i++)
+        append_read(&x, address, blocks[i].index, blocks[i].pdata, blocks[i].count);
+
+    return submit(&x);
+}
+
+int32_t VL53L0X_read_blocks(uint8_t address, const VL53L0X_ReadBlock_t *blocks, int32_t count)
+{
+    return read_blocks(bus_default(), VL53L0X_BUS_PRIORITY_NORMAL, address, 0, -1, blocks, count, 0, NULL);
+}
+
+int32_t VL53L0X_read_blocks_ex(uint8_t address, int16_t page, const VL53L0X_ReadBlock_t *blocks, int32_t count, uint32_t timeout_us)
+{
+    return read_blocks(bus_default(), VL53L0X_BUS_PRIORITY_NORMAL, address, 0, page, blocks, count, timeout_us, NULL);
+}
+
+/*
+ * i2c-dev transport of a device : its bus, address and multiplexer channel
+ */
+static int32_t linux_write_multi(VL53L0X_DEV Dev, int16_t page, uint8_t index, uint8_t *pdata, int32_t count, uint32_t timeout_us)
+{
+    return write_multi(dev_bus(Dev), Dev->BusPriority, Dev->I2cDevAddr, Dev->MuxMask, page, index, pdata, count, timeout_us, &Dev->BusBytes);
+}
+
+static int32_t linux_read_multi(VL53L0X_DEV Dev, int16_t page, uint8_t index, uint8_t *pdata, int32_t count, uint32_t timeout_us)
+{
+    return read_multi(dev_bus(Dev), Dev->BusPriority, Dev->I2cDevAddr, Dev->MuxMask, page, index, pdata, count, timeout_us, &Dev->BusBytes);
+}
+
+static int32_t linux_write_sequence(VL53L0X_DEV Dev, int16_t page, const uint8_t *pairs, int32_t count, uint32_t timeout_us)
+{
+    return write_sequence(dev_bus(Dev), Dev->BusPriority, Dev->I2cDevAddr, Dev->MuxMask, page, pairs, count, timeout_us, &Dev->BusBytes);
+}
+
+static int32_t linux_read_blocks(VL53L0X_DEV Dev, int16_t page, const VL53L0X_ReadBlock_t *blocks, int32_t count, uint32_t timeout_us)
+{
+    return read_blocks(dev_bus(Dev), Dev->BusPriority, Dev->I2cDevAddr, Dev->MuxMask, page, blocks, count, timeout_us, &Dev->BusBytes);
+}
+
+// transfers of several devices of the bus in one transaction, each one
+// behind the channel and page selects it needs
+static int32_t linux_batch(VL53L0X_Bus_t *bus, VL53L0X_Transfer_t *const *transfers, int32_t count, uint32_t timeout_us)
+{
+    VL53L0X_Transfer_t *t;
+    int8_t priority = VL53L0X_BUS_PRIORITY_LOW;
+    uint32_t flushed;
+    uint32_t start;
+    xfer_t x;
+    int sent = 0;
+    int err;
+    int i;
+
+    for (i = 0; i < count; i++)
+    {
+        if (transfers[i]->device->BusPriority > priority)
+            priority = transfers[i]->device->BusPriority;
+    }
+
+    err = begin(&x, bus, priority, 0, 0, -1, timeout_us, NULL);
+    if (err != 0)
+        return errno_to_vl53l0x_error(err);
+
+    for (i = 0; i < count; i++)
+    {
+        t = transfers[i];
+        flushed = x.flushed;
+        start = bus->stats.bytes;
+
+        append_mux_select(&x, t->device->MuxMask);
+        if (t->page >= 0)
+            append_page_select(&x, t->device->I2cDevAddr, (uint8_t)t->page);
+
+        if (t->write)
+            append_write(&x, t->device->I2cDevAddr, t->index, t->pdata, t->count);
+        else
+            append_read(&x, t->device->I2cDevAddr, t->index, t->pdata, t->count);
+        t->device->BusBytes += bus->stats.bytes - start;
+
+        // a transaction went out for room: the transfers in front of this
+        // one are through, whatever becomes of the next transactions
+        if (x.flushed != flushed)
+        {
+            for (; sent < i; sent++)
+                transfers[sent]->Status = VL53L0X_ERROR_NONE;
+        }
+    }
+
+    return submit(&x);
+}
+
+const VL53L0X_BusOps_t VL53L0X_LinuxBusOps = {
+    .write_multi = linux_write_multi,
+    .read_multi = linux_read_multi,
+    .write_sequence = linux_write_sequence,
+    .read_blocks = linux_read_blocks,
+    .batch = linux_batch,
+};
+
+int32_t VL53L0X_write_byte(uint8_t address, uint8_t index, uint8_t data)
+{
+    int32_t status = STATUS_OK;
+    const int32_t cbyte_count = 1;
+
+#ifdef VL53L0X_LOG_ENABLE
+    trace_print(TRACE_LEVEL_INFO, "Write reg : 0x%02X, Val : 0x%02X\n", index, data);
+#endif
+
+    status = VL53L0X_write_multi(address, index, &data, cbyte_count);
+
+    return status;
+}
+
+int32_t VL53L0X_write_word(uint8_t address, uint8_t index, uint16_t data)
+{
+    uint8_t buffer[BYTES_PER_WORD];
+
+    // Split 16-bit word into MS and LS uint8_t
+    buffer[0] = (uint8_t)(data >> 8);
+    buffer[1] = (uint8_t)(data & 0x00FF);
+
+    return VL53L0X_write_multi(address, index, buffer, BYTES_PER_WORD);
+}
+
+int32_t VL53L0X_write_dword(uint8_t address, uint8_t index, uint32_t data)
+{
+    uint8_t buffer[BYTES_PER_DWORD];
+
+    // Split 32-bit word into MS ... LS bytes
+    buffer[0] = (uint8_t)(data >> 24);
+    buffer[1] = (uint8_t)((data & 0x00FF0000) >> 16);
+    buffer[2] = (uint8_t)((data & 0x0000FF00) >> 8);
+    buffer[3] = (uint8_t)(data & 0x000000FF);
+
+    return VL53L0X_write_multi(address, index, buffer, BYTES_PER_DWORD);
+}
+
+int32_t VL53L0X_read_byte(uint8_t address, uint8_t index, uint8_t *pdata)
+{
+    int32_t status = STATUS_OK;
+    int32_t cbyte_count = 1;
+
+    status = VL53L0X_read_multi(address, index, pdata, cbyte_count);
+
+#ifdef VL53L0X_LOG_ENABLE
+    trace_print(TRACE_LEVEL_INFO, "Read reg : 0x%02X, Val : 0x%02X\n", index, *pdata);
+#endif
+
+    return status;
+}
+
+int32_t VL53L0X_read_word(uint8_t address, uint8_t index, uint16_t *pdata)
+{
+    int32_t status = STATUS_OK;
+    uint8_t buffer[BYTES_PER_WORD];
+
+    status = VL53L0X_read_multi(address, index, buffer, BYTES_PER_WORD);
+    *pdata = ((uint16_t)buffer[0] << 8) + (uint16_t)buffer[1];
+
+    return status;
+}
+
+int32_t VL53L0X_read_dword(uint8_t address, uint8_t index, uint32_t *pdata)
+{
+    int32_t status = STATUS_OK;
+    uint8_t buffer[BYTES_PER_DWORD];
+
+    status = VL53L0X_read_multi(address, index, buffer, BYTES_PER_DWORD);
+    *pdata = ((uint32_t)buffer[0] << 24) + ((uint32_t)buffer[1] << 16) + ((uint32_t)buffer[2] << 8) + (uint32_t)buffer[3];
+
+    return status;
+}
+
+int32_t VL53L0X_platform_wait_us(int32_t wait_us)
+{
+    struct timespec wait = {
+        .tv_sec = wait_us / 1000000,
+        .tv_nsec = (long)(wait_us % 1000000) * 1000,
+    };
+
+    while (nanosleep(&wait, &wait) != 0 && errno == EINTR)
+        ;
+    return STATUS_OK;
+}
+
+int32_t VL53L0X_wait_ms(int32_t wait_ms)
+{
+    return VL53L0X_platform_wait_us(wait_ms * 1000);
+}
+
+int32_t VL53L0X_set_gpio(uint8_t  level)
+{
+    (void)level;
+    return STATUS_OK;
+}
+
+int32_t VL53L0X_get_gpio(uint8_t *plevel)
+{
+    (void)plevel;
+    return STATUS_OK;
+}
+
+int32_t VL53L0X_release_gpio(void)
+{
+    return STATUS_OK;
+}
+
+int32_t VL53L0X_get_timer_frequency(int32_t *ptimer_freq_hz)
+{
+    *ptimer_freq_hz = 1000000;
+    return STATUS_OK;
+}
+
+int32_t VL53L0X_get_timer_value(int32_t *ptimer_count)
+{
+    // microseconds, wraps around
+    *ptimer_count = (int32_t)esp_timer_get_time();
+    return STATUS_OK;
+}
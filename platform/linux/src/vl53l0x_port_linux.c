@@ -0,0 +1,43 @@
+/*
+ * File : vl53l0x_port_linux.c
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#include <errno.h>
+#include <time.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+
+esp_log_level_t esp_log_level = ESP_LOG_INFO;
+
+void esp_log_level_set(const char *tag, esp_log_level_t level)
+{
+    (void)tag;
+    esp_log_level = level;
+}
+
+int64_t esp_timer_get_time(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    uint64_t ms = (uint64_t)ticks * portTICK_PERIOD_MS;
+    struct timespec wait = {
+        .tv_sec = (time_t)(ms / 1000),
+        .tv_nsec = (long)(ms % 1000) * 1000000,
+    };
+
+    while (nanosleep(&wait, &wait) != 0 && errno == EINTR)
+        ;
+}
@@ -0,0 +1,192 @@
+/*
+ * File : vl53l0x_sample_ring.c
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#include "vl53l0x_sample_ring.h"
+
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "esp_timer.h"
+
+// records start on their own cache line
+#define RING_HEADER_SIZE    64
+
+_Static_assert(sizeof(VL53L0X_SharedSample_t) == 32, "shared sample layout");
+_Static_assert(sizeof(VL53L0X_SampleRingHeader_t) <= RING_HEADER_SIZE, "shared header layout");
+
+static void ring_map(VL53L0X_SampleRing_t *ring, void *base, size_t size)
+{
+    ring->header = base;
+    ring->samples = (VL53L0X_SharedSample_t *)((uint8_t *)base + RING_HEADER_SIZE);
+    ring->size = size;
+    ring->next = 0;
+    ring->lost = 0;
+}
+
+VL53L0X_Error VL53L0X_SampleRing_create(VL53L0X_SampleRing_t *ring, const char *name, uint32_t records)
+{
+    VL53L0X_SampleRingHeader_t *header;
+    size_t size;
+    void *base;
+    int fd;
+
+    if (records == 0)
+        records = VL53L0X_SAMPLE_RING_RECORDS;
+    // one record would be overwritten while its readers copy it
+    if (records < 2 || (records & (records - 1)) != 0)
+        return VL53L0X_ERROR_INVALID_PARAMS;
+
+    // a fresh object : the readers of the previous one never see it reset
+    shm_unlink(name);
+    fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR | O_CLOEXEC, 0644);
+    if (fd < 0)
+        return VL53L0X_ERROR_UNDEFINED;
+
+    size = RING_HEADER_SIZE + (size_t)records * sizeof(VL53L0X_SharedSample_t);
+    if (ftruncate(fd, (off_t)size) != 0)
+    {
+        close(fd);
+        shm_unlink(name);
+        return VL53L0X_ERROR_UNDEFINED;
+    }
+
+    base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED)
+    {
+        shm_unlink(name);
+        return VL53L0X_ERROR_UNDEFINED;
+    }
+
+    // zero filled by ftruncate, the magic last
+    ring_map(ring, base, size);
+    header = ring->header;
+    header->version = VL53L0X_SAMPLE_RING_VERSION;
+    header->record_size = sizeof(VL53L0X_SharedSample_t);
+    header->records = records;
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    memcpy(header->magic, VL53L0X_SAMPLE_RING_MAGIC, sizeof(header->magic));
+
+    return VL53L0X_ERROR_NONE;
+}
+
+void VL53L0X_SampleRing_publish(VL53L0X_SampleRing_t *ring, uint16_t device,
+                                const VL53L0X_RangingMeasurementData_t *pRangingMeasurementData)
+{
+    VL53L0X_SampleRingHeader_t *header = ring->header;
+    uint32_t index = __atomic_fetch_add(&header->head, 1, __ATOMIC_RELAXED);
+    VL53L0X_SharedSample_t *s = &ring->samples[index & (header->records - 1)];
+
+    // any value but index + 1 while written
+    __atomic_store_n(&s->seq, index, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    s->device = device;
+    s->RangeStatus = pRangingMeasurementData->RangeStatus;
+    s->reserved = 0;
+    s->timestamp_us = esp_timer_get_time();
+    s->RangeMilliMeter = pRangingMeasurementData->RangeMilliMeter;
+    s->RangeDMaxMilliMeter = pRangingMeasurementData->RangeDMaxMilliMeter;
+    s->EffectiveSpadRtnCount = pRangingMeasurementData->EffectiveSpadRtnCount;
+    s->reserved2 = 0;
+    s->SignalRateRtnMegaCps = pRangingMeasurementData->SignalRateRtnMegaCps;
+    s->AmbientRateRtnMegaCps = pRangingMeasurementData->AmbientRateRtnMegaCps;
+
+    __atomic_store_n(&s->seq, index + 1, __ATOMIC_RELEASE);
+}
+
+VL53L0X_Error VL53L0X_SampleRing_open(VL53L0X_SampleRing_t *ring, const char *name)
+{
+    VL53L0X_SampleRingHeader_t *header;
+    struct stat st;
+    void *base;
+    int fd;
+
+    fd = shm_open(name, O_RDONLY | O_CLOEXEC, 0);
+    if (fd < 0)
+        return VL53L0X_ERROR_UNDEFINED;
+
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < RING_HEADER_SIZE)
+    {
+        close(fd);
+        return VL53L0X_ERROR_NOT_SUPPORTED;
+    }
+
+    base = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED)
+        return VL53L0X_ERROR_UNDEFINED;
+
+    ring_map(ring, base, (size_t)st.st_size);
+    header = ring->header;
+    if (memcmp(header->magic, VL53L0X_SAMPLE_RING_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != VL53L0X_SAMPLE_RING_VERSION ||
+        header->record_size != sizeof(VL53L0X_SharedSample_t) ||
+        header->records < 2 || (header->records & (header->records - 1)) != 0 ||
+        ring->size < RING_HEADER_SIZE + (size_t)header->records * sizeof(VL53L0X_SharedSample_t))
+    {
+        VL53L0X_SampleRing_close(ring);
+        return VL53L0X_ERROR_NOT_SUPPORTED;
+    }
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+    ring->next = __atomic_load_n(&header->head, __ATOMIC_ACQUIRE);
+    return VL53L0X_ERROR_NONE;
+}
+
+uint8_t VL53L0X_SampleRing_take(VL53L0X_SampleRing_t *ring, VL53L0X_SharedSample_t *psample)
+{
+    VL53L0X_SampleRingHeader_t *header = ring->header;
+    const VL53L0X_SharedSample_t *s;
+    uint32_t head;
+    uint32_t seq;
+
+    for (;;)
+    {
+        head = __atomic_load_n(&header->head, __ATOMIC_ACQUIRE);
+
+        // lapped by the publisher
+        if (head - ring->next > header->records)
+        {
+            ring->lost += head - ring->next - header->records;
+            ring->next = head - header->records;
+        }
+        if (ring->next == head)
+            return 0;
+
+        s = &ring->samples[ring->next & (header->records - 1)];
+        seq = __atomic_load_n(&s->seq, __ATOMIC_ACQUIRE);
+        if (seq != ring->next + 1)
+            return 0;
+
+        *psample = *s;
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        ring->next++;
+
+        // not overwritten while copied
+        if (__atomic_load_n(&s->seq, __ATOMIC_RELAXED) == seq)
+            return 1;
+        ring->lost++;
+    }
+}
+
+void VL53L0X_SampleRing_close(VL53L0X_SampleRing_t *ring)
+{
+    if (ring->header != NULL)
+        munmap(ring->header, ring->size);
+    ring->header = NULL;
+    ring->samples = NULL;
+}
+
+void VL53L0X_SampleRing_remove(const char *name)
+{
+    shm_unlink(name);
+}
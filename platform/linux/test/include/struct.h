@@ -0,0 +1,27 @@
+/*
+ * File : struct.h
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#ifndef VL53L0X_TEST_STRUCT_H_
+#define VL53L0X_TEST_STRUCT_H_
+
+/* application settings the driver reads, as the host tests provide them */
+
+enum {
+    PROXIMITY_CONFIGURATION__PROXIMITY_SENSITIVITY__PROXIMITY_OFF,
+    PROXIMITY_CONFIGURATION__PROXIMITY_SENSITIVITY__PROXIMITY_LOW,
+    PROXIMITY_CONFIGURATION__PROXIMITY_SENSITIVITY__PROXIMITY_MED,
+    PROXIMITY_CONFIGURATION__PROXIMITY_SENSITIVITY__PROXIMITY_HIGH,
+};
+
+typedef struct {
+    struct {
+        int sensitivity;
+    } proximity_config;
+} StructDeviceSettings;
+
+#endif // VL53L0X_TEST_STRUCT_H_
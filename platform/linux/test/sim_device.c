@@ -0,0 +1,303 @@
+/*
+ * File : sim_device.c
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#include "sim_device.h"
+
+#include <errno.h>
+#include <string.h>
+
+#include "vl53l0x_device.h"
+#include "esp_timer.h"
+
+#include "struct.h"
+
+// the application settings the driver filters with
+StructDeviceSettings dev_settings = {
+    .proximity_config.sensitivity = PROXIMITY_CONFIGURATION__PROXIMITY_SENSITIVITY__PROXIMITY_HIGH,
+};
+
+int sim_failures;
+
+#define NVM_PAGE            7
+#define REG_NVM_STROBE      0x83
+#define REG_NVM_ADDRESS     0x94
+#define REG_NVM_DATA        0x90
+#define REG_STOP_STATUS     0x04        // page 1, 0 once stopped
+
+void sim_init(sim_t *sim)
+{
+    memset(sim, 0, sizeof(*sim));
+    sim->fail_in = -1;
+}
+
+// registers and NVM at power on
+static void power_on(sim_device_t *d)
+{
+    memset(d->regs, 0, sizeof(d->regs));
+    memset(d->nvm, 0, sizeof(d->nvm));
+    d->page = 0;
+    d->index = 0;
+    d->nvm_address = 0;
+    d->ready_at = 0;
+    d->continuous = 0;
+
+    d->regs[0][VL53L0X_REG_IDENTIFICATION_MODEL_ID] = 0xEE;
+    d->regs[0][VL53L0X_REG_IDENTIFICATION_REVISION_ID] = 0x10;
+    d->regs[1][0x91] = 0x3C;            // stop variable
+
+    d->nvm[0x6b] = SIM_SPAD_INFO;
+    d->nvm[0x24] = 0xFFFFFFFF;
+    d->nvm[0x25] = 0xFFFFFFFF;
+}
+
+sim_device_t *sim_add(sim_t *sim, uint8_t address, uint8_t channel)
+{
+    sim_device_t *d;
+    int i;
+
+    if (sim->count == SIM_DEVICES_MAX)
+        return NULL;
+
+    d = &sim->devices[sim->count++];
+    memset(d, 0, sizeof(*d));
+    d->address = address;
+    d->channel = channel;
+    power_on(d);
+
+    for (i = 0; i < SIM_SPADS; i++)
+        d->spad_rate[i] = 0x0100;
+    d->range_mm = 300;
+
+    return d;
+}
+
+// sum of the rates of the SPADs enabled in the reference map
+static uint16_t reference_rate(const sim_device_t *d)
+{
+    uint32_t rate = 0;
+    int i;
+
+    for (i = 0; i < SIM_SPADS; i++)
+    {
+        if (d->regs[0][VL53L0X_REG_GLOBAL_CONFIG_SPAD_ENABLES_REF_0 + i / 8] & (1 << (i % 8)))
+            rate += d->spad_rate[i];
+    }
+
+    return rate > 0xFFFF ? 0xFFFF : (uint16_t)rate;
+}
+
+// result of the measurement in progress, until its interrupt is cleared
+static void measurement_complete(sim_device_t *d)
+{
+    uint8_t *r = d->regs[0];
+
+    d->ready_at = 0;
+    r[VL53L0X_REG_RESULT_INTERRUPT_STATUS] = VL53L0X_REG_SYSTEM_INTERRUPT_GPIO_NEW_SAMPLE_READY;
+    r[VL53L0X_REG_RESULT_RANGE_STATUS] = 11 << 3;     // range valid
+    r[VL53L0X_REG_RESULT_RANGE_STATUS + 2] = 0x20;    // 32 SPADs, 8.8
+    r[VL53L0X_REG_RESULT_RANGE_STATUS + 3] = 0x00;
+    r[VL53L0X_REG_RESULT_RANGE_STATUS + 6] = 0x0A;    // signal 20 MCPS, 9.7
+    r[VL53L0X_REG_RESULT_RANGE_STATUS + 7] = 0x00;
+    r[VL53L0X_REG_RESULT_RANGE_STATUS + 8] = 0x00;    // ambient
+    r[VL53L0X_REG_RESULT_RANGE_STATUS + 9] = 0x10;
+    r[VL53L0X_REG_RESULT_RANGE_STATUS + 10] = (uint8_t)(d->range_mm >> 8);
+    r[VL53L0X_REG_RESULT_RANGE_STATUS + 11] = (uint8_t)d->range_mm;
+}
+
+static void measurement_start(sim_device_t *d)
+{
+    if (!d->never_ready)
+        d->ready_at = esp_timer_get_time() + d->measure_us;
+}
+
+static uint8_t reg_read(sim_device_t *d, uint8_t index)
+{
+    uint16_t rate;
+
+    if (d->ready_at != 0 && esp_timer_get_time() >= d->ready_at)
+        measurement_complete(d);
+
+    if (d->page == NVM_PAGE && index == REG_NVM_STROBE)
+        return d->strobe_stuck ? 0x00 : 0x01;
+    if (d->page == NVM_PAGE && index >= REG_NVM_DATA && index < REG_NVM_DATA + 4)
+        return (uint8_t)(d->nvm[d->nvm_address] >> (8 * (3 - (index - REG_NVM_DATA))));
+
+    if (d->page == 0 && index == VL53L0X_REG_SYSRANGE_START)
+        return d->regs[0][index] & ~VL53L0X_REG_SYSRANGE_MODE_START_STOP;
+
+    if (d->page == 1 && index == REG_STOP_STATUS)
+        return 0x00;
+    if (d->page == 1 && (index == VL53L0X_REG_RESULT_PEAK_SIGNAL_RATE_REF ||
+                         index == VL53L0X_REG_RESULT_PEAK_SIGNAL_RATE_REF + 1))
+    {
+        rate = reference_rate(d);
+        return index == VL53L0X_REG_RESULT_PEAK_SIGNAL_RATE_REF ? (uint8_t)(rate >> 8) : (uint8_t)rate;
+    }
+
+    return d->regs[d->page][index];
+}
+
+static void reg_write(sim_device_t *d, uint8_t index, uint8_t value)
+{
+    if (d->logged < SIM_LOG_SIZE)
+        d->log[d->logged++] = (sim_write_t){ .page = d->page, .index = index, .value = value };
+
+    if (index == VL53L0X_PAGE_SELECT_INDEX)
+    {
+        d->page = value;
+        return;
+    }
+    d->regs[d->page][index] = value;
+
+    if (d->page == NVM_PAGE && index == REG_NVM_ADDRESS)
+        d->nvm_address = value;
+    if (d->page != 0)
+        return;
+
+    switch (index)
+    {
+    case VL53L0X_REG_SYSRANGE_START:
+        d->continuous = (value & (VL53L0X_REG_SYSRANGE_MODE_BACKTOBACK | VL53L0X_REG_SYSRANGE_MODE_TIMED)) != 0;
+        if (value & (VL53L0X_REG_SYSRANGE_MODE_START_STOP | VL53L0X_REG_SYSRANGE_MODE_BACKTOBACK |
+                     VL53L0X_REG_SYSRANGE_MODE_TIMED))
+            measurement_start(d);
+        else
+            d->ready_at = 0;
+        break;
+
+    case VL53L0X_REG_SYSTEM_INTERRUPT_CLEAR:
+        if (value & 0x01)
+        {
+            d->regs[0][VL53L0X_REG_RESULT_INTERRUPT_STATUS] = 0;
+            if (d->continuous)
+                measurement_start(d);
+        }
+        break;
+
+    case VL53L0X_REG_I2C_SLAVE_DEVICE_ADDRESS:
+        d->address = value & 0x7F;
+        break;
+
+    default:
+        break;
+    }
+}
+
+void sim_xshut(sim_device_t *device, uint8_t level)
+{
+    if (level && device->shutdown)
+    {
+        device->address = SIM_DEFAULT_ADDRESS;
+        power_on(device);
+    }
+    device->shutdown = !level;
+}
+
+static sim_device_t *find(sim_t *sim, uint16_t address)
+{
+    sim_device_t *d;
+    uint32_t i;
+
+    for (i = 0; i < sim->count; i++)
+    {
+        d = &sim->devices[i];
+        if (!d->shutdown && d->address == address && (d->channel == 0 || (d->channel & sim->mux)))
+            return d;
+    }
+
+    return NULL;
+}
+
+int sim_transfer(void *ctx, struct i2c_msg *msgs, uint32_t count)
+{
+    sim_t *sim = ctx;
+    struct i2c_msg *m;
+    sim_device_t *d;
+    uint32_t i;
+    int j;
+
+    sim->transfers++;
+    sim->messages += count;
+    if (count > sim->max_messages)
+        sim->max_messages = count;
+
+    for (i = 0; i < count; i++)
+    {
+        m = &msgs[i];
+
+        // the rest of the transaction is lost with the failed message
+        if (sim->fail_in == 0)
+        {
+            sim->fail_in = -1;
+            return EIO;
+        }
+        if (sim->fail_in > 0)
+            sim->fail_in--;
+
+        if (m->addr == SIM_MUX_ADDRESS)
+        {
+            if (m->flags & I2C_M_RD)
+                m->buf[0] = sim->mux;
+            else
+                sim->mux = m->buf[0];
+            continue;
+        }
+
+        d = find(sim, m->addr);
+        if (d == NULL)
+            return ENXIO;
+
+        if (m->flags & I2C_M_RD)
+        {
+            for (j = 0; j < m->len; j++)
+                m->buf[j] = reg_read(d, d->index++);
+        }
+        else if (m->len > 0)
+        {
+            d->index = m->buf[0];
+            for (j = 1; j < m->len; j++)
+                reg_write(d, d->index++, m->buf[j]);
+        }
+    }
+
+    return 0;
+}
+
+VL53L0X_Error sim_bus(sim_t *sim, VL53L0X_Bus_t *bus, VL53L0X_LinuxAdapter_t *adapter)
+{
+    adapter->transfer = sim_transfer;
+    adapter->ctx = sim;
+
+    return VL53L0X_LinuxBus_init(bus, adapter, SIM_MUX_ADDRESS);
+}
+
+void sim_log_reset(sim_device_t *device)
+{
+    device->logged = 0;
+}
+
+int sim_compare(const sim_device_t *a, const sim_device_t *b)
+{
+    int page;
+    int index;
+
+    for (page = 0; page < 2; page++)
+    {
+        for (index = 0; index < 256; index++)
+        {
+            if (a->regs[page][index] != b->regs[page][index])
+            {
+                printf("page %d register 0x%02X : 0x%02X and 0x%02X\n", page, index,
+                       a->regs[page][index], b->regs[page][index]);
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,146 @@
+/*
+ * File : sim_device.h
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#ifndef VL53L0X_SIM_DEVICE_H_
+#define VL53L0X_SIM_DEVICE_H_
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "vl53l0x_platform_linux.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Stand-in devices for the host tests, on the transfer hook of a Linux
+ * adapter: VL53L0X register maps behind a TCA9548A style multiplexer.
+ *
+ * A device models what the API and the driver poll or read back:
+ *  - the 0xFF page select and the auto incremented register index
+ *  - the NVM read strobe, page 7 (0x94 address, 0x83 strobe, 0x90-0x93 data)
+ *  - SYSRANGE_START, whose start bit reads back cleared, and a measurement
+ *    ready measure_us after its start, in the interrupt status (0x13) and the
+ *    result block (0x14) until the interrupt is cleared (0x0B)
+ *  - the reference return rate (page 1, 0xB6) of the enabled reference SPADs,
+ *    the sum of their spad_rate
+ *  - XSHUT: held in reset it does not answer, released it boots at its power
+ *    on state
+ * Every register write lands in the log of the device.
+ */
+
+#define SIM_DEVICES_MAX     4
+#define SIM_MUX_ADDRESS     0x70
+#define SIM_LOG_SIZE        4096
+#define SIM_SPADS           48
+#define SIM_DEFAULT_ADDRESS 0x29
+
+/** reference SPADs, 0x24/0x25 of the NVM as read by the API: all good */
+#define SIM_SPAD_INFO       0x8500      // NVM 0x6b : 5 aperture SPADs
+
+typedef struct {
+    uint8_t page;
+    uint8_t index;
+    uint8_t value;
+} sim_write_t;
+
+typedef struct {
+    uint8_t address;                    /*!< 7 bit */
+    uint8_t channel;                    /*!< multiplexer control byte selecting it, 0 : not behind it */
+
+    uint8_t regs[256][256];             /*!< [page][index] */
+    uint8_t page;
+    uint8_t index;
+    uint32_t nvm[256];
+    uint8_t nvm_address;
+
+    uint16_t spad_rate[SIM_SPADS];      /*!< reference return rate of each SPAD, 9.7 MCPS */
+    uint16_t range_mm;                  /*!< of the measurements */
+    uint32_t measure_us;                /*!< start to result */
+    uint8_t strobe_stuck;               /*!< the NVM strobe never rises */
+    uint8_t never_ready;                /*!< measurements never complete */
+    uint8_t shutdown;                   /*!< held in reset by XSHUT */
+
+    int64_t ready_at;                   /*!< end of the measurement in progress, 0 : none */
+    uint8_t continuous;
+
+    sim_write_t log[SIM_LOG_SIZE];
+    uint32_t logged;
+} sim_device_t;
+
+typedef struct {
+    sim_device_t devices[SIM_DEVICES_MAX];
+    uint32_t count;
+    uint8_t mux;                        /*!< control byte of the multiplexer */
+
+    uint32_t transfers;                 /*!< calls of the transfer hook */
+    uint32_t messages;
+    uint32_t max_messages;              /*!< of one transfer */
+    int32_t fail_in;                    /*!< messages before a failed one, -1 : none */
+} sim_t;
+
+void sim_init(sim_t *sim);
+
+/**
+ * Device at its power on state.
+ * @param   channel multiplexer control byte selecting it, 0 : not behind it
+ */
+sim_device_t *sim_add(sim_t *sim, uint8_t address, uint8_t channel);
+
+/**
+ * XSHUT of a device: 0 holds it in reset, 1 releases it at its power on
+ * state, SIM_DEFAULT_ADDRESS. The measurement settings of the test are kept.
+ */
+void sim_xshut(sim_device_t *device, uint8_t level);
+
+/**
+ * Bus on the devices, the multiplexer at SIM_MUX_ADDRESS.
+ */
+VL53L0X_Error sim_bus(sim_t *sim, VL53L0X_Bus_t *bus, VL53L0X_LinuxAdapter_t *adapter);
+
+/** VL53L0X_LinuxTransferFn of the devices, ctx the sim_t */
+int sim_transfer(void *ctx, struct i2c_msg *msgs, uint32_t count);
+
+/** writes logged since the previous call */
+void sim_log_reset(sim_device_t *device);
+
+/**
+ * Check the register maps of two devices are the same, page 0 and 1.
+ * @return  0 if so, prints the first difference otherwise
+ */
+int sim_compare(const sim_device_t *a, const sim_device_t *b);
+
+/*
+ * Checks of the tests: a failed check prints and counts, main returns the
+ * count.
+ */
+extern int sim_failures;
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            sim_failures++; \
+        } \
+    } while (0)
+
+#define CHECK_STATUS(expr, expected) \
+    do { \
+        VL53L0X_Error check_status_ = (expr); \
+        if (check_status_ != (expected)) { \
+            printf("%s:%d: %s : status %d, expected %d\n", __FILE__, __LINE__, #expr, \
+                   check_status_, (expected)); \
+            sim_failures++; \
+        } \
+    } while (0)
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+#endif // VL53L0X_SIM_DEVICE_H_
@@ -0,0 +1,178 @@
+/*
+ * File : test_deadline.c
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#include <string.h>
+#include <unistd.h>
+
+#include "esp_timer.h"
+
+#include "vl53l0x.h"
+#include "vl53l0x_api.h"
+#include "vl53l0x_ranging.h"
+#include "vl53l0x_platform_linux.h"
+#include "sim_device.h"
+
+/*
+ * Deadline bounded calls on devices that never answer: each returns
+ * VL53L0X_ERROR_TIME_OUT shortly after its deadline instead of after the
+ * API loop limits, and the next call picks up where it stopped.
+ */
+
+#define DEADLINE_US     20000
+#define CUT_US          5000
+#define EARLY_US        1000        // before it, a sleep cut to the time left rounds down to the tick
+#define LATE_US         10000       // past it, allowed for the call in progress
+#define WIRE_US         100         // a short transaction at 400 kHz
+
+static sim_t sim;
+static VL53L0X_LinuxAdapter_t adapter;
+static VL53L0X_Bus_t bus;
+static VL53L0X_Dev_t dev[3];
+
+// sim_transfer, taking the time of the transaction on the wire
+static int wire_transfer(void *ctx, struct i2c_msg *msgs, uint32_t count)
+{
+    usleep(WIRE_US);
+    return sim_transfer(ctx, msgs, count);
+}
+
+static int64_t elapsed_since(int64_t start)
+{
+    return esp_timer_get_time() - start;
+}
+
+static int near_deadline(int64_t elapsed, int64_t deadline)
+{
+    return elapsed + EARLY_US >= deadline && elapsed < deadline + LATE_US;
+}
+
+// next logged write after *i other than a page select, NULL if none
+static const sim_write_t *next_write(const sim_device_t *d, uint32_t *i)
+{
+    while (*i < d->logged && d->log[*i].index == 0xFF)
+        (*i)++;
+    return *i < d->logged ? &d->log[(*i)++] : NULL;
+}
+
+static void test_setup(void)
+{
+    sim_device_t *d = &sim.devices[0];
+    VL53L0X_SetupStep_t step = VL53L0X_SETUP_START;
+    const sim_write_t *w;
+    uint32_t i = 0;
+    int64_t start;
+    int64_t elapsed;
+
+    // the NVM strobe is polled by the static init
+    d->strobe_stuck = 1;
+    start = esp_timer_get_time();
+    CHECK_STATUS(VL53L0X_Device_setupUntil(&dev[0], &step, start + DEADLINE_US), VL53L0X_ERROR_TIME_OUT);
+    elapsed = elapsed_since(start);
+    printf("stuck NVM strobe: setup stopped after %lld us, step %d\n", (long long)elapsed, step);
+    CHECK(near_deadline(elapsed, DEADLINE_US));
+    CHECK(step == VL53L0X_SETUP_DATA_INIT);
+    // a fresh start has no private registers to close
+    w = next_write(d, &i);
+    CHECK(w != NULL && w->index != 0x00);
+
+    // resumed after the completed step, the private registers closed first
+    d->strobe_stuck = 0;
+    sim_log_reset(d);
+    i = 0;
+    CHECK_STATUS(VL53L0X_Device_setupUntil(&dev[0], &step, 0), VL53L0X_ERROR_NONE);
+    CHECK(step == VL53L0X_SETUP_DONE);
+    w = next_write(d, &i);
+    CHECK(w != NULL && w->page == 1 && w->index == 0x00 && w->value == 0x01);
+    w = next_write(d, &i);
+    CHECK(w != NULL && w->page == 0 && w->index == 0x80 && w->value == 0x00);
+}
+
+static void test_measurement(void)
+{
+    sim_device_t *d = &sim.devices[1];
+    uint16_t range;
+    int64_t start;
+    int64_t elapsed;
+
+    CHECK_STATUS(VL53L0X_Device_init(&dev[1]), VL53L0X_ERROR_NONE);
+    CHECK_STATUS(VL53L0X_Device_getMeasurement(&dev[1], &range), VL53L0X_ERROR_NONE);
+    CHECK(range == d->range_mm);
+
+    // the restarted measurement never completes
+    d->never_ready = 1;
+    d->ready_at = 0;
+    d->regs[0][VL53L0X_REG_RESULT_INTERRUPT_STATUS] = 0;
+
+    start = esp_timer_get_time();
+    CHECK_STATUS(VL53L0X_Device_getMeasurementUntil(&dev[1], &range, start + DEADLINE_US),
+                 VL53L0X_ERROR_TIME_OUT);
+    elapsed = elapsed_since(start);
+    printf("never ready: measurement given up after %lld us\n", (long long)elapsed);
+    CHECK(near_deadline(elapsed, DEADLINE_US));
+}
+
+static void test_single_shot(void)
+{
+    sim_device_t *d = &sim.devices[2];
+    VL53L0X_SingleShot_t ss;
+    VL53L0X_RangingMeasurementData_t data;
+    uint32_t starts;
+    uint32_t i;
+    int64_t start;
+    int64_t elapsed;
+
+    CHECK_STATUS(VL53L0X_Device_setup(&dev[2]), VL53L0X_ERROR_NONE);
+    CHECK_STATUS(VL53L0X_SingleShot_prepare(&ss, &dev[2]), VL53L0X_ERROR_NONE);
+    d->measure_us = 30000;
+    sim_log_reset(d);
+
+    // cut off before the result
+    start = esp_timer_get_time();
+    CHECK_STATUS(VL53L0X_SingleShot_measureUntil(&ss, &data, start + CUT_US), VL53L0X_ERROR_TIME_OUT);
+    elapsed = elapsed_since(start);
+    printf("single shot cut off after %lld us\n", (long long)elapsed);
+    CHECK(near_deadline(elapsed, CUT_US));
+    CHECK(ss.started);
+
+    // the next call collects the measurement in flight
+    CHECK_STATUS(VL53L0X_SingleShot_measureUntil(&ss, &data, esp_timer_get_time() + 10 * DEADLINE_US),
+                 VL53L0X_ERROR_NONE);
+    CHECK(!ss.started);
+    CHECK(data.RangeMilliMeter == d->range_mm);
+
+    starts = 0;
+    for (i = 0; i < d->logged; i++)
+    {
+        if (d->log[i].page == 0 && d->log[i].index == VL53L0X_REG_SYSRANGE_START &&
+            (d->log[i].value & VL53L0X_REG_SYSRANGE_MODE_START_STOP))
+            starts++;
+    }
+    CHECK(starts == 1);
+}
+
+int main(void)
+{
+    int i;
+
+    sim_init(&sim);
+    for (i = 0; i < 3; i++)
+    {
+        sim_add(&sim, (uint8_t)(0x29 + i), 0);
+        dev[i].I2cDevAddr = (uint8_t)(0x29 + i);
+    }
+    CHECK_STATUS(sim_bus(&sim, &bus, &adapter), VL53L0X_ERROR_NONE);
+    adapter.transfer = wire_transfer;
+    for (i = 0; i < 3; i++)
+        dev[i].Bus = &bus;
+
+    test_setup();
+    test_measurement();
+    test_single_shot();
+
+    return sim_failures;
+}
@@ -0,0 +1,111 @@
+/*
+ * File : test_lowpower.c
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include "vl53l0x.h"
+#include "vl53l0x_lowpower.h"
+#include "vl53l0x_platform_linux.h"
+#include "sim_device.h"
+
+/*
+ * Bus bytes of the low power samples: a device of its own bus, another
+ * device of that bus read by a thread meanwhile. The samples are charged
+ * with the bytes of their device only.
+ */
+
+#define SAMPLES 20
+
+static sim_t sim;
+static VL53L0X_LinuxAdapter_t adapter;
+static VL53L0X_Bus_t bus;
+static VL53L0X_Dev_t dev[2];
+static VL53L0X_LowPower_t lp;
+
+static volatile int running;
+static uint32_t other_reads;
+
+static void *other_traffic(void *arg)
+{
+    uint8_t model;
+
+    (void)arg;
+    while (running)
+    {
+        if (VL53L0X_RdByte(&dev[1], VL53L0X_REG_IDENTIFICATION_MODEL_ID, &model) == VL53L0X_ERROR_NONE)
+            __atomic_add_fetch(&other_reads, 1, __ATOMIC_SEQ_CST);
+    }
+
+    return NULL;
+}
+
+int main(void)
+{
+    const VL53L0X_LowPowerConfig_t config = { 20000, 30 };
+    VL53L0X_EnergyEstimate_t estimate;
+    VL53L0X_BusStats_t stats;
+    pthread_t thread;
+    uint32_t sample_bytes;
+    uint16_t range;
+    int i;
+
+    sim_init(&sim);
+    sim_add(&sim, 0x29, 1 << 0)->range_mm = 300;
+    sim_add(&sim, 0x29, 1 << 1)->range_mm = 420;
+    CHECK_STATUS(sim_bus(&sim, &bus, &adapter), VL53L0X_ERROR_NONE);
+
+    for (i = 0; i < 2; i++)
+    {
+        dev[i].Bus = &bus;
+        dev[i].MuxMask = 1 << i;
+    }
+    CHECK_STATUS(VL53L0X_LowPower_init(&lp, &dev[0], &config), VL53L0X_ERROR_NONE);
+    CHECK_STATUS(VL53L0X_Device_init(&dev[1]), VL53L0X_ERROR_NONE);
+
+    // alone on the bus, the sample costs what the bus carried
+    VL53L0X_Bus_resetStats(&bus);
+    CHECK_STATUS(VL53L0X_LowPower_getMeasurement(&lp, &range), VL53L0X_ERROR_NONE);
+    CHECK(range == 300);
+    VL53L0X_Bus_getStats(&bus, &stats);
+    sample_bytes = lp.bus_bytes;
+    CHECK(sample_bytes > 0);
+    CHECK(sample_bytes == stats.bytes);
+
+    // another device busy on the same bus
+    VL53L0X_Bus_resetStats(&bus);
+    dev[0].BusBytes = 0;
+    dev[1].BusBytes = 0;
+    lp.samples = 0;
+    lp.bus_bytes = 0;
+
+    running = 1;
+    pthread_create(&thread, NULL, other_traffic, NULL);
+    while (__atomic_load_n(&other_reads, __ATOMIC_SEQ_CST) == 0)
+        sched_yield();
+    for (i = 0; i < SAMPLES; i++)
+    {
+        CHECK_STATUS(VL53L0X_LowPower_getMeasurement(&lp, &range), VL53L0X_ERROR_NONE);
+        CHECK(range == 300);
+    }
+    running = 0;
+    pthread_join(thread, NULL);
+
+    // every byte of the bus belongs to one device
+    VL53L0X_Bus_getStats(&bus, &stats);
+    CHECK(dev[1].BusBytes > 0);
+    CHECK(dev[0].BusBytes + dev[1].BusBytes == stats.bytes);
+    CHECK(lp.samples == SAMPLES);
+    CHECK(lp.bus_bytes == dev[0].BusBytes);
+
+    VL53L0X_LowPower_estimateEnergy(&lp, &estimate);
+    CHECK(estimate.BusBytesPerSample == lp.bus_bytes / SAMPLES);
+
+    return sim_failures;
+}
@@ -0,0 +1,158 @@
+/*
+ * File : test_measurement.c
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#include <string.h>
+
+#include "vl53l0x.h"
+#include "vl53l0x_api.h"
+#include "vl53l0x_measurement.h"
+#include "vl53l0x_platform_linux.h"
+#include "sim_device.h"
+
+/*
+ * VL53L0X_Measurement_start / _stop against VL53L0X_StartMeasurement /
+ * VL53L0X_StopMeasurement: two devices in the same state, one driven by
+ * each. Without threshold settings the register writes are the same, with
+ * them the registers end up the same.
+ */
+
+#define CYCLES  3
+
+static sim_t sim;
+static VL53L0X_LinuxAdapter_t adapter;
+static VL53L0X_Bus_t bus;
+static VL53L0X_Dev_t devices[2];
+
+static sim_device_t *st_sim;
+static sim_device_t *burst_sim;
+
+// same logged writes, page selects aside
+static int same_writes(const sim_device_t *a, const sim_device_t *b)
+{
+    uint32_t i = 0;
+    uint32_t j = 0;
+
+    while (1)
+    {
+        while (i < a->logged && a->log[i].index == VL53L0X_PAGE_SELECT_INDEX)
+            i++;
+        while (j < b->logged && b->log[j].index == VL53L0X_PAGE_SELECT_INDEX)
+            j++;
+        if (i == a->logged || j == b->logged)
+            return i == a->logged && j == b->logged;
+
+        if (memcmp(&a->log[i], &b->log[j], sizeof(a->log[i])) != 0)
+        {
+            printf("write %u : page %u 0x%02X = 0x%02X, write %u : page %u 0x%02X = 0x%02X\n",
+                   i, a->log[i].page, a->log[i].index, a->log[i].value,
+                   j, b->log[j].page, b->log[j].index, b->log[j].value);
+            return 0;
+        }
+        i++;
+        j++;
+    }
+}
+
+static void configure(VL53L0X_DeviceModes mode, VL53L0X_GpioFunctionality functionality)
+{
+    int i;
+
+    for (i = 0; i < 2; i++)
+    {
+        CHECK_STATUS(VL53L0X_SetDeviceMode(&devices[i], mode), VL53L0X_ERROR_NONE);
+        CHECK_STATUS(VL53L0X_SetGpioConfig(&devices[i], 0, mode, functionality,
+                                           VL53L0X_INTERRUPTPOLARITY_LOW), VL53L0X_ERROR_NONE);
+        CHECK_STATUS(VL53L0X_SetInterruptThresholds(&devices[i], mode, 100 << 16, 300 << 16),
+                     VL53L0X_ERROR_NONE);
+    }
+
+    sim_log_reset(st_sim);
+    sim_log_reset(burst_sim);
+}
+
+static void test_single(void)
+{
+    configure(VL53L0X_DEVICEMODE_SINGLE_RANGING, VL53L0X_GPIOFUNCTIONALITY_NEW_MEASURE_READY);
+
+    CHECK_STATUS(VL53L0X_StartMeasurement(&devices[0]), VL53L0X_ERROR_NONE);
+    CHECK_STATUS(VL53L0X_Measurement_start(&devices[1]), VL53L0X_ERROR_NONE);
+
+    // the stop variable goes to 0x91 of page 1
+    CHECK(same_writes(st_sim, burst_sim));
+    CHECK(burst_sim->regs[1][0x91] == PALDevDataGet((&devices[1]), StopVariable));
+    CHECK(sim_compare(st_sim, burst_sim) == 0);
+}
+
+static void test_continuous(void)
+{
+    configure(VL53L0X_DEVICEMODE_CONTINUOUS_RANGING, VL53L0X_GPIOFUNCTIONALITY_NEW_MEASURE_READY);
+
+    CHECK_STATUS(VL53L0X_StartMeasurement(&devices[0]), VL53L0X_ERROR_NONE);
+    CHECK_STATUS(VL53L0X_Measurement_start(&devices[1]), VL53L0X_ERROR_NONE);
+    CHECK_STATUS(VL53L0X_StopMeasurement(&devices[0]), VL53L0X_ERROR_NONE);
+    CHECK_STATUS(VL53L0X_Measurement_stop(&devices[1]), VL53L0X_ERROR_NONE);
+
+    CHECK(same_writes(st_sim, burst_sim));
+    CHECK(sim_compare(st_sim, burst_sim) == 0);
+}
+
+static void test_thresholds(void)
+{
+    uint32_t st_submissions = 0;
+    uint32_t burst_submissions = 0;
+    uint32_t transfers;
+    int cycle;
+
+    configure(VL53L0X_DEVICEMODE_CONTINUOUS_RANGING, VL53L0X_GPIOFUNCTIONALITY_THRESHOLD_CROSSED_OUT);
+
+    for (cycle = 0; cycle < CYCLES; cycle++)
+    {
+        transfers = sim.transfers;
+        CHECK_STATUS(VL53L0X_StartMeasurement(&devices[0]), VL53L0X_ERROR_NONE);
+        CHECK_STATUS(VL53L0X_StopMeasurement(&devices[0]), VL53L0X_ERROR_NONE);
+        st_submissions += sim.transfers - transfers;
+
+        transfers = sim.transfers;
+        CHECK_STATUS(VL53L0X_Measurement_start(&devices[1]), VL53L0X_ERROR_NONE);
+        CHECK_STATUS(VL53L0X_Measurement_stop(&devices[1]), VL53L0X_ERROR_NONE);
+        burst_submissions += sim.transfers - transfers;
+
+        // the threshold settings are loaded once, then only resumed
+        CHECK(memcmp(st_sim->regs, burst_sim->regs, sizeof(st_sim->regs)) == 0);
+    }
+
+    printf("%d threshold start / stop cycles: %u submissions, %u in bursts\n", CYCLES,
+           st_submissions, burst_submissions);
+    CHECK(burst_submissions < st_submissions);
+}
+
+int main(void)
+{
+    int i;
+
+    sim_init(&sim);
+    st_sim = sim_add(&sim, 0x29, 0);
+    burst_sim = sim_add(&sim, 0x2A, 0);
+    CHECK_STATUS(sim_bus(&sim, &bus, &adapter), VL53L0X_ERROR_NONE);
+
+    for (i = 0; i < 2; i++)
+    {
+        devices[i].Bus = &bus;
+        devices[i].I2cDevAddr = sim.devices[i].address;
+        CHECK_STATUS(VL53L0X_Device_setup(&devices[i]), VL53L0X_ERROR_NONE);
+        // no measurement completes: the result registers stay as they are
+        sim.devices[i].measure_us = 1000000;
+    }
+    CHECK(sim_compare(st_sim, burst_sim) == 0);
+
+    test_single();
+    test_continuous();
+    test_thresholds();
+
+    return sim_failures;
+}
@@ -0,0 +1,109 @@
+/*
+ * File : test_measurements.c
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#include <string.h>
+
+#include "vl53l0x.h"
+#include "vl53l0x_platform_linux.h"
+#include "sim_device.h"
+
+/*
+ * VL53L0X_Device_getMeasurements with a device in the middle of the group
+ * not answering: the samples of the others are collected and cleared, the
+ * failed one is neither reported nor cleared.
+ */
+
+#define DEVICES     4
+#define FAILING     2
+
+static sim_t sim;
+static VL53L0X_LinuxAdapter_t adapter;
+static VL53L0X_Bus_t bus;
+static VL53L0X_Dev_t devices[DEVICES];
+
+// every transfer fails at the first message to the failing device
+static int failing_transfer(void *ctx, struct i2c_msg *msgs, uint32_t count)
+{
+    uint32_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        if (msgs[i].addr == sim.devices[FAILING].address)
+        {
+            sim.fail_in = (int32_t)i;
+            break;
+        }
+    }
+
+    return sim_transfer(ctx, msgs, count);
+}
+
+static uint32_t interrupt_clears(const sim_device_t *d)
+{
+    uint32_t clears = 0;
+    uint32_t n;
+
+    for (n = 0; n < d->logged; n++)
+    {
+        if (d->log[n].page == 0 && d->log[n].index == VL53L0X_REG_SYSTEM_INTERRUPT_CLEAR)
+            clears++;
+    }
+
+    return clears;
+}
+
+int main(void)
+{
+    uint16_t data[DEVICES];
+    uint32_t ready;
+    int i;
+
+    sim_init(&sim);
+    for (i = 0; i < DEVICES; i++)
+    {
+        sim_add(&sim, 0x29 + i, 0)->range_mm = 300 + 10 * i;
+        // a new sample as soon as the previous one is cleared
+        sim.devices[i].measure_us = 0;
+    }
+    CHECK_STATUS(sim_bus(&sim, &bus, &adapter), VL53L0X_ERROR_NONE);
+
+    for (i = 0; i < DEVICES; i++)
+    {
+        devices[i].Bus = &bus;
+        devices[i].I2cDevAddr = sim.devices[i].address;
+        CHECK_STATUS(VL53L0X_Device_init(&devices[i]), VL53L0X_ERROR_NONE);
+        sim_log_reset(&sim.devices[i]);
+    }
+
+    memset(data, 0xFF, sizeof(data));
+    adapter.transfer = failing_transfer;
+    CHECK_STATUS(VL53L0X_Device_getMeasurements(devices, DEVICES, data, &ready), VL53L0X_ERROR_CONTROL_INTERFACE);
+    adapter.transfer = sim_transfer;
+    sim.fail_in = -1;
+
+    CHECK(ready == ((1UL << DEVICES) - 1 - (1UL << FAILING)));
+    for (i = 0; i < DEVICES; i++)
+    {
+        if (i == FAILING)
+        {
+            CHECK(data[i] == 0xFFFF);
+            CHECK(interrupt_clears(&sim.devices[i]) == 0);
+            continue;
+        }
+        CHECK(data[i] == 300 + 10 * i);
+        CHECK(interrupt_clears(&sim.devices[i]) == 2);
+    }
+
+    // answering again, its sample is still there
+    CHECK_STATUS(VL53L0X_Device_getMeasurements(devices, DEVICES, data, &ready), VL53L0X_ERROR_NONE);
+    CHECK(ready == (1UL << DEVICES) - 1);
+    for (i = 0; i < DEVICES; i++)
+        CHECK(data[i] == 300 + 10 * i);
+
+    return sim_failures;
+}
@@ -0,0 +1,90 @@
+/*
+ * File : test_page.c
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#include <string.h>
+
+#include "vl53l0x.h"
+#include "vl53l0x_api.h"
+#include "vl53l0x_platform_linux.h"
+#include "sim_device.h"
+
+/*
+ * Page select tracking: bus submissions of the API calls, against the ones
+ * they would take with every 0xFF write sent on its own. Each page select
+ * the API issues is either dropped or merged into the next access.
+ */
+
+static sim_t sim;
+static VL53L0X_LinuxAdapter_t adapter;
+static VL53L0X_Bus_t bus;
+static VL53L0X_Dev_t dev;
+
+typedef struct {
+    uint32_t submissions;
+    uint32_t unmerged;      /*!< submissions with a page select on its own */
+} count_t;
+
+static void count_start(void)
+{
+    VL53L0X_Bus_resetStats(&bus);
+}
+
+static count_t count_end(const char *what)
+{
+    VL53L0X_BusStats_t stats;
+    count_t count;
+
+    VL53L0X_Bus_getStats(&bus, &stats);
+    count.submissions = stats.transactions;
+    count.unmerged = stats.transactions + stats.page_writes_merged + stats.page_writes_elided;
+    printf("%-32s %4u submissions, %4u with unmerged page selects\n", what,
+           count.submissions, count.unmerged);
+
+    CHECK(count.submissions == sim.transfers);
+    sim.transfers = 0;
+
+    return count;
+}
+
+int main(void)
+{
+    uint32_t stop_completed;
+    count_t count;
+
+    sim_init(&sim);
+    sim_add(&sim, 0x29, 0);
+    CHECK_STATUS(sim_bus(&sim, &bus, &adapter), VL53L0X_ERROR_NONE);
+    dev.Bus = &bus;
+
+    count_start();
+    CHECK_STATUS(VL53L0X_Device_setup(&dev), VL53L0X_ERROR_NONE);
+    count = count_end("VL53L0X_Device_setup");
+    CHECK(count.submissions < count.unmerged);
+
+    CHECK_STATUS(VL53L0X_SetDeviceMode(&dev, VL53L0X_DEVICEMODE_SINGLE_RANGING), VL53L0X_ERROR_NONE);
+
+    // 0x80, 0xFF, 0x00, 0x91, 0x00, 0xFF, 0x80, SYSRANGE_START, its poll
+    count_start();
+    CHECK_STATUS(VL53L0X_StartMeasurement(&dev), VL53L0X_ERROR_NONE);
+    count = count_end("VL53L0X_StartMeasurement");
+    CHECK(count.unmerged == 9);
+    CHECK(count.submissions == 7);
+
+    // 0xFF, 0x04 read, 0xFF, then the stop variable sequence
+    count_start();
+    CHECK_STATUS(VL53L0X_GetStopCompletedStatus(&dev, &stop_completed), VL53L0X_ERROR_NONE);
+    count = count_end("VL53L0X_GetStopCompletedStatus");
+    CHECK(stop_completed == 0);
+    CHECK(count.unmerged == 10);
+    CHECK(count.submissions == 6);
+
+    // same register writes as without the tracking
+    CHECK(sim.devices[0].page == 0);
+
+    return sim_failures;
+}
@@ -0,0 +1,101 @@
+/*
+ * File : test_params.c
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include "vl53l0x.h"
+#include "vl53l0x_api.h"
+#include "vl53l0x_params.h"
+#include "vl53l0x_platform_linux.h"
+#include "sim_device.h"
+
+/*
+ * VL53L0X_Params_get against VL53L0X_GetDeviceParameters: two devices with
+ * the same register map and device data, one read by each. The parameters,
+ * the status and the device data after the call must be the same.
+ */
+
+#define IMAGES  200
+
+static sim_t sim;
+static VL53L0X_LinuxAdapter_t adapter;
+static VL53L0X_Bus_t bus;
+static VL53L0X_Dev_t st;
+static VL53L0X_Dev_t burst;
+
+// both devices, and their register maps, the same
+static void same_devices(void)
+{
+    memcpy(sim.devices[1].regs, sim.devices[0].regs, sizeof(sim.devices[0].regs));
+    sim.devices[1].page = sim.devices[0].page;
+
+    burst = st;
+    burst.I2cDevAddr = sim.devices[1].address;
+}
+
+// read both, return the submissions of each
+static void compare(uint32_t *pst_submissions, uint32_t *pburst_submissions)
+{
+    VL53L0X_DeviceParameters_t st_params;
+    VL53L0X_DeviceParameters_t burst_params;
+    VL53L0X_Error st_status;
+    VL53L0X_Error burst_status;
+
+    memset(&st_params, 0, sizeof(st_params));
+    memset(&burst_params, 0, sizeof(burst_params));
+
+    sim.transfers = 0;
+    st_status = VL53L0X_GetDeviceParameters(&st, &st_params);
+    *pst_submissions = sim.transfers;
+
+    sim.transfers = 0;
+    burst_status = VL53L0X_Params_get(&burst, &burst_params);
+    *pburst_submissions = sim.transfers;
+
+    CHECK(st_status == burst_status);
+    CHECK(memcmp(&st_params, &burst_params, sizeof(st_params)) == 0);
+    CHECK(memcmp(&st.Data, &burst.Data, sizeof(st.Data)) == 0);
+}
+
+int main(void)
+{
+    uint32_t st_submissions;
+    uint32_t burst_submissions;
+    int image;
+    int i;
+
+    sim_init(&sim);
+    sim_add(&sim, 0x29, 0);
+    sim_add(&sim, 0x2A, 0);
+    CHECK_STATUS(sim_bus(&sim, &bus, &adapter), VL53L0X_ERROR_NONE);
+
+    st.Bus = &bus;
+    st.I2cDevAddr = 0x29;
+    CHECK_STATUS(VL53L0X_Device_setup(&st), VL53L0X_ERROR_NONE);
+
+    // configuration after the setup
+    same_devices();
+    compare(&st_submissions, &burst_submissions);
+    printf("default configuration: %u submissions, %u in a burst\n", st_submissions, burst_submissions);
+    CHECK(burst_submissions == 1);
+    CHECK(st_submissions > burst_submissions);
+
+    // any register values, the device data of the previous round
+    srand(1);
+    for (image = 0; image < IMAGES; image++)
+    {
+        for (i = 0; i < 256; i++)
+            sim.devices[0].regs[0][i] = (uint8_t)rand();
+        same_devices();
+        compare(&st_submissions, &burst_submissions);
+        CHECK(burst_submissions == 1);
+    }
+
+    return sim_failures;
+}
@@ -0,0 +1,84 @@
+/*
+ * File : test_preset.c
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#include <string.h>
+
+#include "vl53l0x.h"
+#include "vl53l0x_profile.h"
+#include "vl53l0x_preset.h"
+#include "vl53l0x_platform_linux.h"
+#include "sim_device.h"
+
+/*
+ * Compiled presets against VL53L0X_Profile_compute: two devices fresh from
+ * VL53L0X_Device_setup, one configured through the API, the other loaded
+ * with the preset of the same profile. Registers and device data must be
+ * the same.
+ */
+
+#define PROFILES    4
+
+static sim_t sim;
+static VL53L0X_LinuxAdapter_t adapter;
+static VL53L0X_Bus_t bus;
+static VL53L0X_Dev_t devices[2];
+
+static const VL53L0X_ProfileConfig_t configs[PROFILES] = {
+    VL53L0X_PROFILE_DEFAULT,
+    VL53L0X_PROFILE_LONG_RANGE,
+    VL53L0X_PROFILE_HIGH_ACCURACY,
+    VL53L0X_PROFILE_HIGH_SPEED,
+};
+
+static const VL53L0X_Preset_t presets[PROFILES] = {
+    VL53L0X_PRESET(14, 10, 33000, 0x00004000, 18 << 16),
+    VL53L0X_PRESET(18, 14, 33000, 0x00001999, 60 << 16),
+    VL53L0X_PRESET(14, 10, 200000, 0x00004000, 18 << 16),
+    VL53L0X_PRESET(14, 10, 20000, 0x00004000, 32 << 16),
+};
+
+int main(void)
+{
+    VL53L0X_Dev_t *api = &devices[0];
+    VL53L0X_Dev_t *preset = &devices[1];
+    VL53L0X_Profile_t computed;
+    VL53L0X_Profile_t api_profile;
+    VL53L0X_Profile_t preset_profile;
+    int i;
+
+    sim_init(&sim);
+    sim_add(&sim, 0x29, 0);
+    sim_add(&sim, 0x2A, 0);
+    CHECK_STATUS(sim_bus(&sim, &bus, &adapter), VL53L0X_ERROR_NONE);
+
+    for (i = 0; i < PROFILES; i++)
+    {
+        memset(devices, 0, sizeof(devices));
+        sim.devices[0].address = 0x29;
+        sim.devices[1].address = 0x2A;
+        api->Bus = &bus;
+        api->I2cDevAddr = 0x29;
+        preset->Bus = &bus;
+        preset->I2cDevAddr = 0x2A;
+        CHECK_STATUS(VL53L0X_Device_setup(api), VL53L0X_ERROR_NONE);
+        CHECK_STATUS(VL53L0X_Device_setup(preset), VL53L0X_ERROR_NONE);
+
+        CHECK_STATUS(VL53L0X_Profile_compute(api, &configs[i], &computed), VL53L0X_ERROR_NONE);
+        CHECK_STATUS(VL53L0X_Preset_load(preset, &presets[i]), VL53L0X_ERROR_NONE);
+
+        CHECK(sim_compare(&sim.devices[0], &sim.devices[1]) == 0);
+
+        memset(&api_profile, 0, sizeof(api_profile));
+        memset(&preset_profile, 0, sizeof(preset_profile));
+        CHECK_STATUS(VL53L0X_Profile_capture(api, &api_profile), VL53L0X_ERROR_NONE);
+        CHECK_STATUS(VL53L0X_Profile_capture(preset, &preset_profile), VL53L0X_ERROR_NONE);
+        CHECK(memcmp(&api_profile, &preset_profile, sizeof(api_profile)) == 0);
+    }
+
+    return sim_failures;
+}
@@ -0,0 +1,129 @@
+/*
+ * File : test_refspad.c
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include "vl53l0x.h"
+#include "vl53l0x_api.h"
+#include "vl53l0x_refspad.h"
+#include "vl53l0x_platform_linux.h"
+#include "sim_device.h"
+
+/*
+ * Bisection reference SPAD search against the linear search of the API:
+ * two devices with the same SPAD responses, set up with one search each.
+ * The SPAD count and map must be the same, in fewer reference measurements.
+ */
+
+#define PROFILES    6
+
+static sim_t sim;
+static VL53L0X_LinuxAdapter_t adapter;
+static VL53L0X_Bus_t bus;
+static VL53L0X_Dev_t devices[2];
+
+// reference return rate of each SPAD, 9.7 MCPS
+static void profile(int index, uint16_t *rate)
+{
+    int i;
+
+    for (i = 0; i < SIM_SPADS; i++)
+    {
+        switch (index)
+        {
+        case 0:     // even, 10 SPADs reach the target
+            rate[i] = 0x0100;
+            break;
+        case 1:     // weak, the search runs out of SPADs of its type
+            rate[i] = 0x0048;
+            break;
+        case 2:     // rising across the array
+            rate[i] = (uint16_t)(0x0020 + 8 * i);
+            break;
+        case 3:     // uneven
+            rate[i] = (uint16_t)(0x0040 + rand() % 0x0180);
+            break;
+        case 4:     // a few dead SPADs among even ones
+            rate[i] = (i % 7 == 3) ? 0 : 0x00C0;
+            break;
+        default:    // strong, the minimum SPADs are past the target
+            rate[i] = 0x0400;
+            break;
+        }
+    }
+}
+
+// reference measurements started since the previous call
+static uint32_t measurements(sim_device_t *d)
+{
+    uint32_t count = 0;
+    uint32_t i;
+
+    for (i = 0; i < d->logged; i++)
+    {
+        if (d->log[i].page == 0 && d->log[i].index == VL53L0X_REG_SYSRANGE_START &&
+            (d->log[i].value & VL53L0X_REG_SYSRANGE_MODE_START_STOP))
+            count++;
+    }
+    sim_log_reset(d);
+
+    return count;
+}
+
+int main(void)
+{
+    VL53L0X_Dev_t *linear = &devices[0];
+    VL53L0X_Dev_t *bisect = &devices[1];
+    sim_device_t *a;
+    sim_device_t *b;
+    uint32_t linear_count;
+    uint32_t bisect_count;
+    uint32_t spads[2];
+    uint8_t aperture[2];
+    int i;
+
+    sim_init(&sim);
+    a = sim_add(&sim, 0x29, 0);
+    b = sim_add(&sim, 0x2A, 0);
+    CHECK_STATUS(sim_bus(&sim, &bus, &adapter), VL53L0X_ERROR_NONE);
+
+    srand(1);
+    for (i = 0; i < PROFILES; i++)
+    {
+        profile(i, a->spad_rate);
+        memcpy(b->spad_rate, a->spad_rate, sizeof(a->spad_rate));
+        sim_log_reset(a);
+        sim_log_reset(b);
+
+        memset(devices, 0, sizeof(devices));
+        linear->Bus = &bus;
+        linear->I2cDevAddr = a->address;
+        bisect->Bus = &bus;
+        bisect->I2cDevAddr = b->address;
+        bisect->RefSpadSearch = VL53L0X_REFSPAD_SEARCH_BISECT;
+
+        CHECK_STATUS(VL53L0X_Device_setup(linear), VL53L0X_ERROR_NONE);
+        CHECK_STATUS(VL53L0X_Device_setup(bisect), VL53L0X_ERROR_NONE);
+
+        linear_count = measurements(a);
+        bisect_count = measurements(b);
+        CHECK_STATUS(VL53L0X_GetReferenceSpads(linear, &spads[0], &aperture[0]), VL53L0X_ERROR_NONE);
+        CHECK_STATUS(VL53L0X_GetReferenceSpads(bisect, &spads[1], &aperture[1]), VL53L0X_ERROR_NONE);
+        printf("profile %d: %u SPADs%s, %u measurements linear, %u bisect\n", i, spads[0],
+               aperture[0] ? " aperture" : "", linear_count, bisect_count);
+
+        CHECK(spads[0] == spads[1]);
+        CHECK(aperture[0] == aperture[1]);
+        CHECK(memcmp(&a->regs[0][VL53L0X_REG_GLOBAL_CONFIG_SPAD_ENABLES_REF_0],
+                     &b->regs[0][VL53L0X_REG_GLOBAL_CONFIG_SPAD_ENABLES_REF_0], 6) == 0);
+        CHECK(bisect_count <= linear_count);
+    }
+
+    return sim_failures;
+}
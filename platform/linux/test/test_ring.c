@@ -0,0 +1,167 @@
+/*
+ * File : test_ring.c
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "esp_timer.h"
+#include "vl53l0x_sample_ring.h"
+#include "sim_device.h"
+
+/*
+ * Shared sample ring under load: a publisher writes SAMPLES measurements,
+ * three reader processes take them, one of them too slow to keep up. Every
+ * sample must be either taken intact and in order, or counted as lost.
+ */
+
+#define RING_NAME       "/vl53l0x_test_ring"
+#define RING_RECORDS    256
+#define SAMPLES         1000000
+#define READERS         3
+#define READER_TIMEOUT_US   (20 * 1000000)
+
+// measurement i, each field derived from it
+static void sample_data(uint32_t i, uint16_t *pdevice, VL53L0X_RangingMeasurementData_t *pdata)
+{
+    memset(pdata, 0, sizeof(*pdata));
+    pdata->RangeMilliMeter = (uint16_t)i;
+    pdata->RangeDMaxMilliMeter = (uint16_t)(i >> 16);
+    pdata->SignalRateRtnMegaCps = i * 3;
+    pdata->AmbientRateRtnMegaCps = ~i;
+    pdata->RangeStatus = (uint8_t)(i % 5);
+    *pdevice = (uint16_t)(i & 7);
+}
+
+static int intact(const VL53L0X_SharedSample_t *s)
+{
+    VL53L0X_RangingMeasurementData_t data;
+    uint16_t device;
+
+    sample_data(s->seq - 1, &device, &data);
+    return s->device == device &&
+           s->RangeMilliMeter == data.RangeMilliMeter &&
+           s->RangeDMaxMilliMeter == data.RangeDMaxMilliMeter &&
+           s->SignalRateRtnMegaCps == data.SignalRateRtnMegaCps &&
+           s->AmbientRateRtnMegaCps == data.AmbientRateRtnMegaCps &&
+           s->RangeStatus == data.RangeStatus;
+}
+
+// reader process, its failures as exit status
+static int reader(int number, int ready)
+{
+    VL53L0X_SampleRing_t ring;
+    VL53L0X_SharedSample_t s;
+    int64_t deadline;
+    uint32_t taken = 0;
+    uint32_t next = 1;
+    uint8_t last = 0;
+
+    CHECK_STATUS(VL53L0X_SampleRing_open(&ring, RING_NAME), VL53L0X_ERROR_NONE);
+    if (sim_failures != 0)
+        return 1;
+    CHECK(write(ready, "r", 1) == 1);
+
+    deadline = esp_timer_get_time() + READER_TIMEOUT_US;
+    while (!last && esp_timer_get_time() < deadline)
+    {
+        while (VL53L0X_SampleRing_take(&ring, &s))
+        {
+            taken++;
+            CHECK(intact(&s));
+            // in order, the ones skipped counted as lost
+            CHECK(s.seq >= next);
+            next = s.seq + 1;
+            last = s.seq == SAMPLES;
+        }
+
+        // the last reader falls behind
+        if (number == READERS - 1)
+            usleep(50);
+    }
+
+    printf("reader %d: %u taken, %u lost\n", number, taken, ring.lost);
+    CHECK(last);
+    CHECK(taken + ring.lost == SAMPLES);
+    if (number == READERS - 1)
+        CHECK(ring.lost > 0);
+
+    VL53L0X_SampleRing_close(&ring);
+    fflush(stdout);
+    return sim_failures != 0;
+}
+
+static void test_records(void)
+{
+    VL53L0X_SampleRing_t ring;
+
+    CHECK_STATUS(VL53L0X_SampleRing_create(&ring, RING_NAME, 1), VL53L0X_ERROR_INVALID_PARAMS);
+    CHECK_STATUS(VL53L0X_SampleRing_create(&ring, RING_NAME, 3), VL53L0X_ERROR_INVALID_PARAMS);
+    CHECK_STATUS(VL53L0X_SampleRing_create(&ring, RING_NAME, 2), VL53L0X_ERROR_NONE);
+    VL53L0X_SampleRing_close(&ring);
+    VL53L0X_SampleRing_remove(RING_NAME);
+}
+
+static void test_stress(void)
+{
+    VL53L0X_RangingMeasurementData_t data;
+    VL53L0X_SampleRing_t ring;
+    pid_t pids[READERS];
+    int ready[2];
+    int64_t start;
+    uint16_t device;
+    uint32_t i;
+    int status;
+    char c;
+    int n;
+
+    CHECK_STATUS(VL53L0X_SampleRing_create(&ring, RING_NAME, RING_RECORDS), VL53L0X_ERROR_NONE);
+    CHECK(pipe(ready) == 0);
+
+    fflush(stdout);
+    for (n = 0; n < READERS; n++)
+    {
+        pids[n] = fork();
+        if (pids[n] == 0)
+            _exit(reader(n, ready[1]));
+    }
+
+    // the readers take from their open on
+    for (n = 0; n < READERS; n++)
+        CHECK(read(ready[0], &c, 1) == 1);
+
+    start = esp_timer_get_time();
+    for (i = 0; i < SAMPLES; i++)
+    {
+        sample_data(i, &device, &data);
+        VL53L0X_SampleRing_publish(&ring, device, &data);
+        // let the readers in, on a single core as well
+        if ((i & 127) == 0)
+            usleep(20);
+    }
+    printf("%u samples published in %lld ms\n", SAMPLES, (long long)(esp_timer_get_time() - start) / 1000);
+
+    for (n = 0; n < READERS; n++)
+    {
+        CHECK(waitpid(pids[n], &status, 0) == pids[n]);
+        CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    }
+
+    close(ready[0]);
+    close(ready[1]);
+    VL53L0X_SampleRing_close(&ring);
+    VL53L0X_SampleRing_remove(RING_NAME);
+}
+
+int main(void)
+{
+    test_records();
+    test_stress();
+
+    return sim_failures;
+}
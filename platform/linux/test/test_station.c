@@ -0,0 +1,77 @@
+/*
+ * File : test_station.c
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#include <string.h>
+
+#include "vl53l0x.h"
+#include "vl53l0x_station.h"
+#include "vl53l0x_platform_linux.h"
+#include "sim_device.h"
+
+/*
+ * Calibration station on a fixture of sensors sharing the bus and the power
+ * on address: each unit is given its own address through its XSHUT line,
+ * then set up and calibrated on its own readings.
+ */
+
+#define UNITS   3
+
+static sim_t sim;
+static VL53L0X_LinuxAdapter_t adapter;
+static VL53L0X_Bus_t bus;
+static VL53L0X_Dev_t dev[UNITS];
+static VL53L0X_StationUnit_t units[UNITS];
+
+static int32_t xshut(void *ctx, uint8_t enable)
+{
+    sim_xshut(ctx, enable);
+    return 0;
+}
+
+int main(void)
+{
+    static const uint16_t range_mm[UNITS] = { 300, 310, 290 };
+    static const int32_t offset_um[UNITS] = { 0, -10000, 10000 };
+    sim_device_t *d;
+    int i;
+
+    sim_init(&sim);
+    for (i = 0; i < UNITS; i++)
+    {
+        d = sim_add(&sim, SIM_DEFAULT_ADDRESS, 0);
+        d->range_mm = range_mm[i];
+
+        dev[i].Bus = &bus;
+        units[i] = (VL53L0X_StationUnit_t){ .device = &dev[i], .Address = 0x30 + i,
+                                            .Enable = xshut, .EnableCtx = d };
+    }
+    CHECK_STATUS(sim_bus(&sim, &bus, &adapter), VL53L0X_ERROR_NONE);
+
+    CHECK_STATUS(VL53L0X_Station_setup(units, UNITS), VL53L0X_ERROR_NONE);
+    for (i = 0; i < UNITS; i++)
+    {
+        d = &sim.devices[i];
+        CHECK(d->address == 0x30 + i);
+        CHECK(dev[i].I2cDevAddr == 0x30 + i);
+        CHECK(units[i].Status == VL53L0X_ERROR_NONE);
+        // each device went through its own reference SPAD management
+        CHECK(units[i].RefSpadCount > 0);
+        CHECK(d->regs[0][VL53L0X_REG_GLOBAL_CONFIG_SPAD_ENABLES_REF_0] != 0);
+    }
+
+    CHECK_STATUS(VL53L0X_Station_offset(units, UNITS, 300 << 16, NULL), VL53L0X_ERROR_NONE);
+    for (i = 0; i < UNITS; i++)
+    {
+        printf("unit %d: offset %d um, %u samples\n", i, units[i].OffsetMicroMeter,
+               units[i].Offset.Measurements);
+        CHECK(units[i].OffsetMicroMeter == offset_um[i]);
+        CHECK(units[i].Offset.Converged);
+    }
+
+    return sim_failures;
+}
@@ -0,0 +1,229 @@
+/*
+ * File : test_transport.c
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <linux/i2c-dev.h>
+
+#include "vl53l0x.h"
+#include "vl53l0x_i2c_platform.h"
+#include "vl53l0x_platform_linux.h"
+#include "sim_device.h"
+
+/*
+ * i2c-dev transport on stand-in devices: two sensors at the same address
+ * behind the multiplexer, set up and ranging through the transfer hook.
+ */
+
+#define THREADS         3
+#define THREAD_READS    2000
+
+static sim_t sim;
+static VL53L0X_LinuxAdapter_t adapter;
+static VL53L0X_Bus_t bus;
+static VL53L0X_Dev_t dev[2];
+
+static int inside;
+static int overlaps;
+static int thread_errors;
+
+// sim_transfer, checking the arbitration lets one transaction at a time in
+static int checked_transfer(void *ctx, struct i2c_msg *msgs, uint32_t count)
+{
+    int err;
+
+    if (__atomic_add_fetch(&inside, 1, __ATOMIC_SEQ_CST) > 1)
+        __atomic_add_fetch(&overlaps, 1, __ATOMIC_SEQ_CST);
+    // on the wire a while, for the other threads to queue up
+    usleep(10);
+    err = sim_transfer(ctx, msgs, count);
+    __atomic_sub_fetch(&inside, 1, __ATOMIC_SEQ_CST);
+
+    return err;
+}
+
+static void *reader(void *arg)
+{
+    VL53L0X_Dev_t device = dev[0];
+    uint8_t model;
+    int i;
+
+    VL53L0X_SetBusPriority(&device, (int8_t)((long)arg + VL53L0X_BUS_PRIORITY_LOW));
+    for (i = 0; i < THREAD_READS; i++)
+    {
+        if (VL53L0X_RdByte(&device, VL53L0X_REG_IDENTIFICATION_MODEL_ID, &model) != VL53L0X_ERROR_NONE ||
+            model != 0xEE)
+            __atomic_add_fetch(&thread_errors, 1, __ATOMIC_SEQ_CST);
+    }
+
+    return NULL;
+}
+
+static void test_setup(void)
+{
+    uint16_t range;
+    int i;
+
+    sim_add(&sim, 0x29, 1 << 0)->range_mm = 300;
+    sim_add(&sim, 0x29, 1 << 1)->range_mm = 420;
+    CHECK_STATUS(sim_bus(&sim, &bus, &adapter), VL53L0X_ERROR_NONE);
+
+    for (i = 0; i < 2; i++)
+    {
+        memset(&dev[i], 0, sizeof(dev[i]));
+        dev[i].Bus = &bus;
+        dev[i].MuxMask = 1 << i;
+        CHECK_STATUS(VL53L0X_Device_init(&dev[i]), VL53L0X_ERROR_NONE);
+    }
+
+    CHECK_STATUS(VL53L0X_Device_getMeasurement(&dev[0], &range), VL53L0X_ERROR_NONE);
+    CHECK(range == 300);
+    CHECK_STATUS(VL53L0X_Device_getMeasurement(&dev[1], &range), VL53L0X_ERROR_NONE);
+    CHECK(range == 420);
+
+    CHECK(sim.max_messages <= I2C_RDWR_IOCTL_MAX_MSGS);
+}
+
+static void test_batch(void)
+{
+    VL53L0X_Transfer_t t[VL53L0X_SEQUENCE_CHUNK];
+    uint8_t model[VL53L0X_SEQUENCE_CHUNK];
+    uint32_t transfers = sim.transfers;
+    int i;
+
+    // a channel switch in front of every read: 96 messages, 3 ioctls
+    for (i = 0; i < VL53L0X_SEQUENCE_CHUNK; i++)
+        t[i] = (VL53L0X_Transfer_t){ .device = &dev[i & 1], .index = VL53L0X_REG_IDENTIFICATION_MODEL_ID,
+                                     .count = 1, .pdata = &model[i] };
+
+    CHECK_STATUS(VL53L0X_TransferBatch(t, VL53L0X_SEQUENCE_CHUNK), VL53L0X_ERROR_NONE);
+    for (i = 0; i < VL53L0X_SEQUENCE_CHUNK; i++)
+        CHECK(model[i] == 0xEE);
+    CHECK(sim.transfers - transfers == 3);
+    CHECK(sim.max_messages <= I2C_RDWR_IOCTL_MAX_MSGS);
+}
+
+static void test_failure(void)
+{
+    uint8_t model;
+
+    // the failed ioctl leaves the multiplexer channel unknown
+    sim.fail_in = 0;
+    CHECK_STATUS(VL53L0X_RdByte(&dev[1], VL53L0X_REG_IDENTIFICATION_MODEL_ID, &model),
+                 VL53L0X_ERROR_CONTROL_INTERFACE);
+    CHECK(bus.mux_current == 0);
+
+    sim.mux = 0;
+    CHECK_STATUS(VL53L0X_RdByte(&dev[1], VL53L0X_REG_IDENTIFICATION_MODEL_ID, &model), VL53L0X_ERROR_NONE);
+    CHECK(model == 0xEE);
+    CHECK(sim.mux == dev[1].MuxMask);
+}
+
+static void test_batch_failure(void)
+{
+    VL53L0X_Transfer_t t[VL53L0X_SEQUENCE_CHUNK];
+    uint8_t data[VL53L0X_SEQUENCE_CHUNK];
+    uint32_t written[VL53L0X_SEQUENCE_CHUNK];
+    sim_device_t *d;
+    uint32_t through = 0;
+    uint32_t n;
+    int i;
+
+    // pairs of writes then pairs of reads, a channel switch in front of
+    // each: 80 messages, the second ioctl fails
+    for (i = 0; i < VL53L0X_SEQUENCE_CHUNK; i++)
+    {
+        data[i] = (uint8_t)i;
+        t[i] = (VL53L0X_Transfer_t){ .device = &dev[i & 1], .write = (i & 2) == 0,
+                                     .index = (i & 2) == 0 ? VL53L0X_REG_SYSTEM_INTERRUPT_CONFIG_GPIO
+                                                           : VL53L0X_REG_IDENTIFICATION_MODEL_ID,
+                                     .count = 1, .pdata = &data[i] };
+    }
+    sim_log_reset(&sim.devices[0]);
+    sim_log_reset(&sim.devices[1]);
+    sim.fail_in = 50;
+
+    CHECK_STATUS(VL53L0X_TransferBatch(t, VL53L0X_SEQUENCE_CHUNK), VL53L0X_ERROR_CONTROL_INTERFACE);
+
+    memset(written, 0, sizeof(written));
+    for (i = 0; i < 2; i++)
+    {
+        d = &sim.devices[i];
+        for (n = 0; n < d->logged; n++)
+        {
+            if (d->log[n].index == VL53L0X_REG_SYSTEM_INTERRUPT_CONFIG_GPIO)
+                written[d->log[n].value]++;
+        }
+    }
+
+    for (i = 0; i < VL53L0X_SEQUENCE_CHUNK; i++)
+    {
+        if (!t[i].write)
+        {
+            // through or retried
+            CHECK_STATUS(t[i].Status, VL53L0X_ERROR_NONE);
+            CHECK(data[i] == 0xEE);
+            continue;
+        }
+
+        // sent once at most, failed unless known to be through
+        CHECK(written[i] <= 1);
+        if (t[i].Status == VL53L0X_ERROR_NONE)
+        {
+            CHECK(written[i] == 1);
+            through++;
+        }
+        else
+            CHECK_STATUS(t[i].Status, VL53L0X_ERROR_CONTROL_INTERFACE);
+    }
+    printf("failed batch: %u of %u writes through\n", through, VL53L0X_SEQUENCE_CHUNK / 2);
+    CHECK(through > 0 && through < VL53L0X_SEQUENCE_CHUNK / 2);
+}
+
+static void test_arbitration(void)
+{
+    VL53L0X_BusStats_t stats;
+    pthread_t threads[THREADS];
+    long i;
+
+    adapter.transfer = checked_transfer;
+    for (i = 0; i < THREADS; i++)
+        pthread_create(&threads[i], NULL, reader, (void *)i);
+    for (i = 0; i < THREADS; i++)
+        pthread_join(threads[i], NULL);
+    adapter.transfer = sim_transfer;
+
+    VL53L0X_Bus_getStats(&bus, &stats);
+    CHECK(thread_errors == 0);
+    CHECK(overlaps == 0);
+    CHECK(stats.arbitration_waits > 0);
+}
+
+static void test_default_bus(void)
+{
+    // a default bus without its adapter fails the setup of its devices
+    if (access(VL53L0X_LINUX_I2C_DEVICE, F_OK) != 0)
+        CHECK(VL53L0X_comms_initialise(0, 400) != VL53L0X_ERROR_NONE);
+
+    CHECK_STATUS(VL53L0X_Bus_init(&bus, 1, 400, 0), VL53L0X_ERROR_NOT_IMPLEMENTED);
+}
+
+int main(void)
+{
+    sim_init(&sim);
+
+    test_setup();
+    test_batch();
+    test_failure();
+    test_batch_failure();
+    test_arbitration();
+    test_default_bus();
+
+    return sim_failures;
+}
@@ -8,6 +8,11 @@
  */
 #include "vl53l0x.h"
 #include "vl53l0x_platform_log.h"
+#include "vl53l0x_platform_esp32.h"
+#include "vl53l0x_refspad.h"
+#include "vl53l0x_measurement.h"
+#include "vl53l0x_ranging.h"
+#include "vl53l0x_latest.h"
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
@@ -25,6 +30,10 @@
 #define IO_NUM          GPIO_NUM_5
 #define IO_SEL(num)     (1ULL << (num))
 
+// devices served per bus submission by VL53L0X_Device_getMeasurements,
+// each sample taken costs two interrupt clear writes
+#define MEASUREMENTS_GROUP  (VL53L0X_SEQUENCE_CHUNK / 2)
+
 #define msec(t) ((t) / portTICK_PERIOD_MS) // millisecond convert
 #define sec(t) ((t) * 100U)
 #define minute(t) (sec(t * 60));
@@ -34,7 +43,7 @@ static const char* TAG = "vl53l0x";
 
 #ifdef VL53L0X_LOG_ENABLE
 #define VL53L0X_Log(level, fmt, ...) \
-    ESP_LOG_LEVEL_LOCAL(level, VL53L0X_TAG, fmt, ##__VA_ARGS__)
+    VL53L0X_DRIVER_LOG(level, VL53L0X_TAG, fmt, ##__VA_ARGS__)
 
 #define VL53L0X_ErrLog(fmt, ...) \
     VL53L0X_Log(ESP_LOG_ERROR, "VL53L0X_ErrLog %s" fmt, __func__, ##__VA_ARGS__)
@@ -45,9 +54,15 @@ static const char* TAG = "vl53l0x";
 
 extern StructDeviceSettings dev_settings;
 
-static void print_pal_error(VL53L0X_Error Status)
+// out of line: the string buffer is only on the stack while an error prints
+static void __attribute__((noinline)) print_pal_error(VL53L0X_Error Status)
 {
     char buf[VL53L0X_MAX_STRING_LENGTH];
+
+    // no error string for a log compiled out
+    if (!VL53L0X_DRIVER_LOG_COMPILED(ESP_LOG_ERROR))
+        return;
+
     VL53L0X_GetPalErrorString(Status, buf);
     VL53L0X_ErrLog("API Status: %i : %s\n", Status, buf);
 }
@@ -71,8 +86,8 @@ static VL53L0X_Error WaitMeasurementDataReady(VL53L0X_DEV Dev)
                 break;
             }
             LoopNb = LoopNb + 1;
-            VL53L0X_PollingDelay(Dev);
-        } while (LoopNb < VL53L0X_DEFAULT_MAX_LOOP);
+            Status = VL53L0X_PollingDelay(Dev);
+        } while (LoopNb < VL53L0X_DEFAULT_MAX_LOOP && Status == VL53L0X_ERROR_NONE);
 
         if (LoopNb >= VL53L0X_DEFAULT_MAX_LOOP)
         {
@@ -102,8 +117,8 @@ static VL53L0X_Error WaitStopCompleted(VL53L0X_DEV Dev)
                 break;
             }
             LoopNb = LoopNb + 1;
-            VL53L0X_PollingDelay(Dev);
-        } while (LoopNb < VL53L0X_DEFAULT_MAX_LOOP);
+            Status = VL53L0X_PollingDelay(Dev);
+        } while (LoopNb < VL53L0X_DEFAULT_MAX_LOOP && Status == VL53L0X_ERROR_NONE);
 
         if (LoopNb >= VL53L0X_DEFAULT_MAX_LOOP)
         {
@@ -114,124 +129,226 @@ static VL53L0X_Error WaitStopCompleted(VL53L0X_DEV Dev)
     return Status;
 }
 
-VL53L0X_Error VL53L0X_Device_init(VL53L0X_Dev_t *device)
+static const uint8_t private_exit[] = {
+    0xFF, 0x01,
+    0x00, 0x01,
+    0xFF, 0x00,
+    0x80, 0x00,
+};
+
+static void setup_defaults(VL53L0X_Dev_t *device)
+{
+    esp_log_level_set(TAG, ESP_LOG_INFO);
+
+    device->comms_type = 1;
+    device->comms_speed_khz = device->Bus != NULL ? device->Bus->speed_khz : I2C_MUX_BAUDRATE/1000;
+    // several sensors are told apart by the address they were given
+    if (device->I2cDevAddr == 0)
+        device->I2cDevAddr = CONFIG_VL53L0X_I2C_ADDR;
+    // the search of the API unless the bisection was asked for
+    if (device->RefSpadSearch != VL53L0X_REFSPAD_SEARCH_BISECT)
+        device->RefSpadSearch = VL53L0X_REFSPAD_SEARCH_LINEAR;
+    device->Deadline = 0;
+    device->InterruptSettings = VL53L0X_INTERRUPT_SETTINGS_UNKNOWN;
+    VL53L0X_InvalidatePage(device);
+}
+
+// device strings, out of the setup frame and only with the debug log compiled in
+static void __attribute__((noinline)) log_device_info(VL53L0X_Dev_t *device)
+{
+    VL53L0X_DeviceInfo_t DeviceInfo;
+
+    if (!VL53L0X_DRIVER_LOG_COMPILED(ESP_LOG_DEBUG))
+        return;
+    if (VL53L0X_GetDeviceInfo(device, &DeviceInfo) != VL53L0X_ERROR_NONE)
+        return;
+
+    VL53L0X_Log(ESP_LOG_DEBUG, "VL53L0X_GetDeviceInfo:\n");
+    VL53L0X_Log(ESP_LOG_DEBUG, "Device Name : %s\n", DeviceInfo.Name);
+    VL53L0X_Log(ESP_LOG_DEBUG, "Device Type : %s\n", DeviceInfo.Type);
+    VL53L0X_Log(ESP_LOG_DEBUG, "Device ID : %s\n", DeviceInfo.ProductId);
+}
+
+// run the step following the completed one
+static VL53L0X_Error setup_step(VL53L0X_Dev_t *pMyDevice, VL53L0X_SetupStep_t completed)
 {
     VL53L0X_Error Status = VL53L0X_ERROR_NONE;
-    VL53L0X_Dev_t *pMyDevice = device;
     VL53L0X_Version_t Version;
     VL53L0X_Version_t *pVersion = &Version;
-    VL53L0X_DeviceInfo_t DeviceInfo;
+    uint8_t RevisionMajor;
+    uint8_t RevisionMinor;
+    uint8_t VhvSettings;
+    uint8_t PhaseCal;
+    uint32_t refSpadCount;
+    uint8_t isApertureSpads;
 
-    esp_log_level_set(TAG, ESP_LOG_INFO);
+    switch (completed)
+    {
+    case VL53L0X_SETUP_START:
+        // a device with its own bus comes with its transport set up
+        if (pMyDevice->Bus == NULL)
+            Status = VL53L0X_comms_initialise(0, I2C_MUX_BAUDRATE/1000);
+        if (Status != VL53L0X_ERROR_NONE)
+        {
+            VL53L0X_ErrLog("i2c init failed!");
+            return Status;
+        }
 
-    pMyDevice->comms_type = 1;
-    pMyDevice->comms_speed_khz = I2C_MUX_BAUDRATE/1000;
-    pMyDevice->I2cDevAddr = CONFIG_VL53L0X_I2C_ADDR;
+        /*
+         *  Get the version of the VL53L0X API running in the firmware
+         */
 
-    Status = VL53L0X_comms_initialise(0, I2C_MUX_BAUDRATE/1000);
-    if (Status != VL53L0X_ERROR_NONE)
-    {
-        VL53L0X_ErrLog("i2c init failed!");
-        return Status;
-    }
+        int32_t status_int;
+        status_int = VL53L0X_GetVersion(pVersion);
+        if (status_int != 0)
+            Status = VL53L0X_ERROR_CONTROL_INTERFACE;
 
-    /*
-     *  Get the version of the VL53L0X API running in the firmware
-     */
+        /*
+         *  Verify the version of the VL53L0X API running in the firmrware
+         */
 
-    int32_t status_int;
-    status_int = VL53L0X_GetVersion(pVersion);
-    if (status_int != 0)
-        Status = VL53L0X_ERROR_CONTROL_INTERFACE;
+        if (Status == VL53L0X_ERROR_NONE)
+        {
+            if (pVersion->major != VERSION_REQUIRED_MAJOR ||
+                pVersion->minor != VERSION_REQUIRED_MINOR ||
+                pVersion->build != VERSION_REQUIRED_BUILD)
+            {
+                VL53L0X_Log(ESP_LOG_DEBUG, "VL53L0X API Version Error: Your firmware has %d.%d.%d (revision %d). This example requires %d.%d.%d.\n",
+                         pVersion->major, pVersion->minor, pVersion->build, pVersion->revision,
+                         VERSION_REQUIRED_MAJOR, VERSION_REQUIRED_MINOR, VERSION_REQUIRED_BUILD);
+            }
+        }
 
-    /*
-     *  Verify the version of the VL53L0X API running in the firmrware
-     */
+        // End of implementation specific
+        VL53L0X_Log(ESP_LOG_DEBUG, "Call of VL53L0X_DataInit\n");
+        Status = VL53L0X_DataInit(pMyDevice); // Data initialization
+        if (Status != VL53L0X_ERROR_NONE)
+        {
+            print_pal_error(Status);
+            return Status;
+        }
 
-    if (Status == VL53L0X_ERROR_NONE)
-    {
-        if (pVersion->major != VERSION_REQUIRED_MAJOR ||
-            pVersion->minor != VERSION_REQUIRED_MINOR ||
-            pVersion->build != VERSION_REQUIRED_BUILD)
+        // one register, the device strings are only read for the debug log
+        Status = VL53L0X_GetProductRevision(pMyDevice, &RevisionMajor, &RevisionMinor);
+        if (Status != VL53L0X_ERROR_NONE)
         {
-            VL53L0X_Log(ESP_LOG_DEBUG, "VL53L0X API Version Error: Your firmware has %d.%d.%d (revision %d). This example requires %d.%d.%d.\n",
-                     pVersion->major, pVersion->minor, pVersion->build, pVersion->revision,
-                     VERSION_REQUIRED_MAJOR, VERSION_REQUIRED_MINOR, VERSION_REQUIRED_BUILD);
+            print_pal_error(Status);
+            return Status;
         }
-    }
 
-    // End of implementation specific
-    VL53L0X_Log(ESP_LOG_DEBUG, "Call of VL53L0X_DataInit\n");
-    Status = VL53L0X_DataInit(pMyDevice); // Data initialization
-    if (Status != VL53L0X_ERROR_NONE)
-    {
-        print_pal_error(Status);
-        return Status;
-    }
+        log_device_info(pMyDevice);
+        VL53L0X_Log(ESP_LOG_DEBUG, "ProductRevisionMajor : %d\n", RevisionMajor);
+        VL53L0X_Log(ESP_LOG_DEBUG, "ProductRevisionMinor : %d\n", RevisionMinor);
 
-    Status = VL53L0X_GetDeviceInfo(pMyDevice, &DeviceInfo);
-    if (Status != VL53L0X_ERROR_NONE)
-    {
-        print_pal_error(Status);
-        return Status;
+        if ((RevisionMinor != 1) && (RevisionMinor != 1))
+        {
+            VL53L0X_Log(ESP_LOG_DEBUG, "Error expected cut 1.1 but found cut %d.%d\n",
+                        RevisionMajor, RevisionMinor);
+            Status = VL53L0X_ERROR_NOT_SUPPORTED;
+        }
+        break;
+
+    case VL53L0X_SETUP_DATA_INIT:
+        // StaticInit will set interrupt by default
+        VL53L0X_Log(ESP_LOG_DEBUG, "Call of VL53L0X_StaticInit\n");
+        Status = VL53L0X_StaticInit(pMyDevice); // Device Initialization
+        if (Status != VL53L0X_ERROR_NONE)
+            print_pal_error(Status);
+        break;
+
+    case VL53L0X_SETUP_STATIC_INIT:
+        VL53L0X_Log(ESP_LOG_DEBUG, "Call of VL53L0X_PerformRefCalibration\n");
+        Status = VL53L0X_PerformRefCalibration(pMyDevice,
+                                                &VhvSettings, &PhaseCal); // Device Initialization
+        if (Status != VL53L0X_ERROR_NONE)
+            print_pal_error(Status);
+
+        //================================
+        // TODO: RefCalibration Data Handling
+        //================================
+        break;
+
+    case VL53L0X_SETUP_REF_CALIBRATION:
+        VL53L0X_Log(ESP_LOG_DEBUG, "Call of VL53L0X_RefSpad_perform\n");
+        Status = VL53L0X_RefSpad_perform(pMyDevice,
+                                         &refSpadCount, &isApertureSpads); // Device Initialization
+        if (Status != VL53L0X_ERROR_NONE)
+            print_pal_error(Status);
+
+        //================================
+        // TODO: RefSpadManagement Data Handling
+        //================================
+        break;
+
+    default:
+        break;
     }
 
-    VL53L0X_Log(ESP_LOG_DEBUG, "VL53L0X_GetDeviceInfo:\n");
-    VL53L0X_Log(ESP_LOG_DEBUG, "Device Name : %s\n", DeviceInfo.Name);
-    VL53L0X_Log(ESP_LOG_DEBUG, "Device Type : %s\n", DeviceInfo.Type);
-    VL53L0X_Log(ESP_LOG_DEBUG, "Device ID : %s\n", DeviceInfo.ProductId);
-    VL53L0X_Log(ESP_LOG_DEBUG, "ProductRevisionMajor : %d\n", DeviceInfo.ProductRevisionMajor);
-    VL53L0X_Log(ESP_LOG_DEBUG, "ProductRevisionMinor : %d\n", DeviceInfo.ProductRevisionMinor);
+    return Status;
+}
 
-    if ((DeviceInfo.ProductRevisionMinor != 1) && (DeviceInfo.ProductRevisionMinor != 1))
-    {
-        VL53L0X_Log(ESP_LOG_DEBUG, "Error expected cut 1.1 but found cut %d.%d\n",
-                    DeviceInfo.ProductRevisionMajor, DeviceInfo.ProductRevisionMinor);
-        Status = VL53L0X_ERROR_NOT_SUPPORTED;
-        return Status;
-    }
+static VL53L0X_Error setup_run(VL53L0X_Dev_t *device, VL53L0X_SetupStep_t *step,
+                               VL53L0X_SetupStep_t last, int64_t deadline_us)
+{
+    VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+    int64_t previous;
+    int8_t priority;
 
-    // StaticInit will set interrupt by default
-    VL53L0X_Log(ESP_LOG_DEBUG, "Call of VL53L0X_StaticInit\n");
-    Status = VL53L0X_StaticInit(pMyDevice); // Device Initialization
+    if (*step == VL53L0X_SETUP_START)
+        setup_defaults(device);
 
-    if (Status != VL53L0X_ERROR_NONE)
-    {
-        print_pal_error(Status);
-        return Status;
-    }
+    previous = VL53L0X_SetDeadline(device, deadline_us);
+    // bulk loads and calibrations give way to the ranging of other devices
+    priority = VL53L0X_SetBusPriority(device, VL53L0X_BUS_PRIORITY_LOW);
 
-    uint8_t VhvSettings;
-    uint8_t PhaseCal;
+    // an interrupted attempt may have left the device on another page with the
+    // private registers open: close them as the API sequences do
+    if (*step > VL53L0X_SETUP_START && *step < last)
+        Status = VL53L0X_WriteSequence(device, private_exit, sizeof(private_exit) / 2);
 
-    VL53L0X_Log(ESP_LOG_DEBUG, "Call of VL53L0X_PerformRefCalibration\n");
-    Status = VL53L0X_PerformRefCalibration(pMyDevice,
-                                            &VhvSettings, &PhaseCal); // Device Initialization
-    if (Status != VL53L0X_ERROR_NONE)
+    while (*step < last && Status == VL53L0X_ERROR_NONE)
     {
-        print_pal_error(Status);
-        return Status;
+        Status = setup_step(device, *step);
+        if (Status != VL53L0X_ERROR_NONE)
+            break;
+        *step = (VL53L0X_SetupStep_t)(*step + 1);
     }
 
-    //================================
-    // TODO: RefCalibration Data Handling
-    //================================
+    VL53L0X_SetBusPriority(device, priority);
+    VL53L0X_SetDeadline(device, previous);
 
-    uint32_t refSpadCount;
-    uint8_t isApertureSpads;
-    VL53L0X_Log(ESP_LOG_DEBUG, "Call of VL53L0X_PerformRefSpadManagement\n");
-    Status = VL53L0X_PerformRefSpadManagement(pMyDevice,
-                                                &refSpadCount, &isApertureSpads); // Device Initialization
+    return Status;
+}
+
+VL53L0X_Error VL53L0X_Device_setupUntil(VL53L0X_Dev_t *device, VL53L0X_SetupStep_t *step, int64_t deadline_us)
+{
+    return setup_run(device, step, VL53L0X_SETUP_DONE, deadline_us);
+}
+
+VL53L0X_Error VL53L0X_Device_setupThrough(VL53L0X_Dev_t *device, VL53L0X_SetupStep_t *step,
+                                          VL53L0X_SetupStep_t last)
+{
+    return setup_run(device, step, last, 0);
+}
+
+VL53L0X_Error VL53L0X_Device_setup(VL53L0X_Dev_t *device)
+{
+    VL53L0X_SetupStep_t step = VL53L0X_SETUP_START;
+
+    return VL53L0X_Device_setupUntil(device, &step, 0);
+}
+
+VL53L0X_Error VL53L0X_Device_init(VL53L0X_Dev_t *device)
+{
+    VL53L0X_Error Status;
+    VL53L0X_Dev_t *pMyDevice = device;
+
+    Status = VL53L0X_Device_setup(pMyDevice);
     if (Status != VL53L0X_ERROR_NONE)
     {
-        print_pal_error(Status);
         return Status;
     }
 
-    //================================
-    // TODO: RefSpadManagement Data Handling
-    //================================
-
     VL53L0X_Log(ESP_LOG_DEBUG, "Call of VL53L0X_SetDeviceMode\n");
     VL53L0X_DeviceModes default_device_mode = VL53L0X_DEVICEMODE_CONTINUOUS_RANGING;
     Status = VL53L0X_SetDeviceMode(pMyDevice, default_device_mode); // Setup in single ranging mode
@@ -241,8 +358,8 @@ VL53L0X_Error VL53L0X_Device_init(VL53L0X_Dev_t *device)
         return Status;
     }
 
-    VL53L0X_Log(ESP_LOG_DEBUG, "Call of VL53L0X_StartMeasurement\n");
-    Status = VL53L0X_StartMeasurement(pMyDevice);
+    VL53L0X_Log(ESP_LOG_DEBUG, "Call of VL53L0X_Measurement_start\n");
+    Status = VL53L0X_Measurement_start(pMyDevice);
     if (Status != VL53L0X_ERROR_NONE)
     {
         print_pal_error(Status);
@@ -258,8 +375,8 @@ VL53L0X_Error VL53L0X_Device_deinit(VL53L0X_Dev_t *device)
 {
     VL53L0X_Error Status;
 
-    VL53L0X_Log(ESP_LOG_DEBUG, "Call of VL53L0X_StopMeasurement\n");
-    Status = VL53L0X_StopMeasurement(device);
+    VL53L0X_Log(ESP_LOG_DEBUG, "Call of VL53L0X_Measurement_stop\n");
+    Status = VL53L0X_Measurement_stop(device);
     if (Status != VL53L0X_ERROR_NONE)
     {
         print_pal_error(Status);
@@ -285,10 +402,21 @@ VL53L0X_Error VL53L0X_Device_deinit(VL53L0X_Dev_t *device)
     return Status;
 }
 
+VL53L0X_Error VL53L0X_Device_deinitUntil(VL53L0X_Dev_t *device, int64_t deadline_us)
+{
+    VL53L0X_Error Status;
+    int64_t previous = VL53L0X_SetDeadline(device, deadline_us);
+
+    Status = VL53L0X_Device_deinit(device);
+
+    VL53L0X_SetDeadline(device, previous);
+    return Status;
+}
+
 #define SENS_HIGH   17500000    // 100cm
 #define SENS_MED    43500000    // 80cm
 #define SENS_LOW    116000000   // 50cm
-inline bool filter(VL53L0X_RangingMeasurementData_t *RangingMeasurementData) {
+static inline bool filter(VL53L0X_RangingMeasurementData_t *RangingMeasurementData) {
     uint32_t sens;
     if (RangingMeasurementData->RangeStatus != 0)
         return false;
@@ -326,6 +454,7 @@ VL53L0X_Error VL53L0X_Device_getMeasurement(VL53L0X_Dev_t *device, uint16_t* dat
         VL53L0X_ErrLog("VL53L0X_GetRangingMeasurementData error (%d)", Status);
         return Status;
     }
+    VL53L0X_Latest_record(device, &RangingMeasurementData);
 
     // Clear the interrupt
     VL53L0X_ClearInterruptMask(device, VL53L0X_REG_SYSTEM_INTERRUPT_GPIO_NEW_SAMPLE_READY);
@@ -339,3 +468,93 @@ VL53L0X_Error VL53L0X_Device_getMeasurement(VL53L0X_Dev_t *device, uint16_t* dat
 
     return VL53L0X_ERROR_UNDEFINED;
 }
+
+VL53L0X_Error VL53L0X_Device_getMeasurementUntil(VL53L0X_Dev_t *device, uint16_t* data, int64_t deadline_us)
+{
+    VL53L0X_Error Status;
+    int64_t previous = VL53L0X_SetDeadline(device, deadline_us);
+
+    Status = VL53L0X_Device_getMeasurement(device, data);
+
+    VL53L0X_SetDeadline(device, previous);
+    return Status;
+}
+
+VL53L0X_Error VL53L0X_Device_getMeasurements(VL53L0X_Dev_t *devices, uint8_t count, uint16_t *data, uint32_t *pReady)
+{
+    VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+    VL53L0X_Error DevStatus;
+    VL53L0X_RangingMeasurementData_t RangingMeasurementData;
+    VL53L0X_Transfer_t reads[MEASUREMENTS_GROUP];
+    VL53L0X_Transfer_t clears[2 * MEASUREMENTS_GROUP];
+    uint8_t blocks[MEASUREMENTS_GROUP][VL53L0X_RESULT_BLOCK_SIZE];
+    uint8_t clear_set = 0x01;       // bit 0 range interrupt, as VL53L0X_ClearInterruptMask
+    uint8_t clear_reset = 0x00;
+    VL53L0X_Dev_t *device;
+    uint8_t first;
+    uint8_t group;
+    uint8_t cleared;
+    uint8_t i;
+
+    *pReady = 0;
+    if (count > 32)
+        return VL53L0X_ERROR_INVALID_PARAMS;
+
+    for (first = 0; first < count; first += group)
+    {
+        group = count - first < MEASUREMENTS_GROUP ? count - first : MEASUREMENTS_GROUP;
+
+        // interrupt status and result block of every device, one submission per bus
+        for (i = 0; i < group; i++)
+            reads[i] = (VL53L0X_Transfer_t){ .device = &devices[first + i], .index = VL53L0X_RESULT_BLOCK_INDEX,
+                                             .count = VL53L0X_RESULT_BLOCK_SIZE, .pdata = blocks[i] };
+        VL53L0X_TransferBatch(reads, group);
+
+        cleared = 0;
+        for (i = 0; i < group; i++)
+        {
+            device = &devices[first + i];
+            DevStatus = reads[i].Status;
+
+            if (DevStatus == VL53L0X_ERROR_NONE && !VL53L0X_Ranging_isReady(device, blocks[i]))
+                continue;
+            if (DevStatus == VL53L0X_ERROR_NONE)
+                DevStatus = VL53L0X_Ranging_decode(device, blocks[i], &RangingMeasurementData);
+            if (DevStatus != VL53L0X_ERROR_NONE)
+            {
+                VL53L0X_ErrLog("device %u error (%d)", first + i, DevStatus);
+                if (Status == VL53L0X_ERROR_NONE)
+                    Status = DevStatus;
+                continue;
+            }
+
+            VL53L0X_Latest_record(device, &RangingMeasurementData);
+            if (filter(&RangingMeasurementData))
+            {
+                data[first + i] = RangingMeasurementData.RangeMilliMeter;
+                *pReady |= 1UL << (first + i);
+            }
+
+            // the reads of the devices after this one are still to be looked at
+            clears[2 * cleared] = (VL53L0X_Transfer_t){ .device = device, .write = 1,
+                                                        .index = VL53L0X_REG_SYSTEM_INTERRUPT_CLEAR,
+                                                        .count = 1, .pdata = &clear_set };
+            clears[2 * cleared + 1] = clears[2 * cleared];
+            clears[2 * cleared + 1].pdata = &clear_reset;
+            cleared++;
+        }
+
+        if (cleared > 0)
+        {
+            DevStatus = VL53L0X_TransferBatch(clears, 2 * cleared);
+            if (DevStatus != VL53L0X_ERROR_NONE)
+            {
+                VL53L0X_ErrLog("interrupt clear error (%d)", DevStatus);
+                if (Status == VL53L0X_ERROR_NONE)
+                    Status = DevStatus;
+            }
+        }
+    }
+
+    return Status;
+}
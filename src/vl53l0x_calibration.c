@@ -0,0 +1,296 @@
+/*
+ * File : vl53l0x_calibration.c
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#include <math.h>
+
+#include "vl53l0x_calibration.h"
+
+#define FIX1616_TO_FLOAT(x) ((float)(x) / 65536.0f)
+#define FLOAT_TO_FIX1616(x) ((FixPoint1616_t)((x) * 65536.0f + 0.5f))
+
+void VL53L0X_RunningStats_reset(VL53L0X_RunningStats_t *stats)
+{
+    stats->count = 0;
+    stats->mean = 0.0f;
+    stats->m2 = 0.0f;
+}
+
+void VL53L0X_RunningStats_add(VL53L0X_RunningStats_t *stats, float x)
+{
+    float delta = x - stats->mean;
+
+    stats->count++;
+    stats->mean += delta / stats->count;
+    stats->m2 += delta * (x - stats->mean);
+}
+
+float VL53L0X_RunningStats_variance(const VL53L0X_RunningStats_t *stats)
+{
+    if (stats->count < 2)
+        return 0.0f;
+
+    return stats->m2 / (stats->count - 1);
+}
+
+VL53L0X_Error VL53L0X_Calibration_begin(VL53L0X_Calibration_t *cal, VL53L0X_Dev_t *device,
+                                        VL53L0X_CalibrationKind_t kind, FixPoint1616_t distance,
+                                        const VL53L0X_CalibrationConfig_t *config)
+{
+    VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+    const VL53L0X_CalibrationConfig_t offset_default = VL53L0X_CALIBRATION_OFFSET_DEFAULT;
+    const VL53L0X_CalibrationConfig_t xtalk_default = VL53L0X_CALIBRATION_XTALK_DEFAULT;
+
+    cal->device = device;
+    cal->kind = kind;
+    cal->distance = distance;
+    cal->tcc_enabled = 0;
+    cal->done = 0;
+
+    if (config != NULL)
+        cal->config = *config;
+    else
+        cal->config = (kind == VL53L0X_CALIBRATION_OFFSET) ? offset_default : xtalk_default;
+
+    VL53L0X_RunningStats_reset(&cal->quantity);
+    VL53L0X_RunningStats_reset(&cal->range);
+    VL53L0X_RunningStats_reset(&cal->signal);
+    VL53L0X_RunningStats_reset(&cal->spads);
+
+    cal->report.Measurements = 0;
+    cal->report.ValidSamples = 0;
+    cal->report.Converged = 0;
+    cal->report.Mean = 0;
+    cal->report.HalfWidth = 0;
+
+    if (distance <= 0 || cal->config.MaxSamples == 0)
+        return VL53L0X_ERROR_INVALID_PARAMS;
+
+    // same preparation as vl53l0x_api_calibration.c
+    if (kind == VL53L0X_CALIBRATION_OFFSET)
+    {
+        Status = VL53L0X_SetOffsetCalibrationDataMicroMeter(device, 0);
+        if (Status == VL53L0X_ERROR_NONE)
+            Status = VL53L0X_GetSequenceStepEnable(device, VL53L0X_SEQUENCESTEP_TCC,
+                                                   &cal->tcc_enabled);
+        if (Status == VL53L0X_ERROR_NONE)
+            Status = VL53L0X_SetSequenceStepEnable(device, VL53L0X_SEQUENCESTEP_TCC, 0);
+    }
+    else
+    {
+        Status = VL53L0X_SetXTalkCompensationEnable(device, 0);
+    }
+
+    if (Status == VL53L0X_ERROR_NONE)
+        Status = VL53L0X_SetLimitCheckEnable(device, VL53L0X_CHECKENABLE_RANGE_IGNORE_THRESHOLD, 0);
+
+    if (Status == VL53L0X_ERROR_NONE)
+        Status = VL53L0X_SingleShot_prepare(&cal->shot, device);
+
+    return Status;
+}
+
+static void account(VL53L0X_Calibration_t *cal, const VL53L0X_RangingMeasurementData_t *data)
+{
+    VL53L0X_CalibrationConfig_t *config = &cal->config;
+    VL53L0X_RunningStats_t *quantity = &cal->quantity;
+    float range_mm;
+    float signal;
+    uint16_t spads;
+    float half_width;
+
+    cal->report.Measurements++;
+
+    if (data != NULL && data->RangeStatus == 0)
+    {
+        range_mm = data->RangeMilliMeter;
+        signal = FIX1616_TO_FLOAT(data->SignalRateRtnMegaCps);
+        spads = data->EffectiveSpadRtnCount / 256;
+
+        cal->report.ValidSamples++;
+        VL53L0X_RunningStats_add(&cal->range, range_mm);
+        VL53L0X_RunningStats_add(&cal->signal, signal);
+        VL53L0X_RunningStats_add(&cal->spads, spads);
+
+        if (cal->kind == VL53L0X_CALIBRATION_OFFSET)
+            VL53L0X_RunningStats_add(quantity, range_mm);
+        else if (spads != 0)
+            // crosstalk estimate of this sample alone
+            VL53L0X_RunningStats_add(quantity,
+                signal / spads * (1.0f - range_mm / FIX1616_TO_FLOAT(cal->distance)));
+    }
+
+    half_width = FIX1616_TO_FLOAT(config->ConfidenceZ) *
+                 sqrtf(VL53L0X_RunningStats_variance(quantity) / (quantity->count ? quantity->count : 1));
+
+    cal->report.Mean = quantity->mean > 0 ? FLOAT_TO_FIX1616(quantity->mean) : 0;
+    cal->report.HalfWidth = FLOAT_TO_FIX1616(half_width);
+
+    if (quantity->count >= 2 && quantity->count >= config->MinSamples &&
+        half_width <= FIX1616_TO_FLOAT(config->Tolerance))
+    {
+        cal->report.Converged = 1;
+        cal->done = 1;
+    }
+
+    if (cal->report.Measurements >= config->MaxSamples)
+        cal->done = 1;
+}
+
+void VL53L0X_Calibration_addSample(VL53L0X_Calibration_t *cal,
+                                   const VL53L0X_RangingMeasurementData_t *pRangingMeasurementData)
+{
+    account(cal, pRangingMeasurementData);
+}
+
+VL53L0X_Error VL53L0X_Calibration_step(VL53L0X_Calibration_t *cal)
+{
+    VL53L0X_Error Status;
+    VL53L0X_RangingMeasurementData_t data;
+
+    Status = VL53L0X_SingleShot_measure(&cal->shot, &data);
+
+    if (Status == VL53L0X_ERROR_NONE)
+        account(cal, &data);
+    else if (Status == VL53L0X_ERROR_RANGE_ERROR)
+    {
+        // no valid range in this sample, not a failure of the run
+        account(cal, NULL);
+        Status = VL53L0X_ERROR_NONE;
+    }
+
+    return Status;
+}
+
+static VL53L0X_Error finish_offset(VL53L0X_Calibration_t *cal, int32_t *pOffsetMicroMeter)
+{
+    VL53L0X_Error Status;
+    VL53L0X_Dev_t *device = cal->device;
+    uint32_t StoredMeanRangeAsInt;
+    uint32_t CalDistanceAsInt_mm;
+    int32_t OffsetMicroMeter;
+
+    StoredMeanRangeAsInt = (uint32_t)(cal->range.mean + 0.5f);
+    CalDistanceAsInt_mm = (cal->distance + 0x8000) >> 16;
+
+    OffsetMicroMeter = ((int32_t)CalDistanceAsInt_mm - (int32_t)StoredMeanRangeAsInt) * 1000;
+
+    VL53L0X_SETPARAMETERFIELD(device, RangeOffsetMicroMeters, OffsetMicroMeter);
+    Status = VL53L0X_SetOffsetCalibrationDataMicroMeter(device, OffsetMicroMeter);
+
+    if (pOffsetMicroMeter != NULL)
+        *pOffsetMicroMeter = OffsetMicroMeter;
+
+    return Status;
+}
+
+static VL53L0X_Error finish_xtalk(VL53L0X_Calibration_t *cal, FixPoint1616_t *pXTalkCompensationRateMegaCps)
+{
+    VL53L0X_Error Status;
+    VL53L0X_Dev_t *device = cal->device;
+    FixPoint1616_t xTalkStoredMeanSignalRate;
+    FixPoint1616_t xTalkStoredMeanRange;
+    uint32_t xTalkStoredMeanRtnSpadsAsInt;
+    uint32_t xTalkCalDistanceAsInt;
+    uint32_t signalXTalkTotalPerSpad;
+    FixPoint1616_t XTalkCompensationRateMegaCps;
+
+    // same computation as VL53L0X_perform_xtalk_calibration, from the running means
+    xTalkStoredMeanSignalRate = FLOAT_TO_FIX1616(cal->signal.mean);
+    xTalkStoredMeanRange = FLOAT_TO_FIX1616(cal->range.mean);
+    xTalkStoredMeanRtnSpadsAsInt = (uint32_t)(cal->spads.mean + 0.5f);
+    xTalkCalDistanceAsInt = (cal->distance + 0x8000) >> 16;
+
+    if (xTalkStoredMeanRtnSpadsAsInt == 0 ||
+        xTalkCalDistanceAsInt == 0 ||
+        xTalkStoredMeanRange >= cal->distance)
+    {
+        XTalkCompensationRateMegaCps = 0;
+    }
+    else
+    {
+        signalXTalkTotalPerSpad = xTalkStoredMeanSignalRate / xTalkStoredMeanRtnSpadsAsInt;
+        signalXTalkTotalPerSpad *= ((1 << 16) - (xTalkStoredMeanRange / xTalkCalDistanceAsInt));
+        XTalkCompensationRateMegaCps = (signalXTalkTotalPerSpad + 0x8000) >> 16;
+    }
+
+    Status = VL53L0X_SetXTalkCompensationEnable(device, 1);
+    if (Status == VL53L0X_ERROR_NONE)
+        Status = VL53L0X_SetXTalkCompensationRateMegaCps(device, XTalkCompensationRateMegaCps);
+
+    if (pXTalkCompensationRateMegaCps != NULL)
+        *pXTalkCompensationRateMegaCps = XTalkCompensationRateMegaCps;
+
+    return Status;
+}
+
+VL53L0X_Error VL53L0X_Calibration_finish(VL53L0X_Calibration_t *cal, int32_t *pOffsetMicroMeter,
+                                         FixPoint1616_t *pXTalkCompensationRateMegaCps)
+{
+    VL53L0X_Error Status;
+
+    // no valid values found
+    if (cal->report.ValidSamples == 0)
+        Status = VL53L0X_ERROR_RANGE_ERROR;
+    else if (cal->kind == VL53L0X_CALIBRATION_OFFSET)
+        Status = finish_offset(cal, pOffsetMicroMeter);
+    else
+        Status = finish_xtalk(cal, pXTalkCompensationRateMegaCps);
+
+    // restore the TCC
+    if (cal->tcc_enabled)
+    {
+        VL53L0X_Error RestoreStatus = VL53L0X_SetSequenceStepEnable(cal->device,
+                                          VL53L0X_SEQUENCESTEP_TCC, 1);
+        if (Status == VL53L0X_ERROR_NONE)
+            Status = RestoreStatus;
+    }
+
+    return Status;
+}
+
+static VL53L0X_Error run(VL53L0X_Dev_t *device, VL53L0X_CalibrationKind_t kind, FixPoint1616_t distance,
+                         const VL53L0X_CalibrationConfig_t *config, int32_t *pOffsetMicroMeter,
+                         FixPoint1616_t *pXTalkCompensationRateMegaCps,
+                         VL53L0X_CalibrationReport_t *report)
+{
+    VL53L0X_Error Status;
+    VL53L0X_Calibration_t cal;
+
+    Status = VL53L0X_Calibration_begin(&cal, device, kind, distance, config);
+
+    while (Status == VL53L0X_ERROR_NONE && !cal.done)
+        Status = VL53L0X_Calibration_step(&cal);
+
+    if (Status == VL53L0X_ERROR_NONE)
+        Status = VL53L0X_Calibration_finish(&cal, pOffsetMicroMeter, pXTalkCompensationRateMegaCps);
+    else if (cal.tcc_enabled)
+        VL53L0X_SetSequenceStepEnable(device, VL53L0X_SEQUENCESTEP_TCC, 1);
+
+    if (report != NULL)
+        *report = cal.report;
+
+    return Status;
+}
+
+VL53L0X_Error VL53L0X_Calibration_offset(VL53L0X_Dev_t *device, FixPoint1616_t CalDistanceMilliMeter,
+                                         const VL53L0X_CalibrationConfig_t *config,
+                                         int32_t *pOffsetMicroMeter,
+                                         VL53L0X_CalibrationReport_t *report)
+{
+    return run(device, VL53L0X_CALIBRATION_OFFSET, CalDistanceMilliMeter, config,
+               pOffsetMicroMeter, NULL, report);
+}
+
+VL53L0X_Error VL53L0X_Calibration_xtalk(VL53L0X_Dev_t *device, FixPoint1616_t XTalkCalDistance,
+                                        const VL53L0X_CalibrationConfig_t *config,
+                                        FixPoint1616_t *pXTalkCompensationRateMegaCps,
+                                        VL53L0X_CalibrationReport_t *report)
+{
+    return run(device, VL53L0X_CALIBRATION_XTALK, XTalkCalDistance, config,
+               NULL, pXTalkCompensationRateMegaCps, report);
+}
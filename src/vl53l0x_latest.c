@@ -0,0 +1,63 @@
+/*
+ * File : vl53l0x_latest.c
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#include "vl53l0x_latest.h"
+
+#include <string.h>
+
+#include "esp_timer.h"
+
+void VL53L0X_Latest_init(VL53L0X_Latest_t *latest)
+{
+    memset(latest, 0, sizeof(*latest));
+}
+
+void VL53L0X_Latest_publish(VL53L0X_Latest_t *latest,
+                            const VL53L0X_RangingMeasurementData_t *pRangingMeasurementData)
+{
+    uint32_t seq = __atomic_load_n(&latest->seq, __ATOMIC_RELAXED);
+    uint32_t next = seq + 2 != 0 ? seq + 2 : 2;     // 0 stays the empty register
+    VL53L0X_LatestCopy_t copy = {
+        .Data = *pRangingMeasurementData,
+        .timestamp_us = esp_timer_get_time(),
+    };
+
+    // odd : readers move to copy[1] while copy[0] is written
+    __atomic_store_n(&latest->seq, seq + 1, __ATOMIC_RELEASE);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    latest->copy[0] = copy;
+
+    // even : back to copy[0], copy[1] follows
+    __atomic_store_n(&latest->seq, next, __ATOMIC_RELEASE);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    latest->copy[1] = copy;
+}
+
+uint32_t VL53L0X_Latest_read(const VL53L0X_Latest_t *latest,
+                             VL53L0X_RangingMeasurementData_t *pRangingMeasurementData,
+                             int64_t *ptimestamp_us)
+{
+    VL53L0X_LatestCopy_t copy;
+    uint32_t seq;
+
+    do
+    {
+        seq = __atomic_load_n(&latest->seq, __ATOMIC_ACQUIRE);
+        if (seq < 2)
+            return 0;
+
+        copy = latest->copy[seq & 1];
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    } while (__atomic_load_n(&latest->seq, __ATOMIC_RELAXED) != seq);
+
+    *pRangingMeasurementData = copy.Data;
+    if (ptimestamp_us != NULL)
+        *ptimestamp_us = copy.timestamp_us;
+
+    return seq >> 1;
+}
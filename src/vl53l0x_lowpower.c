@@ -0,0 +1,220 @@
+/*
+ * File : vl53l0x_lowpower.c
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#include "vl53l0x_lowpower.h"
+#include "vl53l0x_measurement.h"
+#include "vl53l0x_platform_esp32.h"
+
+#include "esp_log.h"
+
+#ifdef VL53L0X_LOG_ENABLE
+static const char* TAG = "vl53l0x_lp";
+
+#define LowPower_ErrLog(fmt, ...) \
+    VL53L0X_DRIVER_LOG(ESP_LOG_ERROR, TAG, "%s " fmt, __func__, ##__VA_ARGS__)
+#else
+#define LowPower_ErrLog(fmt, ...) (void)0
+#endif
+
+// ready poll + result block + ref signal read + interrupt clear
+#define NOMINAL_BUS_BYTES_PER_SAMPLE    40
+// 8 data bits + ack
+#define I2C_BITS_PER_BYTE               9
+
+static VL53L0X_Error apply_config(VL53L0X_LowPower_t *lp)
+{
+    VL53L0X_Error Status;
+    VL53L0X_Dev_t *device = lp->device;
+
+    Status = VL53L0X_SetDeviceMode(device, VL53L0X_DEVICEMODE_CONTINUOUS_TIMED_RANGING);
+    if (Status == VL53L0X_ERROR_NONE)
+        Status = VL53L0X_SetMeasurementTimingBudgetMicroSeconds(device,
+                    lp->config.TimingBudgetMicroSeconds);
+    if (Status == VL53L0X_ERROR_NONE)
+        Status = VL53L0X_SetInterMeasurementPeriodMilliSeconds(device,
+                    lp->config.InterMeasurementPeriodMilliSeconds);
+    if (Status == VL53L0X_ERROR_NONE)
+        Status = VL53L0X_Measurement_start(device);
+
+    return Status;
+}
+
+static bool config_is_valid(const VL53L0X_LowPowerConfig_t *config)
+{
+    // the device needs the whole budget inside one period
+    return config->TimingBudgetMicroSeconds > 0 &&
+        (uint64_t)config->InterMeasurementPeriodMilliSeconds * 1000 >=
+            config->TimingBudgetMicroSeconds;
+}
+
+VL53L0X_Error VL53L0X_LowPower_init(VL53L0X_LowPower_t *lp, VL53L0X_Dev_t *device,
+                                    const VL53L0X_LowPowerConfig_t *config)
+{
+    VL53L0X_Error Status;
+    const VL53L0X_EnergyModel_t model = VL53L0X_ENERGY_MODEL_DEFAULT;
+
+    if (!config_is_valid(config))
+        return VL53L0X_ERROR_INVALID_PARAMS;
+
+    lp->device = device;
+    lp->config = *config;
+    lp->model = model;
+    lp->standby = 0;
+    lp->samples = 0;
+    lp->bus_bytes = 0;
+
+    Status = VL53L0X_Device_setup(device);
+    if (Status != VL53L0X_ERROR_NONE)
+        return Status;
+
+    // keep the reference calibration, StaticInit on resume reloads the tuning
+    Status = VL53L0X_GetRefCalibration(device, &lp->VhvSettings, &lp->PhaseCal);
+    if (Status != VL53L0X_ERROR_NONE)
+    {
+        LowPower_ErrLog("VL53L0X_GetRefCalibration error (%d)", Status);
+        return Status;
+    }
+
+    Status = apply_config(lp);
+    if (Status != VL53L0X_ERROR_NONE)
+        LowPower_ErrLog("timed ranging start error (%d)", Status);
+
+    return Status;
+}
+
+VL53L0X_Error VL53L0X_LowPower_configure(VL53L0X_LowPower_t *lp,
+                                         const VL53L0X_LowPowerConfig_t *config)
+{
+    VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+
+    if (!config_is_valid(config))
+        return VL53L0X_ERROR_INVALID_PARAMS;
+
+    lp->config = *config;
+    lp->samples = 0;
+    lp->bus_bytes = 0;
+
+    // applied on resume
+    if (lp->standby)
+        return Status;
+
+    Status = VL53L0X_Device_deinit(lp->device);
+    if (Status == VL53L0X_ERROR_NONE)
+        Status = apply_config(lp);
+
+    return Status;
+}
+
+VL53L0X_Error VL53L0X_LowPower_standby(VL53L0X_LowPower_t *lp)
+{
+    VL53L0X_Error Status;
+
+    if (lp->standby)
+        return VL53L0X_ERROR_NONE;
+
+    Status = VL53L0X_Device_deinit(lp->device);
+    if (Status == VL53L0X_ERROR_NONE)
+        Status = VL53L0X_SetPowerMode(lp->device, VL53L0X_POWERMODE_STANDBY_LEVEL1);
+
+    if (Status == VL53L0X_ERROR_NONE)
+        lp->standby = 1;
+    else
+        LowPower_ErrLog("standby error (%d)", Status);
+
+    return Status;
+}
+
+VL53L0X_Error VL53L0X_LowPower_resume(VL53L0X_LowPower_t *lp)
+{
+    VL53L0X_Error Status;
+
+    if (!lp->standby)
+        return VL53L0X_ERROR_NONE;
+
+    Status = VL53L0X_SetPowerMode(lp->device, VL53L0X_POWERMODE_IDLE_LEVEL1);
+    if (Status == VL53L0X_ERROR_NONE)
+        Status = VL53L0X_SetRefCalibration(lp->device, lp->VhvSettings, lp->PhaseCal);
+    if (Status == VL53L0X_ERROR_NONE)
+        Status = apply_config(lp);
+
+    if (Status == VL53L0X_ERROR_NONE)
+        lp->standby = 0;
+    else
+        LowPower_ErrLog("resume error (%d)", Status);
+
+    return Status;
+}
+
+VL53L0X_Error VL53L0X_LowPower_getMeasurement(VL53L0X_LowPower_t *lp, uint16_t *data)
+{
+    VL53L0X_Error Status;
+    uint32_t before;
+
+    if (lp->standby)
+        return VL53L0X_ERROR_INVALID_COMMAND;
+
+    // bytes of this device only, whatever else goes on its bus meanwhile
+    before = lp->device->BusBytes;
+    Status = VL53L0X_Device_getMeasurement(lp->device, data);
+
+    // a filtered out sample still cost its bus traffic
+    if (Status == VL53L0X_ERROR_NONE || Status == VL53L0X_ERROR_UNDEFINED)
+    {
+        lp->samples++;
+        lp->bus_bytes += lp->device->BusBytes - before;
+    }
+
+    return Status;
+}
+
+// mV * uA * us = 1e-15 J, scaled to nJ
+static uint32_t energy_nj(uint32_t mv, uint32_t ua, uint64_t us)
+{
+    return (uint32_t)(((uint64_t)mv * ua * us) / 1000000);
+}
+
+void VL53L0X_LowPower_estimateEnergy(const VL53L0X_LowPower_t *lp,
+                                     VL53L0X_EnergyEstimate_t *estimate)
+{
+    VL53L0X_Dev_t *device = lp->device;
+    const VL53L0X_EnergyModel_t *model = &lp->model;
+    uint32_t budget_us = lp->config.TimingBudgetMicroSeconds;
+    uint64_t period_us = (uint64_t)lp->config.InterMeasurementPeriodMilliSeconds * 1000;
+    uint32_t pre_us = VL53L0X_GETDEVICESPECIFICPARAMETER(device, PreRangeTimeoutMicroSecs);
+    uint32_t final_us = VL53L0X_GETDEVICESPECIFICPARAMETER(device, FinalRangeTimeoutMicroSecs);
+    uint8_t pre_pclks = VL53L0X_GETDEVICESPECIFICPARAMETER(device, PreRangeVcselPulsePeriod);
+    uint8_t final_pclks = VL53L0X_GETDEVICESPECIFICPARAMETER(device, FinalRangeVcselPulsePeriod);
+    uint16_t speed_khz = device->comms_speed_khz ? device->comms_speed_khz : 400;
+    uint64_t vcsel_us;
+    uint64_t bus_us;
+
+    // VCSEL pulse energy grows with the pulse period of each phase
+    vcsel_us = ((uint64_t)pre_us * pre_pclks) / VL53L0X_ENERGY_REF_PRE_RANGE_PCLKS +
+        ((uint64_t)final_us * final_pclks) / VL53L0X_ENERGY_REF_FINAL_RANGE_PCLKS;
+
+    estimate->RangingNanoJoule =
+        energy_nj(model->SupplyMilliVolt, model->DigitalMicroAmp, budget_us) +
+        energy_nj(model->SupplyMilliVolt, model->VcselMicroAmp, vcsel_us);
+
+    estimate->IdleNanoJoule = (period_us > budget_us) ?
+        energy_nj(model->SupplyMilliVolt, model->TimedIdleMicroAmp, period_us - budget_us) : 0;
+
+    estimate->BusBytesPerSample = lp->samples ?
+        lp->bus_bytes / lp->samples : NOMINAL_BUS_BYTES_PER_SAMPLE;
+    bus_us = ((uint64_t)estimate->BusBytesPerSample * I2C_BITS_PER_BYTE * 1000) / speed_khz;
+    estimate->BusNanoJoule = energy_nj(model->SupplyMilliVolt, model->BusMicroAmp, bus_us);
+
+    estimate->TotalNanoJoule = estimate->RangingNanoJoule +
+        estimate->IdleNanoJoule + estimate->BusNanoJoule;
+
+    // nJ / ms = uW
+    estimate->AverageMicroWatt = lp->config.InterMeasurementPeriodMilliSeconds ?
+        estimate->TotalNanoJoule / lp->config.InterMeasurementPeriodMilliSeconds : 0;
+    estimate->StandbyMicroWatt =
+        (uint32_t)(((uint64_t)model->SupplyMilliVolt * model->StandbyMicroAmp) / 1000);
+}
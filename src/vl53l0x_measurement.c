@@ -0,0 +1,271 @@
+/*
+ * File : vl53l0x_measurement.c
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#include "vl53l0x_measurement.h"
+#include "vl53l0x_api_core.h"
+#include "vl53l0x_platform_esp32.h"
+
+// defined in vl53l0x_api.c through vl53l0x_interrupt_threshold_settings.h
+extern uint8_t InterruptThresholdSettings[];
+
+#define STOP_VARIABLE_INDEX     3
+
+// stop variable sequence of VL53L0X_StartMeasurement, value at STOP_VARIABLE_INDEX
+static const uint8_t start_prefix[] = {
+    0x80, 0x01,
+    0xFF, 0x01,
+    0x00, 0x00,
+    0x91, 0x00,
+    0x00, 0x01,
+    0xFF, 0x00,
+    0x80, 0x00,
+};
+
+// registers of the threshold settings cleared by a stop, as the settings leave them
+static const uint8_t thresholds_resume[] = {
+    0x80, 0x01,
+    0xFF, 0x01,
+    0x00, 0x00,
+    0xFF, 0x04,
+    0x70, 0x01,
+    0xFF, 0x01,
+    0x00, 0x01,
+    0xFF, 0x00,
+};
+
+// VL53L0X_StopMeasurement
+static const uint8_t stop_sequence[] = {
+    VL53L0X_REG_SYSRANGE_START, VL53L0X_REG_SYSRANGE_MODE_SINGLESHOT,
+    0xFF, 0x01,
+    0x00, 0x00,
+    0x91, 0x00,
+    0x00, 0x01,
+    0xFF, 0x00,
+};
+
+// stop part of VL53L0X_CheckAndLoadInterruptSettings
+static const uint8_t thresholds_park[] = {
+    0xFF, 0x04,
+    0x70, 0x00,
+    0xFF, 0x00,
+    0x80, 0x00,
+};
+
+#define PAIRS(a) (sizeof(a) / 2)
+
+typedef struct {
+    uint8_t pairs[2 * VL53L0X_SEQUENCE_CHUNK];
+    uint32_t count;
+} Sequence_t;
+
+static VL53L0X_Error flush(VL53L0X_DEV Dev, Sequence_t *seq)
+{
+    VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+
+    if (seq->count > 0)
+        Status = VL53L0X_WriteSequence(Dev, seq->pairs, seq->count);
+    seq->count = 0;
+
+    return Status;
+}
+
+static VL53L0X_Error push(VL53L0X_DEV Dev, Sequence_t *seq, uint8_t index, uint8_t value)
+{
+    seq->pairs[2 * seq->count] = index;
+    seq->pairs[2 * seq->count + 1] = value;
+    seq->count++;
+
+    return seq->count == VL53L0X_SEQUENCE_CHUNK ? flush(Dev, seq) : VL53L0X_ERROR_NONE;
+}
+
+static VL53L0X_Error push_all(VL53L0X_DEV Dev, Sequence_t *seq, const uint8_t *pairs, uint32_t count)
+{
+    VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+    uint32_t i;
+
+    for (i = 0; i < count && Status == VL53L0X_ERROR_NONE; i++)
+        Status = push(Dev, seq, pairs[2 * i], pairs[2 * i + 1]);
+
+    return Status;
+}
+
+// VL53L0X_load_tuning_settings with the single register writes batched
+static VL53L0X_Error push_settings(VL53L0X_DEV Dev, Sequence_t *seq, uint8_t *pTuningSettingBuffer)
+{
+    VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+    int Index = 0;
+
+    while (pTuningSettingBuffer[Index] == 1 && Status == VL53L0X_ERROR_NONE)
+    {
+        Status = push(Dev, seq, pTuningSettingBuffer[Index + 1], pTuningSettingBuffer[Index + 2]);
+        Index += 3;
+    }
+
+    // anything else (internal parameters, multi byte writes) as the API does
+    if (Status == VL53L0X_ERROR_NONE && pTuningSettingBuffer[Index] != 0)
+    {
+        Status = flush(Dev, seq);
+        if (Status == VL53L0X_ERROR_NONE)
+            Status = VL53L0X_load_tuning_settings(Dev, &pTuningSettingBuffer[Index]);
+    }
+
+    return Status;
+}
+
+// same rule as VL53L0X_CheckAndLoadInterruptSettings
+static VL53L0X_Error thresholds_used(VL53L0X_DEV Dev, uint8_t *pUsed)
+{
+    VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+    uint8_t InterruptConfig = VL53L0X_GETDEVICESPECIFICPARAMETER(Dev, Pin0GpioFunctionality);
+    FixPoint1616_t ThresholdLow;
+    FixPoint1616_t ThresholdHigh;
+
+    *pUsed = 0;
+
+    switch (InterruptConfig)
+    {
+    case VL53L0X_GPIOFUNCTIONALITY_THRESHOLD_CROSSED_LOW:
+        Status = VL53L0X_GetInterruptThresholds(Dev, VL53L0X_DEVICEMODE_CONTINUOUS_RANGING,
+                                                &ThresholdLow, &ThresholdHigh);
+        *pUsed = ThresholdLow > 255 * 65536;
+        break;
+
+    case VL53L0X_GPIOFUNCTIONALITY_THRESHOLD_CROSSED_HIGH:
+        Status = VL53L0X_GetInterruptThresholds(Dev, VL53L0X_DEVICEMODE_CONTINUOUS_RANGING,
+                                                &ThresholdLow, &ThresholdHigh);
+        *pUsed = ThresholdHigh > 0;
+        break;
+
+    case VL53L0X_GPIOFUNCTIONALITY_THRESHOLD_CROSSED_OUT:
+        *pUsed = 1;
+        break;
+
+    default:
+        break;
+    }
+
+    if (Status != VL53L0X_ERROR_NONE)
+        *pUsed = 0;
+
+    return Status;
+}
+
+static VL53L0X_Error wait_start_cleared(VL53L0X_DEV Dev)
+{
+    VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+    uint8_t Byte;
+    uint32_t LoopNb = 0;
+
+    // same loop as VL53L0X_StartMeasurement
+    do
+    {
+        Status = VL53L0X_RdByte(Dev, VL53L0X_REG_SYSRANGE_START, &Byte);
+        LoopNb++;
+    } while ((Byte & VL53L0X_REG_SYSRANGE_MODE_START_STOP) &&
+             Status == VL53L0X_ERROR_NONE && LoopNb < VL53L0X_DEFAULT_MAX_LOOP);
+
+    if (LoopNb >= VL53L0X_DEFAULT_MAX_LOOP)
+        Status = VL53L0X_ERROR_TIME_OUT;
+
+    return Status;
+}
+
+VL53L0X_Error VL53L0X_Measurement_start(VL53L0X_DEV Dev)
+{
+    VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+    VL53L0X_DeviceModes DeviceMode;
+    Sequence_t seq;
+    uint8_t StartByte;
+    uint8_t used = 0;
+
+    VL53L0X_GetDeviceMode(Dev, &DeviceMode);
+
+    switch (DeviceMode)
+    {
+    case VL53L0X_DEVICEMODE_SINGLE_RANGING:
+        StartByte = VL53L0X_REG_SYSRANGE_MODE_START_STOP;
+        break;
+    case VL53L0X_DEVICEMODE_CONTINUOUS_RANGING:
+        StartByte = VL53L0X_REG_SYSRANGE_MODE_BACKTOBACK;
+        Status = thresholds_used(Dev, &used);
+        break;
+    case VL53L0X_DEVICEMODE_CONTINUOUS_TIMED_RANGING:
+        StartByte = VL53L0X_REG_SYSRANGE_MODE_TIMED;
+        Status = thresholds_used(Dev, &used);
+        break;
+    default:
+        return VL53L0X_ERROR_MODE_NOT_SUPPORTED;
+    }
+
+    if (Status != VL53L0X_ERROR_NONE)
+        return Status;
+
+    seq.count = 0;
+    Status = push_all(Dev, &seq, start_prefix, PAIRS(start_prefix));
+    seq.pairs[STOP_VARIABLE_INDEX * 2 + 1] = PALDevDataGet(Dev, StopVariable);
+
+    // only what the device misses of the threshold settings
+    if (Status == VL53L0X_ERROR_NONE && used)
+    {
+        if (Dev->InterruptSettings == VL53L0X_INTERRUPT_SETTINGS_PARKED)
+            Status = push_all(Dev, &seq, thresholds_resume, PAIRS(thresholds_resume));
+        else if (Dev->InterruptSettings != VL53L0X_INTERRUPT_SETTINGS_LOADED)
+            Status = push_settings(Dev, &seq, InterruptThresholdSettings);
+    }
+
+    if (Status == VL53L0X_ERROR_NONE)
+        Status = push(Dev, &seq, VL53L0X_REG_SYSRANGE_START, StartByte);
+    if (Status == VL53L0X_ERROR_NONE)
+        Status = flush(Dev, &seq);
+
+    if (used)
+        Dev->InterruptSettings = (Status == VL53L0X_ERROR_NONE) ?
+            VL53L0X_INTERRUPT_SETTINGS_LOADED : VL53L0X_INTERRUPT_SETTINGS_UNKNOWN;
+
+    if (Status != VL53L0X_ERROR_NONE)
+        return Status;
+
+    if (DeviceMode == VL53L0X_DEVICEMODE_SINGLE_RANGING)
+        Status = wait_start_cleared(Dev);
+    else
+        PALDevDataSet(Dev, PalState, VL53L0X_STATE_RUNNING);
+
+    return Status;
+}
+
+VL53L0X_Error VL53L0X_Measurement_stop(VL53L0X_DEV Dev)
+{
+    VL53L0X_Error Status;
+    Sequence_t seq;
+    uint8_t used;
+
+    Status = thresholds_used(Dev, &used);
+    if (Status != VL53L0X_ERROR_NONE)
+        return Status;
+
+    seq.count = 0;
+    Status = push_all(Dev, &seq, stop_sequence, PAIRS(stop_sequence));
+    if (Status == VL53L0X_ERROR_NONE && used)
+        Status = push_all(Dev, &seq, thresholds_park, PAIRS(thresholds_park));
+    if (Status == VL53L0X_ERROR_NONE)
+        Status = flush(Dev, &seq);
+
+    if (Status != VL53L0X_ERROR_NONE)
+    {
+        if (used)
+            Dev->InterruptSettings = VL53L0X_INTERRUPT_SETTINGS_UNKNOWN;
+        return Status;
+    }
+
+    PALDevDataSet(Dev, PalState, VL53L0X_STATE_IDLE);
+
+    if (used && Dev->InterruptSettings == VL53L0X_INTERRUPT_SETTINGS_LOADED)
+        Dev->InterruptSettings = VL53L0X_INTERRUPT_SETTINGS_PARKED;
+
+    return Status;
+}
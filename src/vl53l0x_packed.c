@@ -0,0 +1,130 @@
+/*
+ * File : vl53l0x_packed.c
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#include "vl53l0x_packed.h"
+
+#define PACKED_STATUS_NONE      7
+#define PACKED_FRACTIONAL       0x8000
+
+// 16.16 rate of a 9.7 register
+#define RATE_FITS(rate)         (((rate) & 0xFE0001FF) == 0)
+
+static inline void put16(uint8_t *p, uint16_t value)
+{
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+}
+
+static inline uint16_t get16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+uint8_t VL53L0X_Packed_fits(const VL53L0X_RangingMeasurementData_t *pRangingMeasurementData)
+{
+    const VL53L0X_RangingMeasurementData_t *d = pRangingMeasurementData;
+
+    if (d->ZoneId != 0 || d->MeasurementTimeUsec != 0)
+        return 0;
+    if (!RATE_FITS(d->SignalRateRtnMegaCps) || !RATE_FITS(d->AmbientRateRtnMegaCps))
+        return 0;
+    if (d->RangeStatus >= PACKED_STATUS_NONE && d->RangeStatus != 255)
+        return 0;
+    if (d->RangeFractionalPart != 0 && ((d->RangeFractionalPart & 0x3F) != 0 || d->RangeMilliMeter > 0x3FFF))
+        return 0;
+
+    return 1;
+}
+
+uint32_t VL53L0X_Packed_encode(const VL53L0X_RangingMeasurementData_t *pRangingMeasurementData,
+                               uint32_t count, uint32_t *pTimeStamp,
+                               VL53L0X_PackedSample_t *packed)
+{
+    const VL53L0X_RangingMeasurementData_t *d;
+    uint32_t previous = *pTimeStamp;
+    uint32_t delta;
+    uint16_t range;
+    uint16_t flags;
+    uint8_t *p;
+    uint32_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        d = &pRangingMeasurementData[i];
+        delta = d->TimeStamp - previous;
+        if (delta > VL53L0X_PACKED_DELTA_MAX || !VL53L0X_Packed_fits(d))
+            break;
+
+        range = d->RangeMilliMeter;
+        flags = (uint16_t)delta;
+        flags |= (uint16_t)((d->RangeStatus == 255 ? PACKED_STATUS_NONE : d->RangeStatus) << 12);
+        if (d->RangeFractionalPart != 0)
+        {
+            range = (uint16_t)((range << 2) | (d->RangeFractionalPart >> 6));
+            flags |= PACKED_FRACTIONAL;
+        }
+
+        p = packed[i].bytes;
+        put16(&p[0], range);
+        put16(&p[2], d->RangeDMaxMilliMeter);
+        put16(&p[4], (uint16_t)(d->SignalRateRtnMegaCps >> 9));
+        put16(&p[6], (uint16_t)(d->AmbientRateRtnMegaCps >> 9));
+        put16(&p[8], d->EffectiveSpadRtnCount);
+        put16(&p[10], flags);
+
+        previous = d->TimeStamp;
+    }
+
+    *pTimeStamp = previous;
+    return i;
+}
+
+void VL53L0X_Packed_decode(const VL53L0X_PackedSample_t *packed, uint32_t count,
+                           uint32_t *pTimeStamp,
+                           VL53L0X_RangingMeasurementData_t *pRangingMeasurementData)
+{
+    VL53L0X_RangingMeasurementData_t *d;
+    uint32_t timestamp = *pTimeStamp;
+    uint16_t range;
+    uint16_t flags;
+    uint8_t status;
+    const uint8_t *p;
+    uint32_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        p = packed[i].bytes;
+        d = &pRangingMeasurementData[i];
+
+        range = get16(&p[0]);
+        flags = get16(&p[10]);
+        timestamp += flags & VL53L0X_PACKED_DELTA_MAX;
+        status = (uint8_t)((flags >> 12) & 0x07);
+
+        d->TimeStamp = timestamp;
+        d->MeasurementTimeUsec = 0;
+        if (flags & PACKED_FRACTIONAL)
+        {
+            d->RangeMilliMeter = range >> 2;
+            d->RangeFractionalPart = (uint8_t)((range & 0x03) << 6);
+        }
+        else
+        {
+            d->RangeMilliMeter = range;
+            d->RangeFractionalPart = 0;
+        }
+        d->RangeDMaxMilliMeter = get16(&p[2]);
+        d->SignalRateRtnMegaCps = (FixPoint1616_t)get16(&p[4]) << 9;
+        d->AmbientRateRtnMegaCps = (FixPoint1616_t)get16(&p[6]) << 9;
+        d->EffectiveSpadRtnCount = get16(&p[8]);
+        d->ZoneId = 0;
+        d->RangeStatus = status == PACKED_STATUS_NONE ? 255 : status;
+    }
+
+    *pTimeStamp = timestamp;
+}
@@ -0,0 +1,206 @@
+/*
+ * File : vl53l0x_params.c
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#include "vl53l0x_params.h"
+#include "vl53l0x_api_core.h"
+#include "vl53l0x_platform_esp32.h"
+
+// defined in vl53l0x_api_core.c, not exported by its header
+uint32_t VL53L0X_calc_timeout_us(VL53L0X_DEV Dev, uint16_t timeout_period_mclks,
+                                 uint8_t vcsel_period_pclks);
+
+// fixed overheads of VL53L0X_get_measurement_timing_budget_micro_seconds
+#define START_OVERHEAD_US       1910
+#define END_OVERHEAD_US         960
+#define MSRC_OVERHEAD_US        660
+#define TCC_OVERHEAD_US         590
+#define DSS_OVERHEAD_US         690
+#define PRE_RANGE_OVERHEAD_US   660
+#define FINAL_RANGE_OVERHEAD_US 550
+
+#define BE16(p) VL53L0X_MAKEUINT16((p)[1], (p)[0])
+#define BE32(p) (((uint32_t)(p)[0] << 24) | ((uint32_t)(p)[1] << 16) | ((uint32_t)(p)[2] << 8) | (uint32_t)(p)[3])
+
+VL53L0X_Error VL53L0X_Params_read(VL53L0X_DEV Dev, VL53L0X_ParamsImage_t *image)
+{
+    const VL53L0X_ReadBlock_t blocks[] = {
+        { VL53L0X_REG_SYSTEM_SEQUENCE_CONFIG, sizeof(image->system), image->system },
+        { VL53L0X_REG_CROSSTALK_COMPENSATION_PEAK_RATE_MCPS, sizeof(image->xtalk), image->xtalk },
+        { VL53L0X_REG_ALGO_PART_TO_PART_RANGE_OFFSET_MM, sizeof(image->offset), image->offset },
+        { VL53L0X_REG_FINAL_RANGE_CONFIG_MIN_COUNT_RATE_RTN_LIMIT, sizeof(image->final_limit), image->final_limit },
+        { VL53L0X_REG_PRE_RANGE_CONFIG_VCSEL_PERIOD, sizeof(image->pre_range), image->pre_range },
+        { VL53L0X_REG_PRE_RANGE_MIN_COUNT_RATE_RTN_LIMIT, sizeof(image->pre_limit), image->pre_limit },
+        { VL53L0X_REG_FINAL_RANGE_CONFIG_VCSEL_PERIOD, sizeof(image->final_range), image->final_range },
+        { VL53L0X_REG_OSC_CALIBRATE_VAL, sizeof(image->osc_calibrate), image->osc_calibrate },
+    };
+
+    return VL53L0X_ReadBlocks(Dev, blocks, sizeof(blocks) / sizeof(blocks[0]));
+}
+
+static void limit_check_value(VL53L0X_DEV Dev, const VL53L0X_ParamsImage_t *image,
+                              uint16_t LimitCheckId, FixPoint1616_t *pLimitCheckValue)
+{
+    FixPoint1616_t TempFix1616;
+
+    // same as VL53L0X_GetLimitCheckValue
+    switch (LimitCheckId)
+    {
+    case VL53L0X_CHECKENABLE_SIGNAL_RATE_FINAL_RANGE:
+        TempFix1616 = VL53L0X_FIXPOINT97TOFIXPOINT1616(BE16(image->final_limit));
+
+        if (TempFix1616 == 0)
+        {
+            // disabled: return value from memory
+            VL53L0X_GETARRAYPARAMETERFIELD(Dev, LimitChecksValue, LimitCheckId, TempFix1616);
+            VL53L0X_SETARRAYPARAMETERFIELD(Dev, LimitChecksEnable, LimitCheckId, 0);
+        }
+        else
+        {
+            VL53L0X_SETARRAYPARAMETERFIELD(Dev, LimitChecksValue, LimitCheckId, TempFix1616);
+            VL53L0X_SETARRAYPARAMETERFIELD(Dev, LimitChecksEnable, LimitCheckId, 1);
+        }
+        break;
+
+    case VL53L0X_CHECKENABLE_SIGNAL_RATE_MSRC:
+    case VL53L0X_CHECKENABLE_SIGNAL_RATE_PRE_RANGE:
+        TempFix1616 = VL53L0X_FIXPOINT97TOFIXPOINT1616(BE16(image->pre_limit));
+        break;
+
+    default:
+        // internal computation
+        VL53L0X_GETARRAYPARAMETERFIELD(Dev, LimitChecksValue, LimitCheckId, TempFix1616);
+        break;
+    }
+
+    *pLimitCheckValue = TempFix1616;
+}
+
+static uint32_t timing_budget(VL53L0X_DEV Dev, const VL53L0X_ParamsImage_t *image, uint8_t SequenceConfig)
+{
+    uint32_t budget = START_OVERHEAD_US + END_OVERHEAD_US;
+    uint8_t PreVcselPClk = VL53L0X_decode_vcsel_period(image->pre_range[0]);
+    uint8_t FinalVcselPClk = VL53L0X_decode_vcsel_period(image->final_range[0]);
+    uint16_t PreRangeTimeOutMClks = 0;
+    uint16_t FinalRangeTimeOutMClks;
+    uint32_t TimeoutMicroSeconds;
+
+    // same as VL53L0X_get_measurement_timing_budget_micro_seconds
+    if (SequenceConfig & 0x1C)
+    {
+        TimeoutMicroSeconds = VL53L0X_calc_timeout_us(Dev,
+            VL53L0X_decode_timeout(image->final_limit[2]), PreVcselPClk);
+
+        if (SequenceConfig & 0x10) // TCC
+            budget += TimeoutMicroSeconds + TCC_OVERHEAD_US;
+
+        if (SequenceConfig & 0x08) // DSS
+            budget += 2 * (TimeoutMicroSeconds + DSS_OVERHEAD_US);
+        else if (SequenceConfig & 0x04) // MSRC
+            budget += TimeoutMicroSeconds + MSRC_OVERHEAD_US;
+    }
+
+    if (SequenceConfig & 0x40) // PRE_RANGE
+    {
+        PreRangeTimeOutMClks = VL53L0X_decode_timeout(BE16(&image->pre_range[1]));
+        budget += VL53L0X_calc_timeout_us(Dev, PreRangeTimeOutMClks, PreVcselPClk)
+                  + PRE_RANGE_OVERHEAD_US;
+    }
+
+    if (SequenceConfig & 0x80) // FINAL_RANGE
+    {
+        FinalRangeTimeOutMClks = VL53L0X_decode_timeout(BE16(&image->final_range[1]));
+        FinalRangeTimeOutMClks -= PreRangeTimeOutMClks;
+        budget += VL53L0X_calc_timeout_us(Dev, FinalRangeTimeOutMClks, FinalVcselPClk)
+                  + FINAL_RANGE_OVERHEAD_US;
+    }
+
+    return budget;
+}
+
+VL53L0X_Error VL53L0X_Params_decode(VL53L0X_DEV Dev, const VL53L0X_ParamsImage_t *image,
+                                    VL53L0X_DeviceParameters_t *pDeviceParameters)
+{
+    uint8_t SequenceConfig = image->system[0];
+    uint16_t osc_calibrate_val = BE16(image->osc_calibrate);
+    uint16_t Value;
+    uint16_t RangeOffsetRegister;
+    FixPoint1616_t TempFix1616;
+    int i;
+
+    VL53L0X_GETPARAMETERFIELD(Dev, DeviceMode, pDeviceParameters->DeviceMode);
+
+    // inter measurement period
+    if (osc_calibrate_val != 0)
+        pDeviceParameters->InterMeasurementPeriodMilliSeconds = BE32(&image->system[3]) / osc_calibrate_val;
+    VL53L0X_SETPARAMETERFIELD(Dev, InterMeasurementPeriodMilliSeconds,
+                              pDeviceParameters->InterMeasurementPeriodMilliSeconds);
+
+    // crosstalk, the returned enable stays 0 as in VL53L0X_GetDeviceParameters
+    pDeviceParameters->XTalkCompensationEnable = 0;
+
+    Value = BE16(image->xtalk);
+    if (Value == 0)
+    {
+        VL53L0X_GETPARAMETERFIELD(Dev, XTalkCompensationRateMegaCps, TempFix1616);
+        VL53L0X_SETPARAMETERFIELD(Dev, XTalkCompensationEnable, 0);
+    }
+    else
+    {
+        TempFix1616 = VL53L0X_FIXPOINT313TOFIXPOINT1616(Value);
+        VL53L0X_SETPARAMETERFIELD(Dev, XTalkCompensationRateMegaCps, TempFix1616);
+        VL53L0X_SETPARAMETERFIELD(Dev, XTalkCompensationEnable, 1);
+    }
+    pDeviceParameters->XTalkCompensationRateMegaCps = TempFix1616;
+
+    // offset, 12 bit 2's complement in 10.2 format
+    RangeOffsetRegister = BE16(image->offset) & 0x0fff;
+    if (RangeOffsetRegister > 2047)
+        pDeviceParameters->RangeOffsetMicroMeters = (int16_t)(RangeOffsetRegister - 4096) * 250;
+    else
+        pDeviceParameters->RangeOffsetMicroMeters = (int16_t)RangeOffsetRegister * 250;
+
+    // values first, the value of a check may change its enable
+    for (i = 0; i < VL53L0X_CHECKENABLE_NUMBER_OF_CHECKS; i++)
+    {
+        limit_check_value(Dev, image, i, &pDeviceParameters->LimitChecksValue[i]);
+        VL53L0X_GETARRAYPARAMETERFIELD(Dev, LimitChecksEnable, i,
+                                       pDeviceParameters->LimitChecksEnable[i]);
+    }
+
+    // wrap around check
+    PALDevDataSet(Dev, SequenceConfig, SequenceConfig);
+    pDeviceParameters->WrapAroundCheckEnable = (SequenceConfig & 0x80) ? 1 : 0;
+    VL53L0X_SETPARAMETERFIELD(Dev, WrapAroundCheckEnable,
+                              pDeviceParameters->WrapAroundCheckEnable);
+
+    pDeviceParameters->MeasurementTimingBudgetMicroSeconds = timing_budget(Dev, image, SequenceConfig);
+    VL53L0X_SETPARAMETERFIELD(Dev, MeasurementTimingBudgetMicroSeconds,
+                              pDeviceParameters->MeasurementTimingBudgetMicroSeconds);
+
+#ifndef VL53L0X_LEAN_DEVICE
+    for (i = 0; i < VL53L0X_DMAX_LUT_SIZE; i++)
+    {
+        pDeviceParameters->dmax_lut.ambRate_mcps[i] = Dev->Data.CurrentParameters.dmax_lut.ambRate_mcps[i];
+        pDeviceParameters->dmax_lut.dmax_mm[i] = Dev->Data.CurrentParameters.dmax_lut.dmax_mm[i];
+    }
+#endif
+
+    return VL53L0X_ERROR_NONE;
+}
+
+VL53L0X_Error VL53L0X_Params_get(VL53L0X_DEV Dev, VL53L0X_DeviceParameters_t *pDeviceParameters)
+{
+    VL53L0X_Error Status;
+    VL53L0X_ParamsImage_t image;
+
+    Status = VL53L0X_Params_read(Dev, &image);
+    if (Status == VL53L0X_ERROR_NONE)
+        Status = VL53L0X_Params_decode(Dev, &image, pDeviceParameters);
+
+    return Status;
+}
@@ -0,0 +1,428 @@
+/*
+ * File : vl53l0x_pipeline.c
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#include "vl53l0x_pipeline.h"
+#include "vl53l0x_measurement.h"
+#include "vl53l0x_platform_esp32.h"
+
+#include "esp_log.h"
+
+// defined in vl53l0x_api_calibration.c, not exported by its header
+VL53L0X_Error set_ref_spad_map(VL53L0X_DEV Dev, uint8_t *refSpadArray);
+
+#ifdef VL53L0X_LOG_ENABLE
+static const char* TAG = "vl53l0x_pipeline";
+
+#define Pipeline_ErrLog(fmt, ...) \
+    VL53L0X_DRIVER_LOG(ESP_LOG_ERROR, TAG, "%s " fmt, __func__, ##__VA_ARGS__)
+#else
+#define Pipeline_ErrLog(fmt, ...) (void)0
+#endif
+
+// result poll interval while a reference measurement integrates
+#define PIPELINE_POLL_US    1000
+
+// VL53L0X_measurement_poll_for_completion: VL53L0X_DEFAULT_MAX_LOOP polling delays
+#define PIPELINE_TIMEOUT_US (VL53L0X_DEFAULT_MAX_LOOP * 10000)
+
+#define MIN_SPAD_COUNT      3
+
+// reference measurement each stage waits for
+enum {
+    STAGE_INIT = 0,         // DataInit, StaticInit
+    STAGE_VHV,              // VL53L0X_PerformRefCalibration
+    STAGE_PHASE,
+    STAGE_SPAD_VHV,         // VL53L0X_PerformRefSpadManagement
+    STAGE_SPAD_PHASE,
+    STAGE_SPAD_MINIMUM,
+    STAGE_SPAD_APERTURE,
+    STAGE_SPAD_SEARCH,
+};
+
+static uint32_t elapsed_us(int32_t start)
+{
+    int32_t now;
+    VL53L0X_get_timer_value(&now);
+    return (uint32_t)(now - start);
+}
+
+// VL53L0X_perform_single_ref_calibration up to the wait
+static VL53L0X_Error start_ref_calibration(VL53L0X_PipelineUnit_t *unit, uint8_t sequence,
+                                           uint8_t vhv_init_byte)
+{
+    uint8_t seq[] = {
+        VL53L0X_REG_SYSTEM_SEQUENCE_CONFIG, sequence,
+        VL53L0X_REG_SYSRANGE_START, VL53L0X_REG_SYSRANGE_MODE_START_STOP | vhv_init_byte,
+    };
+    VL53L0X_Error Status;
+
+    Status = VL53L0X_WriteSequence(unit->device, seq, sizeof(seq) / 2);
+    if (Status == VL53L0X_ERROR_NONE)
+    {
+        unit->measuring = 1;
+        VL53L0X_get_timer_value(&unit->measure_us);
+    }
+
+    return Status;
+}
+
+// and after it
+static VL53L0X_Error finish_ref_calibration(VL53L0X_PipelineUnit_t *unit)
+{
+    VL53L0X_Error Status;
+
+    Status = VL53L0X_ClearInterruptMask(unit->device, 0);
+    if (Status == VL53L0X_ERROR_NONE)
+        Status = VL53L0X_WrByte(unit->device, VL53L0X_REG_SYSRANGE_START, 0x00);
+
+    return Status;
+}
+
+static VL53L0X_Error restore_sequence(VL53L0X_PipelineUnit_t *unit)
+{
+    VL53L0X_Error Status;
+
+    Status = VL53L0X_WrByte(unit->device, VL53L0X_REG_SYSTEM_SEQUENCE_CONFIG, unit->SequenceConfig);
+    if (Status == VL53L0X_ERROR_NONE)
+        PALDevDataSet(unit->device, SequenceConfig, unit->SequenceConfig);
+
+    return Status;
+}
+
+// perform_ref_signal_measurement up to the wait
+static VL53L0X_Error start_signal(VL53L0X_PipelineUnit_t *unit)
+{
+    VL53L0X_Error Status;
+
+    unit->SequenceConfig = PALDevDataGet(unit->device, SequenceConfig);
+
+    Status = VL53L0X_WrByte(unit->device, VL53L0X_REG_SYSTEM_SEQUENCE_CONFIG, 0xC0);
+    if (Status == VL53L0X_ERROR_NONE)
+        Status = VL53L0X_SetDeviceMode(unit->device, VL53L0X_DEVICEMODE_SINGLE_RANGING);
+    if (Status == VL53L0X_ERROR_NONE)
+        Status = VL53L0X_Measurement_start(unit->device);
+    if (Status == VL53L0X_ERROR_NONE)
+    {
+        unit->measuring = 1;
+        VL53L0X_get_timer_value(&unit->measure_us);
+    }
+
+    return Status;
+}
+
+// and after it
+static VL53L0X_Error finish_signal(VL53L0X_PipelineUnit_t *unit)
+{
+    VL53L0X_Dev_t *Dev = unit->device;
+    VL53L0X_RangingMeasurementData_t data;
+    VL53L0X_Error Status;
+
+    PALDevDataSet(Dev, PalState, VL53L0X_STATE_IDLE);
+
+    Status = VL53L0X_GetRangingMeasurementData(Dev, &data);
+    if (Status == VL53L0X_ERROR_NONE)
+        Status = VL53L0X_ClearInterruptMask(Dev, 0);
+    if (Status == VL53L0X_ERROR_NONE)
+        Status = VL53L0X_WrByte(Dev, 0xFF, 0x01);
+    if (Status == VL53L0X_ERROR_NONE)
+        Status = VL53L0X_RdWord(Dev, VL53L0X_REG_RESULT_PEAK_SIGNAL_RATE_REF, &unit->peakSignalRateRef);
+    if (Status == VL53L0X_ERROR_NONE)
+        Status = VL53L0X_WrByte(Dev, 0xFF, 0x00);
+    if (Status == VL53L0X_ERROR_NONE)
+        Status = restore_sequence(unit);
+
+    return Status;
+}
+
+static VL53L0X_Error setup_done(VL53L0X_PipelineUnit_t *unit, uint32_t refSpadCount,
+                                uint8_t isApertureSpads)
+{
+    VL53L0X_Error Status;
+
+    unit->RefSpadCount = refSpadCount;
+    unit->IsApertureSpads = isApertureSpads;
+    VL53L0X_RefSpad_record(unit->device, refSpadCount, isApertureSpads);
+
+    // settings of the last reference calibration, the one the device keeps
+    Status = VL53L0X_GetRefCalibration(unit->device, &unit->VhvSettings, &unit->PhaseCal);
+    if (Status == VL53L0X_ERROR_NONE)
+        unit->Step = VL53L0X_SETUP_DONE;
+
+    return Status;
+}
+
+// measure the next map of the search, or enable the SPADs found
+static VL53L0X_Error search_next(VL53L0X_PipelineUnit_t *unit)
+{
+    VL53L0X_Dev_t *Dev = unit->device;
+    VL53L0X_Error Status;
+    uint32_t added;
+
+    if (VL53L0X_RefSpad_bracketNext(&unit->bracket))
+    {
+        unit->stage = STAGE_SPAD_SEARCH;
+        Status = set_ref_spad_map(Dev, unit->bracket.map);
+        if (Status == VL53L0X_ERROR_NONE)
+            Status = start_signal(unit);
+        return Status;
+    }
+
+    Status = VL53L0X_RefSpad_bracketFinish(&unit->bracket, Dev, PALDevDataGet(Dev, targetRefRate),
+                                           &added);
+    if (Status == VL53L0X_ERROR_NONE)
+        Status = setup_done(unit, MIN_SPAD_COUNT + added, unit->needAptSpads);
+
+    return Status;
+}
+
+// same decisions as VL53L0X_RefSpad_bisect once the minimum SPADs are measured
+static VL53L0X_Error spads_measured(VL53L0X_PipelineUnit_t *unit)
+{
+    VL53L0X_Dev_t *Dev = unit->device;
+    uint16_t targetRefRate = PALDevDataGet(Dev, targetRefRate);
+
+    if (unit->peakSignalRateRef < targetRefRate)
+    {
+        VL53L0X_RefSpad_bracketBegin(&unit->bracket, Dev, unit->currentSpadIndex,
+                                     unit->needAptSpads, unit->peakSignalRateRef,
+                                     Dev->RefSpadSearch == VL53L0X_REFSPAD_SEARCH_BISECT);
+        return search_next(unit);
+    }
+
+    if (unit->peakSignalRateRef > targetRefRate)
+        return setup_done(unit, MIN_SPAD_COUNT, 1);
+
+    return setup_done(unit, 0, 0);
+}
+
+// bus work following the completed measurement of the stage
+static VL53L0X_Error advance(VL53L0X_PipelineUnit_t *unit)
+{
+    VL53L0X_Dev_t *Dev = unit->device;
+    VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+
+    switch (unit->stage)
+    {
+    case STAGE_INIT:
+        Status = VL53L0X_Device_setupThrough(Dev, &unit->Step, VL53L0X_SETUP_STATIC_INIT);
+        if (Status != VL53L0X_ERROR_NONE)
+            break;
+
+        // VL53L0X_perform_ref_calibration, the settings are read at the end
+        unit->SequenceConfig = PALDevDataGet(Dev, SequenceConfig);
+        unit->stage = STAGE_VHV;
+        Status = start_ref_calibration(unit, 0x01, 0x40);
+        break;
+
+    case STAGE_VHV:
+    case STAGE_SPAD_VHV:
+        Status = finish_ref_calibration(unit);
+        if (Status != VL53L0X_ERROR_NONE)
+            break;
+
+        unit->stage++;
+        Status = start_ref_calibration(unit, 0x02, 0x00);
+        break;
+
+    case STAGE_PHASE:
+        Status = finish_ref_calibration(unit);
+        if (Status == VL53L0X_ERROR_NONE)
+            Status = restore_sequence(unit);
+        if (Status != VL53L0X_ERROR_NONE)
+            break;
+
+        unit->Step = VL53L0X_SETUP_REF_CALIBRATION;
+
+        // VL53L0X_RefSpad_perform
+        Status = VL53L0X_RefSpad_prepare(Dev);
+        if (Status != VL53L0X_ERROR_NONE)
+            break;
+
+        unit->SequenceConfig = PALDevDataGet(Dev, SequenceConfig);
+        unit->stage = STAGE_SPAD_VHV;
+        Status = start_ref_calibration(unit, 0x01, 0x40);
+        break;
+
+    case STAGE_SPAD_PHASE:
+        Status = finish_ref_calibration(unit);
+        if (Status == VL53L0X_ERROR_NONE)
+            Status = restore_sequence(unit);
+
+        unit->currentSpadIndex = 0;
+        unit->needAptSpads = 0;
+        if (Status == VL53L0X_ERROR_NONE)
+            Status = VL53L0X_RefSpad_enableMinimum(Dev, unit->needAptSpads, &unit->currentSpadIndex);
+        if (Status != VL53L0X_ERROR_NONE)
+            break;
+
+        unit->stage = STAGE_SPAD_MINIMUM;
+        Status = start_signal(unit);
+        break;
+
+    case STAGE_SPAD_MINIMUM:
+        Status = finish_signal(unit);
+        if (Status != VL53L0X_ERROR_NONE)
+            break;
+
+        if (unit->peakSignalRateRef <= PALDevDataGet(Dev, targetRefRate))
+        {
+            Status = spads_measured(unit);
+            break;
+        }
+
+        unit->needAptSpads = 1;
+        Status = VL53L0X_RefSpad_enableMinimum(Dev, unit->needAptSpads, &unit->currentSpadIndex);
+        if (Status != VL53L0X_ERROR_NONE)
+            break;
+
+        unit->stage = STAGE_SPAD_APERTURE;
+        Status = start_signal(unit);
+        break;
+
+    case STAGE_SPAD_APERTURE:
+        Status = finish_signal(unit);
+        if (Status == VL53L0X_ERROR_NONE)
+            Status = spads_measured(unit);
+        break;
+
+    case STAGE_SPAD_SEARCH:
+        Status = finish_signal(unit);
+        if (Status != VL53L0X_ERROR_NONE)
+            break;
+
+        VL53L0X_RefSpad_bracketAccount(&unit->bracket, unit->peakSignalRateRef,
+                                       PALDevDataGet(Dev, targetRefRate));
+        Status = search_next(unit);
+        break;
+
+    default:
+        break;
+    }
+
+    return Status;
+}
+
+void VL53L0X_Pipeline_begin(VL53L0X_PipelineUnit_t *unit, VL53L0X_Dev_t *device)
+{
+    unit->device = device;
+    unit->Status = VL53L0X_ERROR_NONE;
+    unit->Step = VL53L0X_SETUP_START;
+    unit->RefSpadCount = 0;
+    unit->IsApertureSpads = 0;
+    unit->VhvSettings = 0;
+    unit->PhaseCal = 0;
+    unit->ElapsedMicroSeconds = 0;
+    unit->stage = STAGE_INIT;
+    unit->measuring = 0;
+    VL53L0X_get_timer_value(&unit->start_us);
+}
+
+static uint8_t step(VL53L0X_PipelineUnit_t *unit, uint32_t *pWait_us)
+{
+    VL53L0X_Error Status;
+    uint8_t ready = 0;
+
+    if (unit->measuring)
+    {
+        Status = VL53L0X_GetMeasurementDataReady(unit->device, &ready);
+
+        if (Status == VL53L0X_ERROR_NONE && !ready)
+        {
+            if (elapsed_us(unit->measure_us) < PIPELINE_TIMEOUT_US)
+            {
+                if (PIPELINE_POLL_US < *pWait_us)
+                    *pWait_us = PIPELINE_POLL_US;
+                return 0;
+            }
+            Status = VL53L0X_ERROR_TIME_OUT;
+        }
+
+        if (Status != VL53L0X_ERROR_NONE)
+        {
+            unit->Status = Status;
+            unit->ElapsedMicroSeconds = elapsed_us(unit->start_us);
+            return 0;
+        }
+
+        unit->measuring = 0;
+    }
+
+    unit->Status = advance(unit);
+
+    if (unit->Status != VL53L0X_ERROR_NONE || unit->Step == VL53L0X_SETUP_DONE)
+        unit->ElapsedMicroSeconds = elapsed_us(unit->start_us);
+
+    return unit->Status == VL53L0X_ERROR_NONE;
+}
+
+uint8_t VL53L0X_Pipeline_step(VL53L0X_PipelineUnit_t *unit, uint32_t *pWait_us)
+{
+    uint8_t progressed;
+    int8_t priority;
+
+    if (unit->Status != VL53L0X_ERROR_NONE || unit->Step == VL53L0X_SETUP_DONE)
+        return 0;
+
+    // setup traffic gives way to the ranging of other devices
+    priority = VL53L0X_SetBusPriority(unit->device, VL53L0X_BUS_PRIORITY_LOW);
+    progressed = step(unit, pWait_us);
+    VL53L0X_SetBusPriority(unit->device, priority);
+
+    return progressed;
+}
+
+VL53L0X_Error VL53L0X_Pipeline_setup(VL53L0X_PipelineUnit_t *units, uint16_t count)
+{
+    VL53L0X_PipelineUnit_t *unit;
+    VL53L0X_Dev_t *sleeper;
+    uint16_t active = count;
+    uint16_t i;
+    uint32_t wait_us;
+    uint8_t progressed;
+
+    for (i = 0; i < count; i++)
+        VL53L0X_Pipeline_begin(&units[i], units[i].device);
+
+    while (active > 0)
+    {
+        progressed = 0;
+        wait_us = UINT32_MAX;
+        sleeper = NULL;
+
+        for (i = 0; i < count; i++)
+        {
+            unit = &units[i];
+            if (unit->Status != VL53L0X_ERROR_NONE || unit->Step == VL53L0X_SETUP_DONE)
+                continue;
+
+            progressed |= VL53L0X_Pipeline_step(unit, &wait_us);
+
+            if (unit->Status != VL53L0X_ERROR_NONE)
+                Pipeline_ErrLog("unit %u setup error (%d)", i, unit->Status);
+            else if (unit->Step != VL53L0X_SETUP_DONE)
+            {
+                sleeper = unit->device;
+                continue;
+            }
+
+            active--;
+        }
+
+        // every unit integrating: sleep until the next poll
+        if (!progressed && sleeper != NULL && wait_us != UINT32_MAX)
+            VL53L0X_Sleep(sleeper, wait_us);
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        if (units[i].Status != VL53L0X_ERROR_NONE)
+            return units[i].Status;
+    }
+
+    return VL53L0X_ERROR_NONE;
+}
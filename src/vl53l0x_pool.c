@@ -0,0 +1,57 @@
+/*
+ * File : vl53l0x_pool.c
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#include "vl53l0x_pool.h"
+
+#include <string.h>
+
+#if VL53L0X_POOL_SIZE < 1 || VL53L0X_POOL_SIZE > 32
+#error "VL53L0X_POOL_SIZE must be 1 to 32"
+#endif
+
+static VL53L0X_Dev_t pool[VL53L0X_POOL_SIZE];
+
+// bit i set : pool[i] taken
+static uint32_t pool_used;
+
+VL53L0X_Dev_t *VL53L0X_Pool_acquire(void)
+{
+    uint32_t used = __atomic_load_n(&pool_used, __ATOMIC_RELAXED);
+    uint32_t i;
+
+    do
+    {
+        for (i = 0; i < VL53L0X_POOL_SIZE; i++)
+        {
+            if ((used & (1UL << i)) == 0)
+                break;
+        }
+        if (i == VL53L0X_POOL_SIZE)
+            return NULL;
+    } while (!__atomic_compare_exchange_n(&pool_used, &used, used | (1UL << i),
+                                          1, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED));
+
+    memset(&pool[i], 0, sizeof(pool[i]));
+    return &pool[i];
+}
+
+void VL53L0X_Pool_release(VL53L0X_Dev_t *device)
+{
+    uint32_t i;
+
+    if (device < &pool[0] || device >= &pool[VL53L0X_POOL_SIZE])
+        return;
+
+    i = (uint32_t)(device - pool);
+    __atomic_fetch_and(&pool_used, ~(1UL << i), __ATOMIC_RELEASE);
+}
+
+uint8_t VL53L0X_Pool_used(void)
+{
+    return (uint8_t)__builtin_popcount(__atomic_load_n(&pool_used, __ATOMIC_RELAXED));
+}
@@ -0,0 +1,41 @@
+/*
+ * File : vl53l0x_preset.c
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#include "vl53l0x_preset.h"
+#include "vl53l0x_api_calibration.h"
+#include "vl53l0x_platform_esp32.h"
+
+VL53L0X_Error VL53L0X_Preset_load(VL53L0X_DEV Dev, const VL53L0X_Preset_t *preset)
+{
+    VL53L0X_Error Status;
+    uint8_t PhaseCal = 0;
+
+    Status = VL53L0X_WriteSequence(Dev, preset->pairs, VL53L0X_PRESET_PAIRS);
+    if (Status != VL53L0X_ERROR_NONE)
+        return Status;
+
+    // device data as VL53L0X_Profile_compute leaves it
+    PALDevDataSet(Dev, SequenceConfig, preset->SequenceConfig);
+    VL53L0X_SETPARAMETERFIELD(Dev, MeasurementTimingBudgetMicroSeconds,
+                              preset->MeasurementTimingBudgetMicroSeconds);
+    VL53L0X_SETARRAYPARAMETERFIELD(Dev, LimitChecksEnable, VL53L0X_CHECKENABLE_SIGMA_FINAL_RANGE, 1);
+    VL53L0X_SETARRAYPARAMETERFIELD(Dev, LimitChecksValue, VL53L0X_CHECKENABLE_SIGMA_FINAL_RANGE,
+                                   preset->SigmaLimit);
+    VL53L0X_SETARRAYPARAMETERFIELD(Dev, LimitChecksEnable, VL53L0X_CHECKENABLE_SIGNAL_RATE_FINAL_RANGE, 1);
+    VL53L0X_SETARRAYPARAMETERFIELD(Dev, LimitChecksValue, VL53L0X_CHECKENABLE_SIGNAL_RATE_FINAL_RANGE,
+                                   preset->SignalRateLimit);
+
+    VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, LastEncodedTimeout, preset->LastEncodedTimeout);
+    VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, FinalRangeTimeoutMicroSecs, preset->FinalRangeTimeoutMicroSecs);
+    VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, FinalRangeVcselPulsePeriod, preset->FinalRangeVcselPulsePeriod);
+    VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, PreRangeTimeoutMicroSecs, preset->PreRangeTimeoutMicroSecs);
+    VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, PreRangeVcselPulsePeriod, preset->PreRangeVcselPulsePeriod);
+
+    // as VL53L0X_set_vcsel_pulse_period : get_data_enable = 0, restore_config = 1
+    return VL53L0X_perform_phase_calibration(Dev, &PhaseCal, 0, 1);
+}
@@ -0,0 +1,197 @@
+/*
+ * File : vl53l0x_profile.c
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#include "vl53l0x_profile.h"
+#include "vl53l0x_platform_esp32.h"
+
+#define PHASECAL_REG    0xEE
+
+static const struct {
+    uint8_t index;
+    uint8_t count;
+} image_blocks[] = {
+    { VL53L0X_REG_SYSTEM_SEQUENCE_CONFIG, 1 },
+    { VL53L0X_REG_ALGO_PHASECAL_CONFIG_TIMEOUT, 3 },                // .. vcsel width
+    { VL53L0X_REG_FINAL_RANGE_CONFIG_MIN_COUNT_RATE_RTN_LIMIT, 5 }, // .. final valid phase
+    { VL53L0X_REG_PRE_RANGE_CONFIG_VCSEL_PERIOD, 8 },               // .. pre valid phase
+    { VL53L0X_REG_MSRC_CONFIG_CONTROL, 8 },                         // .. final min snr
+    { VL53L0X_REG_FINAL_RANGE_CONFIG_VCSEL_PERIOD, 3 },
+};
+
+#define IMAGE_BLOCKS    (sizeof(image_blocks) / sizeof(image_blocks[0]))
+
+// private registers access, as VL53L0X_ref_calibration_io
+static const uint8_t private_open[] = {
+    0xFF, 0x01,
+    0x00, 0x00,
+    0xFF, 0x00,
+};
+
+static const uint8_t private_close[] = {
+    0xFF, 0x01,
+    0x00, 0x01,
+    0xFF, 0x00,
+};
+
+VL53L0X_Error VL53L0X_Profile_capture(VL53L0X_DEV Dev, VL53L0X_Profile_t *profile)
+{
+    VL53L0X_Error Status;
+    VL53L0X_ReadBlock_t blocks[IMAGE_BLOCKS];
+    uint32_t offset = 0;
+    uint32_t i;
+    int j;
+
+    for (i = 0; i < IMAGE_BLOCKS; i++)
+    {
+        blocks[i].index = image_blocks[i].index;
+        blocks[i].count = image_blocks[i].count;
+        blocks[i].pdata = &profile->regs[offset];
+        offset += image_blocks[i].count;
+    }
+
+    Status = VL53L0X_ReadBlocks(Dev, blocks, IMAGE_BLOCKS);
+
+    if (Status == VL53L0X_ERROR_NONE)
+        Status = VL53L0X_WrByte(Dev, 0xFF, 0x01);
+    if (Status == VL53L0X_ERROR_NONE)
+        Status = VL53L0X_RdByte(Dev, VL53L0X_REG_ALGO_PHASECAL_LIM, &profile->PhaseCalLimit);
+    if (Status == VL53L0X_ERROR_NONE)
+        Status = VL53L0X_WrByte(Dev, 0xFF, 0x00);
+
+    if (Status == VL53L0X_ERROR_NONE)
+        Status = VL53L0X_WriteSequence(Dev, private_open, sizeof(private_open) / 2);
+    if (Status == VL53L0X_ERROR_NONE)
+        Status = VL53L0X_RdByte(Dev, PHASECAL_REG, &profile->PhaseCal);
+    if (Status == VL53L0X_ERROR_NONE)
+        Status = VL53L0X_WriteSequence(Dev, private_close, sizeof(private_close) / 2);
+
+    if (Status != VL53L0X_ERROR_NONE)
+        return Status;
+
+    profile->SequenceConfig = PALDevDataGet(Dev, SequenceConfig);
+    VL53L0X_GETPARAMETERFIELD(Dev, MeasurementTimingBudgetMicroSeconds,
+                              profile->MeasurementTimingBudgetMicroSeconds);
+    VL53L0X_GETPARAMETERFIELD(Dev, WrapAroundCheckEnable, profile->WrapAroundCheckEnable);
+    for (j = 0; j < VL53L0X_CHECKENABLE_NUMBER_OF_CHECKS; j++)
+    {
+        VL53L0X_GETARRAYPARAMETERFIELD(Dev, LimitChecksEnable, j, profile->LimitChecksEnable[j]);
+        VL53L0X_GETARRAYPARAMETERFIELD(Dev, LimitChecksValue, j, profile->LimitChecksValue[j]);
+    }
+
+    profile->LastEncodedTimeout = VL53L0X_GETDEVICESPECIFICPARAMETER(Dev, LastEncodedTimeout);
+    profile->FinalRangeTimeoutMicroSecs = VL53L0X_GETDEVICESPECIFICPARAMETER(Dev, FinalRangeTimeoutMicroSecs);
+    profile->FinalRangeVcselPulsePeriod = VL53L0X_GETDEVICESPECIFICPARAMETER(Dev, FinalRangeVcselPulsePeriod);
+    profile->PreRangeTimeoutMicroSecs = VL53L0X_GETDEVICESPECIFICPARAMETER(Dev, PreRangeTimeoutMicroSecs);
+    profile->PreRangeVcselPulsePeriod = VL53L0X_GETDEVICESPECIFICPARAMETER(Dev, PreRangeVcselPulsePeriod);
+
+    return Status;
+}
+
+VL53L0X_Error VL53L0X_Profile_compute(VL53L0X_DEV Dev, const VL53L0X_ProfileConfig_t *config,
+                                      VL53L0X_Profile_t *profile)
+{
+    VL53L0X_Error Status;
+
+    // periods first : the timing budget then splits with the periods of the profile
+    Status = VL53L0X_SetVcselPulsePeriod(Dev, VL53L0X_VCSEL_PERIOD_PRE_RANGE,
+                                         config->PreRangeVcselPeriod);
+    if (Status == VL53L0X_ERROR_NONE)
+        Status = VL53L0X_SetVcselPulsePeriod(Dev, VL53L0X_VCSEL_PERIOD_FINAL_RANGE,
+                                             config->FinalRangeVcselPeriod);
+    if (Status == VL53L0X_ERROR_NONE)
+        Status = VL53L0X_SetMeasurementTimingBudgetMicroSeconds(Dev, config->TimingBudgetMicroSeconds);
+    if (Status == VL53L0X_ERROR_NONE)
+        Status = VL53L0X_SetLimitCheckEnable(Dev, VL53L0X_CHECKENABLE_SIGMA_FINAL_RANGE, 1);
+    if (Status == VL53L0X_ERROR_NONE)
+        Status = VL53L0X_SetLimitCheckEnable(Dev, VL53L0X_CHECKENABLE_SIGNAL_RATE_FINAL_RANGE, 1);
+    if (Status == VL53L0X_ERROR_NONE)
+        Status = VL53L0X_SetLimitCheckValue(Dev, VL53L0X_CHECKENABLE_SIGNAL_RATE_FINAL_RANGE,
+                                            config->SignalRateLimit);
+    if (Status == VL53L0X_ERROR_NONE)
+        Status = VL53L0X_SetLimitCheckValue(Dev, VL53L0X_CHECKENABLE_SIGMA_FINAL_RANGE,
+                                            config->SigmaLimit);
+
+    if (Status == VL53L0X_ERROR_NONE)
+        Status = VL53L0X_Profile_capture(Dev, profile);
+
+    return Status;
+}
+
+VL53L0X_Error VL53L0X_Profile_apply(VL53L0X_DEV Dev, const VL53L0X_Profile_t *profile,
+                                    const VL53L0X_Profile_t *current)
+{
+    VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+    uint8_t seq[2 * (VL53L0X_PROFILE_IMAGE_SIZE + 3 + 7)];
+    uint32_t count = 0;
+    uint32_t offset = 0;
+    uint32_t i;
+    uint8_t k;
+    int j;
+
+    // page 0 registers
+    for (i = 0; i < IMAGE_BLOCKS; i++)
+    {
+        for (k = 0; k < image_blocks[i].count; k++, offset++)
+        {
+            if (current != NULL && current->regs[offset] == profile->regs[offset])
+                continue;
+
+            seq[2 * count] = image_blocks[i].index + k;
+            seq[2 * count + 1] = profile->regs[offset];
+            count++;
+        }
+    }
+
+    if (current == NULL || current->PhaseCalLimit != profile->PhaseCalLimit)
+    {
+        seq[2 * count] = 0xFF; seq[2 * count + 1] = 0x01; count++;
+        seq[2 * count] = VL53L0X_REG_ALGO_PHASECAL_LIM; seq[2 * count + 1] = profile->PhaseCalLimit; count++;
+        seq[2 * count] = 0xFF; seq[2 * count + 1] = 0x00; count++;
+    }
+
+    // phase calibration result, in place of running the calibration again
+    if (current == NULL || current->PhaseCal != profile->PhaseCal)
+    {
+        for (i = 0; i < sizeof(private_open) / 2; i++, count++)
+        {
+            seq[2 * count] = private_open[2 * i];
+            seq[2 * count + 1] = private_open[2 * i + 1];
+        }
+        seq[2 * count] = PHASECAL_REG; seq[2 * count + 1] = profile->PhaseCal; count++;
+        for (i = 0; i < sizeof(private_close) / 2; i++, count++)
+        {
+            seq[2 * count] = private_close[2 * i];
+            seq[2 * count + 1] = private_close[2 * i + 1];
+        }
+    }
+
+    if (count > 0)
+        Status = VL53L0X_WriteSequence(Dev, seq, count);
+
+    if (Status != VL53L0X_ERROR_NONE)
+        return Status;
+
+    // device data as the API calls leave it, calibration and mode untouched
+    PALDevDataSet(Dev, SequenceConfig, profile->SequenceConfig);
+    VL53L0X_SETPARAMETERFIELD(Dev, MeasurementTimingBudgetMicroSeconds,
+                              profile->MeasurementTimingBudgetMicroSeconds);
+    VL53L0X_SETPARAMETERFIELD(Dev, WrapAroundCheckEnable, profile->WrapAroundCheckEnable);
+    for (j = 0; j < VL53L0X_CHECKENABLE_NUMBER_OF_CHECKS; j++)
+    {
+        VL53L0X_SETARRAYPARAMETERFIELD(Dev, LimitChecksEnable, j, profile->LimitChecksEnable[j]);
+        VL53L0X_SETARRAYPARAMETERFIELD(Dev, LimitChecksValue, j, profile->LimitChecksValue[j]);
+    }
+
+    VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, LastEncodedTimeout, profile->LastEncodedTimeout);
+    VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, FinalRangeTimeoutMicroSecs, profile->FinalRangeTimeoutMicroSecs);
+    VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, FinalRangeVcselPulsePeriod, profile->FinalRangeVcselPulsePeriod);
+    VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, PreRangeTimeoutMicroSecs, profile->PreRangeTimeoutMicroSecs);
+    VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, PreRangeVcselPulsePeriod, profile->PreRangeVcselPulsePeriod);
+
+    return Status;
+}
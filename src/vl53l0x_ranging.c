@@ -0,0 +1,354 @@
+/*
+ * File : vl53l0x_ranging.c
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#include "vl53l0x_ranging.h"
+#include "vl53l0x_api_core.h"
+#include "vl53l0x_platform_esp32.h"
+#include "vl53l0x_latest.h"
+
+// result poll interval once the predicted completion time has elapsed
+#define SINGLESHOT_POLL_US          500
+// added to twice the timing budget before giving up
+#define SINGLESHOT_TIMEOUT_MARGIN_US 10000
+
+uint8_t VL53L0X_Ranging_isReady(VL53L0X_DEV Dev, const uint8_t *block)
+{
+    uint8_t InterruptConfig = VL53L0X_GETDEVICESPECIFICPARAMETER(Dev, Pin0GpioFunctionality);
+
+    // same rule as VL53L0X_GetMeasurementDataReady
+    if (InterruptConfig == VL53L0X_REG_SYSTEM_INTERRUPT_GPIO_NEW_SAMPLE_READY)
+        return (block[0] & 0x07) == VL53L0X_REG_SYSTEM_INTERRUPT_GPIO_NEW_SAMPLE_READY;
+
+    return (block[1] & 0x01) ? 1 : 0;
+}
+
+VL53L0X_Error VL53L0X_Ranging_decode(VL53L0X_DEV Dev, const uint8_t *block,
+                                     VL53L0X_RangingMeasurementData_t *pRangingMeasurementData)
+{
+    VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+    const uint8_t *localBuffer = &block[1];
+    uint8_t DeviceRangeStatus;
+    uint8_t RangeFractionalEnable;
+    uint8_t PalRangeStatus;
+    uint8_t XTalkCompensationEnable;
+    FixPoint1616_t SignalRate;
+    uint16_t XTalkCompensationRateMegaCps;
+    uint16_t EffectiveSpadRtnCount;
+    uint16_t tmpuint16;
+    uint16_t LinearityCorrectiveGain;
+    VL53L0X_RangingMeasurementData_t *pLast;
+
+    pRangingMeasurementData->ZoneId = 0;
+    pRangingMeasurementData->TimeStamp = 0;
+    pRangingMeasurementData->MeasurementTimeUsec = 0;
+
+    tmpuint16 = VL53L0X_MAKEUINT16(localBuffer[11], localBuffer[10]);
+
+    SignalRate = VL53L0X_FIXPOINT97TOFIXPOINT1616(
+        VL53L0X_MAKEUINT16(localBuffer[7], localBuffer[6]));
+    pRangingMeasurementData->SignalRateRtnMegaCps = SignalRate;
+
+    pRangingMeasurementData->AmbientRateRtnMegaCps = VL53L0X_FIXPOINT97TOFIXPOINT1616(
+        VL53L0X_MAKEUINT16(localBuffer[9], localBuffer[8]));
+
+    // 8.8 format
+    EffectiveSpadRtnCount = VL53L0X_MAKEUINT16(localBuffer[3], localBuffer[2]);
+    pRangingMeasurementData->EffectiveSpadRtnCount = EffectiveSpadRtnCount;
+
+    DeviceRangeStatus = localBuffer[0];
+
+    LinearityCorrectiveGain = PALDevDataGet(Dev, LinearityCorrectiveGain);
+    RangeFractionalEnable = PALDevDataGet(Dev, RangeFractionalEnable);
+
+    if (LinearityCorrectiveGain != 1000)
+    {
+        tmpuint16 = (uint16_t)((LinearityCorrectiveGain * tmpuint16 + 500) / 1000);
+
+        VL53L0X_GETPARAMETERFIELD(Dev, XTalkCompensationRateMegaCps,
+                                  XTalkCompensationRateMegaCps);
+        VL53L0X_GETPARAMETERFIELD(Dev, XTalkCompensationEnable,
+                                  XTalkCompensationEnable);
+
+        if (XTalkCompensationEnable)
+        {
+            FixPoint1616_t XTalk = (XTalkCompensationRateMegaCps * EffectiveSpadRtnCount) >> 8;
+
+            if ((SignalRate - XTalk) <= 0)
+                tmpuint16 = RangeFractionalEnable ? 8888 : (8888 << 2);
+            else
+                tmpuint16 = (tmpuint16 * SignalRate) / (SignalRate - XTalk);
+        }
+    }
+
+    if (RangeFractionalEnable)
+    {
+        pRangingMeasurementData->RangeMilliMeter = (uint16_t)(tmpuint16 >> 2);
+        pRangingMeasurementData->RangeFractionalPart = (uint8_t)((tmpuint16 & 0x03) << 6);
+    }
+    else
+    {
+        pRangingMeasurementData->RangeMilliMeter = tmpuint16;
+        pRangingMeasurementData->RangeFractionalPart = 0;
+    }
+
+    Status = VL53L0X_get_pal_range_status(Dev, DeviceRangeStatus, SignalRate,
+                                          EffectiveSpadRtnCount,
+                                          pRangingMeasurementData, &PalRangeStatus);
+
+    if (Status == VL53L0X_ERROR_NONE)
+    {
+        pRangingMeasurementData->RangeStatus = PalRangeStatus;
+
+        pLast = &PALDevDataGet(Dev, LastRangeMeasure);
+        pLast->RangeMilliMeter = pRangingMeasurementData->RangeMilliMeter;
+        pLast->RangeFractionalPart = pRangingMeasurementData->RangeFractionalPart;
+        pLast->RangeDMaxMilliMeter = pRangingMeasurementData->RangeDMaxMilliMeter;
+        pLast->MeasurementTimeUsec = pRangingMeasurementData->MeasurementTimeUsec;
+        pLast->SignalRateRtnMegaCps = pRangingMeasurementData->SignalRateRtnMegaCps;
+        pLast->AmbientRateRtnMegaCps = pRangingMeasurementData->AmbientRateRtnMegaCps;
+        pLast->EffectiveSpadRtnCount = pRangingMeasurementData->EffectiveSpadRtnCount;
+        pLast->RangeStatus = pRangingMeasurementData->RangeStatus;
+    }
+
+    return Status;
+}
+
+VL53L0X_Error VL53L0X_SingleShot_prepare(VL53L0X_SingleShot_t *ss, VL53L0X_Dev_t *device)
+{
+    VL53L0X_Error Status;
+    uint32_t budget_us = 0;
+    uint8_t stop_variable;
+    uint8_t *seq = ss->start_sequence;
+    int i = 0;
+
+    ss->device = device;
+
+    Status = VL53L0X_SetDeviceMode(device, VL53L0X_DEVICEMODE_SINGLE_RANGING);
+    if (Status == VL53L0X_ERROR_NONE)
+        Status = VL53L0X_GetMeasurementTimingBudgetMicroSeconds(device, &budget_us);
+    if (Status == VL53L0X_ERROR_NONE)
+        Status = VL53L0X_ClearInterruptMask(device, 0);
+    if (Status != VL53L0X_ERROR_NONE)
+        return Status;
+
+    stop_variable = PALDevDataGet(device, StopVariable);
+
+    // clear the interrupt of the previous sample
+    seq[i++] = VL53L0X_REG_SYSTEM_INTERRUPT_CLEAR; seq[i++] = 0x01;
+    seq[i++] = VL53L0X_REG_SYSTEM_INTERRUPT_CLEAR; seq[i++] = 0x00;
+    // stop variable sequence of VL53L0X_StartMeasurement
+    seq[i++] = 0x80; seq[i++] = 0x01;
+    seq[i++] = 0xFF; seq[i++] = 0x01;
+    seq[i++] = 0x00; seq[i++] = 0x00;
+    seq[i++] = 0x91; seq[i++] = stop_variable;
+    seq[i++] = 0x00; seq[i++] = 0x01;
+    seq[i++] = 0xFF; seq[i++] = 0x00;
+    seq[i++] = 0x80; seq[i++] = 0x00;
+    seq[i++] = VL53L0X_REG_SYSRANGE_START; seq[i++] = VL53L0X_REG_SYSRANGE_MODE_START_STOP;
+
+    ss->predicted_us = budget_us;
+    ss->timeout_us = 2 * budget_us + SINGLESHOT_TIMEOUT_MARGIN_US;
+    ss->wait_ready = NULL;
+    ss->wait_ctx = NULL;
+    ss->started = 0;
+    VL53L0X_SingleShot_resetLatency(ss);
+
+    return Status;
+}
+
+void VL53L0X_SingleShot_setWaitReady(VL53L0X_SingleShot_t *ss, VL53L0X_WaitReadyFn fn, void *ctx)
+{
+    ss->wait_ready = fn;
+    ss->wait_ctx = ctx;
+}
+
+void VL53L0X_SingleShot_resetLatency(VL53L0X_SingleShot_t *ss)
+{
+    ss->latency.count = 0;
+    ss->latency.last_us = 0;
+    ss->latency.min_us = UINT32_MAX;
+    ss->latency.max_us = 0;
+    ss->latency.sum_us = 0;
+}
+
+static uint32_t elapsed_us(int32_t start)
+{
+    int32_t now;
+    VL53L0X_get_timer_value(&now);
+    return (uint32_t)(now - start);
+}
+
+// past the sensor timeout the measurement is dropped, past the deadline it stays in flight
+static VL53L0X_Error timed_out(VL53L0X_SingleShot_t *ss)
+{
+    if (elapsed_us(ss->start_us) >= ss->timeout_us)
+        ss->started = 0;
+
+    return VL53L0X_ERROR_TIME_OUT;
+}
+
+VL53L0X_Error VL53L0X_SingleShot_start(VL53L0X_SingleShot_t *ss)
+{
+    VL53L0X_Error Status;
+
+    if (ss->started)
+        return VL53L0X_ERROR_NONE;
+
+    VL53L0X_get_timer_value(&ss->start_us);
+
+    Status = VL53L0X_WriteSequence(ss->device, ss->start_sequence, VL53L0X_SINGLESHOT_START_WRITES);
+    if (Status == VL53L0X_ERROR_NONE)
+        ss->started = 1;
+
+    return Status;
+}
+
+// result block of a ready sample
+static VL53L0X_Error collect(VL53L0X_SingleShot_t *ss, const uint8_t *block,
+                             VL53L0X_RangingMeasurementData_t *pRangingMeasurementData)
+{
+    VL53L0X_Error Status;
+    uint32_t latency;
+
+    ss->started = 0;
+
+    if (block[0] & 0x18)
+        return VL53L0X_ERROR_RANGE_ERROR;
+
+    Status = VL53L0X_Ranging_decode(ss->device, block, pRangingMeasurementData);
+    if (Status == VL53L0X_ERROR_NONE)
+        VL53L0X_Latest_record(ss->device, pRangingMeasurementData);
+
+    latency = elapsed_us(ss->start_us);
+    ss->latency.count++;
+    ss->latency.last_us = latency;
+    ss->latency.sum_us += latency;
+    if (latency < ss->latency.min_us)
+        ss->latency.min_us = latency;
+    if (latency > ss->latency.max_us)
+        ss->latency.max_us = latency;
+
+    return Status;
+}
+
+VL53L0X_Error VL53L0X_SingleShot_poll(VL53L0X_SingleShot_t *ss,
+                                      VL53L0X_RangingMeasurementData_t *pRangingMeasurementData,
+                                      uint8_t *pReady)
+{
+    VL53L0X_Error Status;
+    uint8_t block[VL53L0X_RESULT_BLOCK_SIZE];
+
+    *pReady = 0;
+
+    if (!ss->started)
+        return VL53L0X_ERROR_INVALID_COMMAND;
+
+    Status = VL53L0X_ReadMulti(ss->device, VL53L0X_RESULT_BLOCK_INDEX, block,
+                               VL53L0X_RESULT_BLOCK_SIZE);
+    if (Status == VL53L0X_ERROR_TIME_OUT)
+        return timed_out(ss);
+    if (Status != VL53L0X_ERROR_NONE)
+        return Status;
+
+    if (!VL53L0X_Ranging_isReady(ss->device, block))
+    {
+        if (elapsed_us(ss->start_us) >= ss->timeout_us)
+            return timed_out(ss);
+        return VL53L0X_ERROR_NONE;
+    }
+
+    *pReady = 1;
+    return collect(ss, block, pRangingMeasurementData);
+}
+
+uint32_t VL53L0X_SingleShot_remaining(const VL53L0X_SingleShot_t *ss)
+{
+    uint32_t elapsed;
+
+    if (!ss->started)
+        return 0;
+
+    elapsed = elapsed_us(ss->start_us);
+    return elapsed < ss->predicted_us ? ss->predicted_us - elapsed : 0;
+}
+
+static VL53L0X_Error single_shot(VL53L0X_SingleShot_t *ss,
+                                 VL53L0X_RangingMeasurementData_t *pRangingMeasurementData)
+{
+    VL53L0X_Error Status;
+    VL53L0X_Dev_t *device = ss->device;
+    uint8_t block[VL53L0X_RESULT_BLOCK_SIZE];
+    uint32_t elapsed;
+    uint32_t remaining_us;
+    uint32_t wait_us;
+
+    Status = VL53L0X_SingleShot_start(ss);
+    if (Status != VL53L0X_ERROR_NONE)
+        return Status;
+
+    elapsed = elapsed_us(ss->start_us);
+
+    if (ss->wait_ready != NULL)
+    {
+        if (VL53L0X_GetRemainingTime(device, &remaining_us) != VL53L0X_ERROR_NONE)
+            return timed_out(ss);
+
+        wait_us = elapsed < ss->timeout_us ? ss->timeout_us - elapsed : 0;
+        if (remaining_us < wait_us)
+            wait_us = remaining_us;
+
+        if (ss->wait_ready(ss->wait_ctx, wait_us) != 0)
+            return timed_out(ss);
+    }
+    else if (elapsed + 1000 <= ss->predicted_us)
+    {
+        // sleep through the integration, polling only covers the tail
+        if (VL53L0X_Sleep(device, ss->predicted_us - elapsed) != VL53L0X_ERROR_NONE)
+            return timed_out(ss);
+    }
+
+    while (1)
+    {
+        Status = VL53L0X_ReadMulti(device, VL53L0X_RESULT_BLOCK_INDEX, block,
+                                   VL53L0X_RESULT_BLOCK_SIZE);
+        if (Status == VL53L0X_ERROR_TIME_OUT)
+            return timed_out(ss);
+        if (Status != VL53L0X_ERROR_NONE)
+            return Status;
+
+        if (VL53L0X_Ranging_isReady(device, block))
+            break;
+
+        if (elapsed_us(ss->start_us) >= ss->timeout_us)
+            return timed_out(ss);
+
+        if (VL53L0X_Sleep(device, SINGLESHOT_POLL_US) != VL53L0X_ERROR_NONE)
+            return timed_out(ss);
+    }
+
+    return collect(ss, block, pRangingMeasurementData);
+}
+
+VL53L0X_Error VL53L0X_SingleShot_measure(VL53L0X_SingleShot_t *ss,
+                                         VL53L0X_RangingMeasurementData_t *pRangingMeasurementData)
+{
+    return single_shot(ss, pRangingMeasurementData);
+}
+
+VL53L0X_Error VL53L0X_SingleShot_measureUntil(VL53L0X_SingleShot_t *ss,
+                                              VL53L0X_RangingMeasurementData_t *pRangingMeasurementData,
+                                              int64_t deadline_us)
+{
+    VL53L0X_Error Status;
+    int64_t previous = VL53L0X_SetDeadline(ss->device, deadline_us);
+
+    Status = single_shot(ss, pRangingMeasurementData);
+
+    VL53L0X_SetDeadline(ss->device, previous);
+    return Status;
+}
@@ -0,0 +1,296 @@
+/*
+ * File : vl53l0x_refspad.c
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include "vl53l0x_refspad.h"
+#include "vl53l0x_api_calibration.h"
+
+// defined in vl53l0x_api_calibration.c, not exported by its header
+void get_next_good_spad(uint8_t goodSpadArray[], uint32_t size, uint32_t curr, int32_t *next);
+uint8_t is_aperture(uint32_t spadIndex);
+VL53L0X_Error enable_spad_bit(uint8_t spadArray[], uint32_t size, uint32_t spadIndex);
+VL53L0X_Error set_ref_spad_map(VL53L0X_DEV Dev, uint8_t *refSpadArray);
+VL53L0X_Error enable_ref_spads(VL53L0X_DEV Dev, uint8_t apertureSpads, uint8_t goodSpadArray[],
+                               uint8_t spadArray[], uint32_t size, uint32_t start, uint32_t offset,
+                               uint32_t spadCount, uint32_t *lastSpad);
+VL53L0X_Error perform_ref_signal_measurement(VL53L0X_DEV Dev, uint16_t *refSignalRate);
+
+// same window as VL53L0X_perform_ref_spad_management
+#define SPAD_ARRAY_SIZE     6
+#define START_SELECT        0xB4
+#define MIN_SPAD_COUNT      3
+#define MAX_SPAD_COUNT      44
+
+// minimum SPADs enabled plus the first count candidates
+static void build_map(const uint8_t *base, const uint32_t *candidates, uint32_t count, uint8_t *map)
+{
+    uint32_t i;
+
+    memcpy(map, base, SPAD_ARRAY_SIZE);
+    for (i = 0; i < count; i++)
+        enable_spad_bit(map, SPAD_ARRAY_SIZE, candidates[i]);
+}
+
+static VL53L0X_Error measure_map(VL53L0X_DEV Dev, uint8_t *map, uint16_t *peakSignalRateRef)
+{
+    VL53L0X_Error Status = set_ref_spad_map(Dev, map);
+
+    if (Status == VL53L0X_ERROR_NONE)
+        Status = perform_ref_signal_measurement(Dev, peakSignalRateRef);
+
+    return Status;
+}
+
+VL53L0X_Error VL53L0X_RefSpad_prepare(VL53L0X_DEV Dev)
+{
+    VL53L0X_Error Status;
+
+    memset(Dev->Data.SpadData.RefSpadEnables, 0, SPAD_ARRAY_SIZE);
+
+    // same setup as VL53L0X_perform_ref_spad_management
+    Status = VL53L0X_WrByte(Dev, 0xFF, 0x01);
+    if (Status == VL53L0X_ERROR_NONE)
+        Status = VL53L0X_WrByte(Dev, VL53L0X_REG_DYNAMIC_SPAD_REF_EN_START_OFFSET, 0x00);
+    if (Status == VL53L0X_ERROR_NONE)
+        Status = VL53L0X_WrByte(Dev, VL53L0X_REG_DYNAMIC_SPAD_NUM_REQUESTED_REF_SPAD, 0x2C);
+    if (Status == VL53L0X_ERROR_NONE)
+        Status = VL53L0X_WrByte(Dev, 0xFF, 0x00);
+    if (Status == VL53L0X_ERROR_NONE)
+        Status = VL53L0X_WrByte(Dev, VL53L0X_REG_GLOBAL_CONFIG_REF_EN_START_SELECT, START_SELECT);
+    if (Status == VL53L0X_ERROR_NONE)
+        Status = VL53L0X_WrByte(Dev, VL53L0X_REG_POWER_MANAGEMENT_GO1_POWER_FORCE, 0);
+
+    return Status;
+}
+
+VL53L0X_Error VL53L0X_RefSpad_enableMinimum(VL53L0X_DEV Dev, uint8_t needAptSpads,
+                                            uint32_t *pCurrentSpadIndex)
+{
+    uint8_t *spadEnables = Dev->Data.SpadData.RefSpadEnables;
+    uint32_t currentSpadIndex = *pCurrentSpadIndex;
+    uint32_t lastSpadIndex = currentSpadIndex;
+    VL53L0X_Error Status;
+
+    if (needAptSpads)
+    {
+        // too high with the minimum non aperture SPADs, switch to aperture SPADs
+        memset(spadEnables, 0, SPAD_ARRAY_SIZE);
+
+        while (is_aperture(START_SELECT + currentSpadIndex) == 0 &&
+               currentSpadIndex < MAX_SPAD_COUNT)
+            currentSpadIndex++;
+    }
+
+    Status = enable_ref_spads(Dev, needAptSpads, Dev->Data.SpadData.RefGoodSpadMap, spadEnables,
+                              SPAD_ARRAY_SIZE, START_SELECT, currentSpadIndex, MIN_SPAD_COUNT,
+                              &lastSpadIndex);
+    if (Status == VL53L0X_ERROR_NONE)
+        *pCurrentSpadIndex = lastSpadIndex;
+
+    return Status;
+}
+
+void VL53L0X_RefSpad_record(VL53L0X_DEV Dev, uint32_t refSpadCount, uint8_t isApertureSpads)
+{
+    VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, RefSpadsInitialised, 1);
+    VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, ReferenceSpadCount, (uint8_t)refSpadCount);
+    VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, ReferenceSpadType, isApertureSpads);
+}
+
+void VL53L0X_RefSpad_bracketBegin(VL53L0X_RefSpadBracket_t *bracket, VL53L0X_DEV Dev,
+                                  uint32_t currentSpadIndex, uint8_t needAptSpads,
+                                  uint16_t peakSignalRateRef, uint8_t gallop)
+{
+    uint8_t *goodSpadMap = Dev->Data.SpadData.RefGoodSpadMap;
+    int32_t nextGoodSpad = 0;
+
+    bracket->candidateCount = 0;
+    bracket->endOfMap = 0;
+
+    // good SPADs of the same type the linear search would add, in order
+    while (bracket->candidateCount < VL53L0X_REFSPAD_CANDIDATES)
+    {
+        get_next_good_spad(goodSpadMap, SPAD_ARRAY_SIZE, currentSpadIndex, &nextGoodSpad);
+        if (nextGoodSpad == -1)
+        {
+            bracket->endOfMap = 1;
+            break;
+        }
+        if (is_aperture((uint32_t)START_SELECT + nextGoodSpad) != needAptSpads)
+            break;
+
+        bracket->candidates[bracket->candidateCount++] = (uint32_t)nextGoodSpad;
+        currentSpadIndex = (uint32_t)nextGoodSpad + 1;
+    }
+
+    // smallest count above the target : rate(low) <= target < rate(high),
+    // high = candidateCount + 1 while no count above the target is known
+    memcpy(bracket->base, Dev->Data.SpadData.RefSpadEnables, SPAD_ARRAY_SIZE);
+    bracket->low = 0;
+    bracket->lowRate = peakSignalRateRef;
+    bracket->high = bracket->candidateCount + 1;
+    bracket->highRate = 0;
+    bracket->step = 1;
+    bracket->gallop = gallop;
+    bracket->written = 0;
+}
+
+uint8_t VL53L0X_RefSpad_bracketNext(VL53L0X_RefSpadBracket_t *bracket)
+{
+    if (bracket->high - bracket->low <= 1)
+        return 0;
+
+    // gallop from the minimum until the target is bracketed, then bisect
+    if (bracket->high > bracket->candidateCount)
+    {
+        bracket->mid = bracket->low + bracket->step;
+        if (bracket->mid > bracket->candidateCount)
+            bracket->mid = bracket->candidateCount;
+        if (bracket->gallop)
+            bracket->step *= 2;
+    }
+    else
+        bracket->mid = (bracket->low + bracket->high) / 2;
+
+    build_map(bracket->base, bracket->candidates, bracket->mid, bracket->map);
+
+    return 1;
+}
+
+void VL53L0X_RefSpad_bracketAccount(VL53L0X_RefSpadBracket_t *bracket, uint16_t peakSignalRateRef,
+                                    uint16_t targetRefRate)
+{
+    bracket->written = bracket->mid;
+
+    if (peakSignalRateRef > targetRefRate)
+    {
+        bracket->high = bracket->mid;
+        bracket->highRate = peakSignalRateRef;
+    }
+    else
+    {
+        bracket->low = bracket->mid;
+        bracket->lowRate = peakSignalRateRef;
+    }
+}
+
+VL53L0X_Error VL53L0X_RefSpad_bracketFinish(VL53L0X_RefSpadBracket_t *bracket, VL53L0X_DEV Dev,
+                                            uint16_t targetRefRate, uint32_t *pAdded)
+{
+    VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+    uint32_t chosen;
+
+    if (bracket->high > bracket->candidateCount)
+    {
+        // the linear search runs out of SPADs below the target
+        chosen = bracket->candidateCount;
+        if (bracket->endOfMap)
+            return VL53L0X_ERROR_REF_SPAD_INIT;
+    }
+    else
+    {
+        // closest to the target, either above or below it
+        chosen = (bracket->highRate - targetRefRate > abs(bracket->lowRate - targetRefRate)) ?
+                 bracket->low : bracket->high;
+    }
+
+    build_map(bracket->base, bracket->candidates, chosen, Dev->Data.SpadData.RefSpadEnables);
+    if (bracket->written != chosen)
+        Status = set_ref_spad_map(Dev, Dev->Data.SpadData.RefSpadEnables);
+
+    *pAdded = chosen;
+
+    return Status;
+}
+
+VL53L0X_Error VL53L0X_RefSpad_bisect(VL53L0X_DEV Dev, uint32_t *refSpadCount, uint8_t *isApertureSpads)
+{
+    VL53L0X_Error Status;
+    VL53L0X_RefSpadBracket_t bracket;
+    uint32_t currentSpadIndex = 0;
+    uint16_t targetRefRate;
+    uint16_t peakSignalRateRef = 0;
+    uint32_t added;
+    uint8_t needAptSpads = 0;
+    uint8_t VhvSettings = 0;
+    uint8_t PhaseCal = 0;
+    uint32_t refSpadCount_int = 0;
+    uint8_t isApertureSpads_int = 0;
+
+    targetRefRate = PALDevDataGet(Dev, targetRefRate);
+
+    // setup and minimum SPADs exactly as VL53L0X_perform_ref_spad_management
+    Status = VL53L0X_RefSpad_prepare(Dev);
+    if (Status == VL53L0X_ERROR_NONE)
+        Status = VL53L0X_perform_ref_calibration(Dev, &VhvSettings, &PhaseCal, 0);
+    if (Status == VL53L0X_ERROR_NONE)
+        Status = VL53L0X_RefSpad_enableMinimum(Dev, needAptSpads, &currentSpadIndex);
+
+    if (Status == VL53L0X_ERROR_NONE)
+    {
+        Status = perform_ref_signal_measurement(Dev, &peakSignalRateRef);
+        if (Status == VL53L0X_ERROR_NONE && peakSignalRateRef > targetRefRate)
+        {
+            needAptSpads = 1;
+
+            Status = VL53L0X_RefSpad_enableMinimum(Dev, needAptSpads, &currentSpadIndex);
+            if (Status == VL53L0X_ERROR_NONE)
+            {
+                Status = perform_ref_signal_measurement(Dev, &peakSignalRateRef);
+
+                if (Status == VL53L0X_ERROR_NONE && peakSignalRateRef > targetRefRate)
+                {
+                    // still too high, keep the minimum aperture SPADs
+                    isApertureSpads_int = 1;
+                    refSpadCount_int = MIN_SPAD_COUNT;
+                }
+            }
+        }
+    }
+
+    if (Status == VL53L0X_ERROR_NONE && peakSignalRateRef < targetRefRate)
+    {
+        isApertureSpads_int = needAptSpads;
+        refSpadCount_int = MIN_SPAD_COUNT;
+
+        VL53L0X_RefSpad_bracketBegin(&bracket, Dev, currentSpadIndex, needAptSpads,
+                                     peakSignalRateRef, 1);
+
+        while (VL53L0X_RefSpad_bracketNext(&bracket))
+        {
+            Status = measure_map(Dev, bracket.map, &peakSignalRateRef);
+            if (Status != VL53L0X_ERROR_NONE)
+                break;
+            VL53L0X_RefSpad_bracketAccount(&bracket, peakSignalRateRef, targetRefRate);
+        }
+
+        if (Status == VL53L0X_ERROR_NONE)
+            Status = VL53L0X_RefSpad_bracketFinish(&bracket, Dev, targetRefRate, &added);
+        if (Status == VL53L0X_ERROR_NONE)
+            refSpadCount_int += added;
+    }
+
+    if (Status == VL53L0X_ERROR_NONE)
+    {
+        *refSpadCount = refSpadCount_int;
+        *isApertureSpads = isApertureSpads_int;
+        VL53L0X_RefSpad_record(Dev, refSpadCount_int, isApertureSpads_int);
+    }
+
+    return Status;
+}
+
+VL53L0X_Error VL53L0X_RefSpad_perform(VL53L0X_DEV Dev, uint32_t *refSpadCount, uint8_t *isApertureSpads)
+{
+    if (Dev->RefSpadSearch == VL53L0X_REFSPAD_SEARCH_BISECT)
+        return VL53L0X_RefSpad_bisect(Dev, refSpadCount, isApertureSpads);
+
+    return VL53L0X_PerformRefSpadManagement(Dev, refSpadCount, isApertureSpads);
+}
@@ -0,0 +1,146 @@
+/*
+ * File : vl53l0x_scheduler.c
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#include "vl53l0x_scheduler.h"
+
+#include "esp_timer.h"
+
+static VL53L0X_Bus_t *op_bus(const VL53L0X_SchedOp_t *op)
+{
+    return op->device->Bus != NULL ? op->device->Bus : VL53L0X_Bus_default();
+}
+
+// no channel switch needed before the operation
+static uint8_t on_channel(const VL53L0X_SchedOp_t *op)
+{
+    VL53L0X_Bus_t *bus = op_bus(op);
+    uint8_t mux = op->device->MuxMask;
+
+    return mux == 0 || bus->mux_address == 0 || bus->mux_current == mux;
+}
+
+static uint8_t urgent(const VL53L0X_Scheduler_t *sched, const VL53L0X_SchedOp_t *op, int64_t now)
+{
+    return op->deadline_us != 0 && op->deadline_us - now <= (int64_t)sched->urgent_us;
+}
+
+// queue index of the operation to run next, *pForced if out of channel order
+static uint16_t pick(VL53L0X_Scheduler_t *sched, int64_t now, uint8_t *pForced)
+{
+    VL53L0X_SchedOp_t *op;
+    int32_t first_urgent = -1;
+    int32_t first_starved = -1;
+    int32_t first_on_channel = -1;
+    int32_t chosen;
+    uint16_t i;
+
+    for (i = 0; i < sched->count; i++)
+    {
+        op = sched->queue[i];
+
+        // earliest deadline among the urgent ones
+        if (urgent(sched, op, now) &&
+            (first_urgent < 0 || op->deadline_us < sched->queue[first_urgent]->deadline_us))
+            first_urgent = i;
+
+        if (first_starved < 0 && op->bypassed >= sched->max_bypass)
+            first_starved = i;
+
+        if (first_on_channel < 0 && on_channel(op))
+            first_on_channel = i;
+    }
+
+    if (first_urgent >= 0)
+        chosen = first_urgent;
+    else if (first_starved >= 0)
+        chosen = first_starved;
+    else if (first_on_channel >= 0)
+        chosen = first_on_channel;
+    else
+        chosen = 0;
+
+    *pForced = chosen != (first_on_channel >= 0 ? first_on_channel : 0);
+
+    return (uint16_t)chosen;
+}
+
+void VL53L0X_Scheduler_init(VL53L0X_Scheduler_t *sched, uint16_t max_bypass, uint32_t urgent_us)
+{
+    sched->count = 0;
+    sched->max_bypass = max_bypass;
+    sched->urgent_us = urgent_us;
+    VL53L0X_Scheduler_resetStats(sched);
+}
+
+VL53L0X_Error VL53L0X_Scheduler_submit(VL53L0X_Scheduler_t *sched, VL53L0X_SchedOp_t *op)
+{
+    if (sched->count >= VL53L0X_SCHEDULER_QUEUE)
+        return VL53L0X_ERROR_BUFFER_TOO_SMALL;
+
+    op->Status = VL53L0X_ERROR_NONE;
+    op->done = 0;
+    op->bypassed = 0;
+    sched->queue[sched->count++] = op;
+
+    return VL53L0X_ERROR_NONE;
+}
+
+uint16_t VL53L0X_Scheduler_dispatch(VL53L0X_Scheduler_t *sched)
+{
+    VL53L0X_SchedOp_t *op;
+    int64_t now;
+    uint16_t run = 0;
+    uint16_t next;
+    uint16_t i;
+    uint8_t forced;
+
+    while (sched->count > 0)
+    {
+        now = esp_timer_get_time();
+        next = pick(sched, now, &forced);
+        op = sched->queue[next];
+
+        // the older operations let this one go first
+        for (i = 0; i < next; i++)
+            sched->queue[i]->bypassed++;
+        for (i = next; i + 1 < sched->count; i++)
+            sched->queue[i] = sched->queue[i + 1];
+        sched->count--;
+
+        if (!on_channel(op))
+            sched->stats.switches++;
+        if (forced)
+            sched->stats.forced++;
+        if (op->deadline_us != 0 && now > op->deadline_us)
+            sched->stats.late++;
+
+        if (op->kind == VL53L0X_SCHED_READ_BLOCKS)
+            op->Status = VL53L0X_ReadBlocks(op->device, op->blocks, op->count);
+        else
+            op->Status = VL53L0X_WriteSequence(op->device, op->pairs, op->count);
+
+        op->done = 1;
+        sched->stats.ops++;
+        run++;
+    }
+
+    return run;
+}
+
+void VL53L0X_Scheduler_getStats(VL53L0X_Scheduler_t *sched, VL53L0X_SchedStats_t *pstats)
+{
+    *pstats = sched->stats;
+}
+
+void VL53L0X_Scheduler_resetStats(VL53L0X_Scheduler_t *sched)
+{
+    sched->stats.ops = 0;
+    sched->stats.switches = 0;
+    sched->stats.forced = 0;
+    sched->stats.late = 0;
+}
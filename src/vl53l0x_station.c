@@ -0,0 +1,338 @@
+/*
+ * File : vl53l0x_station.c
+ * Created: Monday, 19 October 2026
+ * Author: yunsik oh (oyster90@naver.com)
+ *
+ * Modified: Monday, 19 October 2026
+ *
+ */
+#include "vl53l0x_station.h"
+#include "vl53l0x.h"
+#include "vl53l0x_platform_esp32.h"
+
+#include "esp_log.h"
+
+#ifdef VL53L0X_LOG_ENABLE
+static const char* TAG = "vl53l0x_station";
+
+#define Station_ErrLog(fmt, ...) \
+    VL53L0X_DRIVER_LOG(ESP_LOG_ERROR, TAG, "%s " fmt, __func__, ##__VA_ARGS__)
+#define Station_Report(fmt, ...) \
+    VL53L0X_DRIVER_LOG(ESP_LOG_INFO, TAG, fmt, ##__VA_ARGS__)
+#else
+#define Station_ErrLog(fmt, ...) (void)0
+#define Station_Report(fmt, ...) (void)0
+#endif
+
+// result poll interval once a measurement is due
+#define STATION_POLL_US     500
+
+static uint32_t elapsed_us(int32_t start)
+{
+    int32_t now;
+    VL53L0X_get_timer_value(&now);
+    return (uint32_t)(now - start);
+}
+
+static VL53L0X_Error first_error(VL53L0X_StationUnit_t *units, uint16_t count)
+{
+    uint16_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        if (units[i].Status != VL53L0X_ERROR_NONE)
+            return units[i].Status;
+    }
+
+    return VL53L0X_ERROR_NONE;
+}
+
+static void unit_enable(VL53L0X_StationUnit_t *unit, uint8_t enable)
+{
+    if (unit->Enable == NULL || unit->Status != VL53L0X_ERROR_NONE)
+        return;
+
+    if (unit->Enable(unit->EnableCtx, enable) != 0)
+        unit->Status = VL53L0X_ERROR_CONTROL_INTERFACE;
+    else if (enable)
+        VL53L0X_Sleep(unit->device, VL53L0X_STATION_BOOT_US);
+}
+
+// release the units one at a time, each moved off the default address
+static void assign_addresses(VL53L0X_StationUnit_t *units, uint16_t count)
+{
+    VL53L0X_StationUnit_t *unit;
+    uint16_t i;
+
+    for (i = 0; i < count; i++)
+        unit_enable(&units[i], 0);
+
+    for (i = 0; i < count; i++)
+    {
+        unit = &units[i];
+        if (unit->Address == 0)
+            continue;
+
+        unit_enable(unit, 1);
+        if (unit->Status != VL53L0X_ERROR_NONE)
+            continue;
+
+        unit->device->I2cDevAddr = CONFIG_VL53L0X_I2C_ADDR;
+        VL53L0X_InvalidatePage(unit->device);
+        unit->Status = VL53L0X_SetDeviceAddress(unit->device, unit->Address * 2);
+        if (unit->Status == VL53L0X_ERROR_NONE)
+            unit->device->I2cDevAddr = unit->Address;
+        else
+            Station_ErrLog("unit %u address error (%d)", i, unit->Status);
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        if (units[i].Address == 0)
+            unit_enable(&units[i], 1);
+    }
+}
+
+VL53L0X_Error VL53L0X_Station_setup(VL53L0X_StationUnit_t *units, uint16_t count)
+{
+    VL53L0X_StationUnit_t *unit;
+    VL53L0X_PipelineUnit_t *setup;
+    VL53L0X_Dev_t *sleeper;
+    uint16_t active = count;
+    uint16_t i;
+    uint32_t wait_us;
+    uint8_t progressed;
+
+    for (i = 0; i < count; i++)
+        units[i].Status = VL53L0X_ERROR_NONE;
+
+    assign_addresses(units, count);
+
+    for (i = 0; i < count; i++)
+    {
+        VL53L0X_Pipeline_begin(&units[i].setup, units[i].device);
+        // a unit that could not be addressed is not set up
+        if (units[i].Status != VL53L0X_ERROR_NONE)
+        {
+            units[i].setup.Status = units[i].Status;
+            active--;
+        }
+    }
+
+    // while the reference measurements of a unit integrate the others are served
+    while (active > 0)
+    {
+        progressed = 0;
+        wait_us = UINT32_MAX;
+        sleeper = NULL;
+
+        for (i = 0; i < count; i++)
+        {
+            unit = &units[i];
+            setup = &unit->setup;
+            if (setup->Status != VL53L0X_ERROR_NONE || setup->Step == VL53L0X_SETUP_DONE)
+                continue;
+
+            progressed |= VL53L0X_Pipeline_step(setup, &wait_us);
+
+            if (setup->Status == VL53L0X_ERROR_NONE && setup->Step != VL53L0X_SETUP_DONE)
+            {
+                sleeper = unit->device;
+                continue;
+            }
+
+            unit->Status = setup->Status;
+            unit->RefSpadCount = setup->RefSpadCount;
+            unit->IsApertureSpads = setup->IsApertureSpads;
+            unit->VhvSettings = setup->VhvSettings;
+            unit->PhaseCal = setup->PhaseCal;
+            unit->ElapsedMicroSeconds = setup->ElapsedMicroSeconds;
+            active--;
+
+            if (unit->Status != VL53L0X_ERROR_NONE)
+                Station_ErrLog("unit %u setup error (%d)", i, unit->Status);
+            else
+                Station_Report("unit %u spads %u%s vhv %u phase %u", i, unit->RefSpadCount,
+                               unit->IsApertureSpads ? " aperture" : "", unit->VhvSettings,
+                               unit->PhaseCal);
+        }
+
+        if (!progressed && sleeper != NULL && wait_us != UINT32_MAX)
+            VL53L0X_Sleep(sleeper, wait_us);
+    }
+
+    return first_error(units, count);
+}
+
+static void unit_failed(VL53L0X_StationUnit_t *unit, VL53L0X_Error Status)
+{
+    unit->Status = Status;
+
+    if (unit->cal.tcc_enabled)
+        VL53L0X_SetSequenceStepEnable(unit->device, VL53L0X_SEQUENCESTEP_TCC, 1);
+}
+
+static void unit_done(VL53L0X_StationUnit_t *unit, uint16_t index)
+{
+    VL53L0X_Calibration_t *cal = &unit->cal;
+
+    (void)index; // only in the report
+
+    if (cal->kind == VL53L0X_CALIBRATION_OFFSET)
+    {
+        unit->Status = VL53L0X_Calibration_finish(cal, &unit->OffsetMicroMeter, NULL);
+        unit->Offset = cal->report;
+        Station_Report("unit %u offset %d um, %u/%u samples%s", index, unit->OffsetMicroMeter,
+                       cal->report.ValidSamples, cal->report.Measurements,
+                       cal->report.Converged ? "" : ", not converged");
+    }
+    else
+    {
+        unit->Status = VL53L0X_Calibration_finish(cal, NULL, &unit->XTalkCompensationRateMegaCps);
+        unit->XTalk = cal->report;
+        Station_Report("unit %u xtalk 0x%08x MCPS, %u/%u samples%s", index,
+                       unit->XTalkCompensationRateMegaCps, cal->report.ValidSamples,
+                       cal->report.Measurements, cal->report.Converged ? "" : ", not converged");
+    }
+
+    if (unit->Status != VL53L0X_ERROR_NONE)
+        Station_ErrLog("unit %u calibration error (%d)", index, unit->Status);
+}
+
+// advance one unit without blocking, returns 1 if a measurement was accounted
+static uint8_t unit_step(VL53L0X_StationUnit_t *unit, uint32_t *pWait_us)
+{
+    VL53L0X_Calibration_t *cal = &unit->cal;
+    VL53L0X_RangingMeasurementData_t data;
+    VL53L0X_Error Status;
+    uint32_t remaining;
+    uint8_t ready;
+
+    if (!cal->shot.started)
+    {
+        Status = VL53L0X_SingleShot_start(&cal->shot);
+        if (Status != VL53L0X_ERROR_NONE)
+        {
+            unit_failed(unit, Status);
+            return 0;
+        }
+    }
+
+    // no bus traffic before the measurement is due
+    remaining = VL53L0X_SingleShot_remaining(&cal->shot);
+    if (remaining > 0)
+    {
+        if (remaining < *pWait_us)
+            *pWait_us = remaining;
+        return 0;
+    }
+
+    Status = VL53L0X_SingleShot_poll(&cal->shot, &data, &ready);
+
+    if (Status == VL53L0X_ERROR_NONE && !ready)
+    {
+        *pWait_us = STATION_POLL_US;
+        return 0;
+    }
+
+    if (Status == VL53L0X_ERROR_NONE)
+        VL53L0X_Calibration_addSample(cal, &data);
+    else if (Status == VL53L0X_ERROR_RANGE_ERROR)
+        VL53L0X_Calibration_addSample(cal, NULL);
+    else
+    {
+        unit_failed(unit, Status);
+        return 0;
+    }
+
+    // next measurement integrates while the other units are served
+    if (!cal->done)
+    {
+        Status = VL53L0X_SingleShot_start(&cal->shot);
+        if (Status != VL53L0X_ERROR_NONE)
+            unit_failed(unit, Status);
+    }
+
+    return 1;
+}
+
+static VL53L0X_Error run(VL53L0X_StationUnit_t *units, uint16_t count,
+                         VL53L0X_CalibrationKind_t kind, FixPoint1616_t distance,
+                         const VL53L0X_CalibrationConfig_t *config)
+{
+    VL53L0X_StationUnit_t *unit;
+    VL53L0X_Dev_t *sleeper;
+    int32_t start;
+    uint16_t active = 0;
+    uint16_t i;
+    uint32_t wait_us;
+    uint8_t progressed;
+
+    VL53L0X_get_timer_value(&start);
+
+    for (i = 0; i < count; i++)
+    {
+        unit = &units[i];
+        if (unit->Status != VL53L0X_ERROR_NONE)
+            continue;
+
+        unit->Status = VL53L0X_Calibration_begin(&unit->cal, unit->device, kind, distance, config);
+        if (unit->Status != VL53L0X_ERROR_NONE)
+        {
+            unit_failed(unit, unit->Status);
+            Station_ErrLog("unit %u begin error (%d)", i, unit->Status);
+            continue;
+        }
+
+        active++;
+    }
+
+    while (active > 0)
+    {
+        progressed = 0;
+        wait_us = UINT32_MAX;
+        sleeper = NULL;
+
+        for (i = 0; i < count; i++)
+        {
+            unit = &units[i];
+            if (unit->Status != VL53L0X_ERROR_NONE || unit->cal.done)
+                continue;
+
+            progressed |= unit_step(unit, &wait_us);
+
+            if (unit->Status != VL53L0X_ERROR_NONE)
+                Station_ErrLog("unit %u measurement error (%d)", i, unit->Status);
+            else if (unit->cal.done)
+                unit_done(unit, i);
+            else
+            {
+                sleeper = unit->device;
+                continue;
+            }
+
+            unit->ElapsedMicroSeconds += elapsed_us(start);
+            active--;
+        }
+
+        // every unit integrating: sleep until the first one is due
+        if (!progressed && sleeper != NULL && wait_us != UINT32_MAX)
+            VL53L0X_Sleep(sleeper, wait_us);
+    }
+
+    return first_error(units, count);
+}
+
+VL53L0X_Error VL53L0X_Station_offset(VL53L0X_StationUnit_t *units, uint16_t count,
+                                     FixPoint1616_t distance,
+                                     const VL53L0X_CalibrationConfig_t *config)
+{
+    return run(units, count, VL53L0X_CALIBRATION_OFFSET, distance, config);
+}
+
+VL53L0X_Error VL53L0X_Station_xtalk(VL53L0X_StationUnit_t *units, uint16_t count,
+                                    FixPoint1616_t distance,
+                                    const VL53L0X_CalibrationConfig_t *config)
+{
+    return run(units, count, VL53L0X_CALIBRATION_XTALK, distance, config);
+}
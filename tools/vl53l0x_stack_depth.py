@@ -0,0 +1,132 @@
+#!/usr/bin/env python3
+#
+# File : vl53l0x_stack_depth.py
+# Created: Monday, 19 October 2026
+# Author: yunsik oh (oyster90@naver.com)
+#
+# Modified: Monday, 19 October 2026
+#
+# Worst case stack depth of the VL53L0X entry points, from the GCC call
+# graphs (.ci files) of a build with CONFIG_VL53L0X_STACK_USAGE.
+#
+#   vl53l0x_stack_depth.py build/esp-idf/vl53l0x --indirect 'esp32_.*'
+#
+# Functions of other components (esp_log, i2c driver, FreeRTOS) have no
+# call graph here: the paths reaching them are marked '+' and their depth
+# is a lower bound. Indirect calls resolve to the deepest function whose
+# name, static or not, matches --indirect, or are marked '+' as well.
+#
+
+import argparse
+import os
+import re
+import sys
+
+NODE = re.compile(r'node: \{ title: "([^"]+)" label: "[^\\"]*\\n([^\\"]*)\\n(\d+) bytes \(([^)]*)\)')
+EDGE = re.compile(r'edge: \{ sourcename: "([^"]+)" targetname: "([^"]+)"')
+INDIRECT = '__indirect_call'
+
+
+class Graph:
+    """Functions of all the call graphs, static ones kept per file."""
+
+    def __init__(self):
+        self.frames = {}        # (file, name) : (bytes, kind)
+        self.calls = {}         # (file, name) : [callee title]
+        self.globals = {}       # name : [(file, name)]
+
+    def load(self, path):
+        with open(path) as f:
+            text = f.read()
+        for name, where, size, kind in NODE.findall(text):
+            key = (path, name)
+            self.frames[key] = (int(size), kind)
+            self.calls.setdefault(key, [])
+            self.globals.setdefault(name, []).append(key)
+        for source, target in EDGE.findall(text):
+            self.calls.setdefault((path, source), []).append(target)
+
+    def resolve(self, caller, target):
+        local = (caller[0], target)
+        if local in self.frames:
+            return [local]
+        return self.globals.get(target, [])
+
+
+def bare(name):
+    """Function name of a node title, without the 'file.c:' of static ones."""
+    return name.rsplit(':', 1)[-1]
+
+
+def depth(graph, key, indirect, memo, stack):
+    """(bytes, complete, path) of the deepest call chain from key."""
+    if key in memo:
+        return memo[key]
+    if key in stack:
+        return (0, False, ['<recursion ' + key[1] + '>'])
+
+    size, kind = graph.frames[key]
+    best = (0, True, [])
+    complete = kind == 'static'
+
+    stack.add(key)
+    for target in graph.calls.get(key, []):
+        if target == INDIRECT:
+            callees = indirect
+            if not callees:
+                complete = False
+                continue
+        else:
+            callees = graph.resolve(key, target)
+            if not callees:
+                complete = False
+                continue
+        for callee in callees:
+            below = depth(graph, callee, indirect, memo, stack)
+            if below[0] > best[0] or (below[0] == best[0] and not below[1]):
+                best = below
+            complete = complete and below[1]
+    stack.discard(key)
+
+    memo[key] = (size + best[0], complete, [key[1]] + best[2])
+    return memo[key]
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description='worst case stack depth from GCC call graphs')
+    parser.add_argument('build', help='directory searched for .ci files')
+    parser.add_argument('--entry', default=r'^VL53L0X_', help='entry points, regex (default: %(default)s)')
+    parser.add_argument('--indirect', help='functions an indirect call may reach, regex')
+    parser.add_argument('--path', action='store_true', help='print the deepest chain of each entry point')
+    args = parser.parse_args(argv[1:])
+
+    graph = Graph()
+    for root, dirs, files in os.walk(args.build):
+        for name in files:
+            if name.endswith('.ci'):
+                graph.load(os.path.join(root, name))
+    if not graph.frames:
+        sys.stderr.write('%s: no .ci file, build with CONFIG_VL53L0X_STACK_USAGE\n' % args.build)
+        return 1
+
+    indirect = []
+    if args.indirect:
+        pattern = re.compile(args.indirect)
+        indirect = [key for key in graph.frames if pattern.match(bare(key[1]))]
+
+    entry = re.compile(args.entry)
+    memo = {}
+    rows = []
+    for key in graph.frames:
+        if entry.search(key[1]):
+            rows.append((depth(graph, key, indirect, memo, set()), key[1]))
+
+    for (size, complete, path), name in sorted(rows, key=lambda r: (-r[0][0], r[1])):
+        sys.stdout.write('%6u%s %s\n' % (size, ' ' if complete else '+', name))
+        if args.path:
+            sys.stdout.write('        %s\n' % ' > '.join(os.path.basename(p) for p in path))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
@@ -0,0 +1,158 @@
+#!/usr/bin/env python3
+#
+# File : vl53l0x_trace_decode.py
+# Created: Monday, 19 October 2026
+# Author: yunsik oh (oyster90@naver.com)
+#
+# Modified: Monday, 19 October 2026
+#
+# Format a VL53L0X_trace_dump on the host. The formats and the %s arguments
+# are read from the firmware ELF the dump was taken with.
+#
+#   vl53l0x_trace_decode.py build/app.elf trace.bin
+#
+
+import re
+import struct
+import sys
+
+SHF_ALLOC = 0x2
+SHT_NOBITS = 8
+
+# same conversions as the recorder, see conversion() in vl53l0x_platform_log.c
+CONVERSION = re.compile(r'%(?:(%)|([-+ #0-9.]*)([hlLjzt]*)([a-zA-Z]?))')
+
+
+class Image:
+    """Allocated sections of an ELF file, by address."""
+
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            self.data = f.read()
+        if self.data[:4] != b'\x7fELF':
+            raise ValueError('%s: not an ELF file' % path)
+
+        wide = self.data[4] == 2
+        order = '<' if self.data[5] == 1 else '>'
+        if wide:
+            shoff, = struct.unpack_from(order + 'Q', self.data, 0x28)
+            shentsize, shnum = struct.unpack_from(order + 'HH', self.data, 0x3A)
+            section = order + 'IIQQQQIIQQ'
+        else:
+            shoff, = struct.unpack_from(order + 'I', self.data, 0x20)
+            shentsize, shnum = struct.unpack_from(order + 'HH', self.data, 0x2E)
+            section = order + 'IIIIIIIIII'
+
+        self.sections = []
+        for i in range(shnum):
+            fields = struct.unpack_from(section, self.data, shoff + i * shentsize)
+            sh_type, flags, addr, offset, size = fields[1], fields[2], fields[3], fields[4], fields[5]
+            if flags & SHF_ALLOC and sh_type != SHT_NOBITS and addr != 0:
+                self.sections.append((addr, offset, size))
+
+    def string(self, address):
+        for addr, offset, size in self.sections:
+            if addr <= address < addr + size:
+                start = offset + address - addr
+                end = self.data.index(b'\0', start)
+                return self.data[start:end].decode('utf-8', 'replace')
+        return '<0x%x>' % address
+
+
+def words_of(kind, header):
+    if kind == 'word':
+        return 1
+    if kind == 'pointer':
+        return header['pointer_size'] // 4
+    return 2
+
+
+def kind_of(length, conv, header):
+    if conv in 'aAeEfFgG':
+        return 'double'
+    if conv in 'sp':
+        return 'pointer'
+    longs = sum(1 for c in length if c in 'lzt')
+    if 'L' in length or 'j' in length:
+        longs = 2
+    if longs >= 2 or (longs == 1 and header['long_size'] > 4):
+        return 'wide'
+    return 'word'
+
+
+def signed(value, bits):
+    return value - (1 << bits) if value & (1 << (bits - 1)) else value
+
+
+def format_record(image, header, fmt, words):
+    n = 0
+    out = []
+    last = 0
+
+    for m in CONVERSION.finditer(fmt):
+        out.append(fmt[last:m.start()])
+        last = m.end()
+        percent, flags, length, conv = m.groups()
+
+        if percent:
+            out.append('%')
+            continue
+        if not conv:
+            continue
+
+        kind = kind_of(length, conv, header)
+        count = words_of(kind, header)
+        if n + count > header['words']:
+            out.append('?')
+            continue
+
+        value = words[n] if count == 1 else words[n] | (words[n + 1] << 32)
+        n += count
+        spec = '%' + flags + conv
+
+        if kind == 'double':
+            out.append(spec % struct.unpack('<d', struct.pack('<Q', value))[0])
+        elif conv == 's':
+            out.append(spec % image.string(value))
+        elif conv == 'p':
+            out.append('0x%x' % value)
+        elif conv in 'di':
+            out.append(spec % signed(value, 32 * count))
+        elif conv == 'c':
+            out.append(chr(value & 0xFF))
+        else:
+            out.append(spec % value)
+
+    out.append(fmt[last:])
+    return ''.join(out)
+
+
+def decode(image, dump, write):
+    magic, version, pointer_size, words, long_size = struct.unpack_from('<4sBBBB', dump, 0)
+    if magic != b'VLTR' or version != 1:
+        raise ValueError('not a VL53L0X trace dump')
+    header = {'pointer_size': pointer_size, 'words': words, 'long_size': long_size}
+
+    record = struct.Struct('<I' + ('I' if pointer_size == 4 else 'Q') + 'I' * words)
+    for offset in range(8, len(dump) - record.size + 1, record.size):
+        fields = record.unpack_from(dump, offset)
+        timestamp, address, args = fields[0], fields[1], fields[2:]
+        if address == 0:
+            write('%u trace records lost\n' % args[0])
+        else:
+            write('%u: %s' % (timestamp, format_record(image, header, image.string(address), args)))
+
+
+def main(argv):
+    if len(argv) != 3:
+        sys.stderr.write('usage: %s firmware.elf trace.bin\n' % argv[0])
+        return 2
+
+    image = Image(argv[1])
+    with open(argv[2], 'rb') as f:
+        decode(image, f.read(), sys.stdout.write)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))